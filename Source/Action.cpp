@@ -41,10 +41,6 @@ Action::Action() {
     pos_close.set(0,0);
     asize.set(44,44);
     
-    // time
-    timeout = -1;
-    reminder = -1;
-    
     // textures
     textureActionInfo = gl::Texture(1,1);
     textureActionRelated = gl::Texture(1,1);
@@ -56,7 +52,7 @@ Action::Action() {
     action_close = false;
     
     // hide
-    this->hide();
+    this->deactivate();
 }
 
 
@@ -66,7 +62,7 @@ Action::Action() {
 /*
  * Configuration.
  */
-void Action::config(Configuration c) {
+void Action::config(const Configuration &c) {
     
     // resolution
     Config confDisplayResolution = c.getConfiguration(cDisplayResolution);
@@ -90,22 +86,6 @@ void Action::config(Configuration c) {
  */
 void Action::update() {
     
-    // timeout (avoids flickering)
-    if (timeout > 0) {
-        timeout--;
-    }
-    else if (timeout == 0) {
-        this->activate();
-    }
-    
-    // reminder
-    if (reminder > 0) {
-        reminder--;
-    }
-    else if (reminder == 0) {
-        this->deactivate();
-    }
-    
     // position
     if (active) {
         
@@ -114,7 +94,7 @@ void Action::update() {
         if (n) {
     
             // position
-            pos = (n->pos);
+            pos = (n->body->pos);
         }
         
     }
@@ -214,17 +194,15 @@ void Action::show() {
     // state
     active = false;
     
-    // props
-    timeout = actionTimeout;
-    reminder = -1;
+    // timeout (avoids flickering)
+    timer = Timeline::delay(actionTimeout, boost::bind(&Action::activate, this));
     
 }
 void Action::hide() {
     GLog();
     
     // reminder
-    timeout = -1;
-    reminder = actionReminder;
+    timer = Timeline::delay(actionReminder, boost::bind(&Action::deactivate, this));
 
 }
 void Action::activate() {
@@ -235,8 +213,7 @@ void Action::activate() {
     
     
     // reset
-    timeout = -1;
-    reminder = -1;
+    timer.cancel();
     
     // current
     act = actionNone;
@@ -252,8 +229,7 @@ void Action::deactivate() {
     pos.set(-10000,-10000);
     
     // reset
-    timeout = -1;
-    reminder = -1;
+    timer.cancel();
     
     // no no node
     node = NodePtr();
@@ -271,15 +247,15 @@ void Action::deactivate() {
 /**
  * Assign node.
  */
-void Action::assignNode(NodePtr n) {
+void Action::assignNode(const NodePtr &n) {
     
     // ref
     node = n;
     
     // position (shift -90°)
-    pos_info.set(n->radius * cos(-2.617993878), n->radius * sin(-2.617993878)); // -150°
-    pos_related.set(n->radius * cos(-1.570796327), n->radius * sin(-1.570796327)); // -> -90°
-    pos_close.set(n->radius * cos(-0.523598776), n->radius * sin(-0.523598776)); //  -30°
+    pos_info.set(n->body->radius * cos(-2.617993878), n->body->radius * sin(-2.617993878)); // -150°
+    pos_related.set(n->body->radius * cos(-1.570796327), n->body->radius * sin(-1.570796327)); // -> -90°
+    pos_close.set(n->body->radius * cos(-0.523598776), n->body->radius * sin(-0.523598776)); //  -30°
     
     pos_info -= asize/2.0;
     pos_related -= asize/2.0;
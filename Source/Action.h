@@ -35,8 +35,8 @@ using namespace ci;
 
 
 // constants
-const int actionTimeout = 12;
-const int actionReminder = 90;
+const double actionTimeout = 0.2; // s
+const double actionReminder = 1.5; // s
 
 // constants
 const string actionNone = "action_none";
@@ -58,7 +58,7 @@ class Action {
     Action();
     
     // Cinder
-    void config(Configuration c);
+    void config(const Configuration &c);
     
     // Sketch
     void update();
@@ -71,7 +71,7 @@ class Action {
     void deactivate();
     bool isActive();
     bool action(Vec2d tpos);
-    void assignNode(NodePtr n);
+    void assignNode(const NodePtr &n);
     void renderAction();
     
     // node
@@ -86,9 +86,8 @@ class Action {
     
     // states
     bool active;
-    int timeout;
+    TimelineHandle timer;
     int counter;
-    int reminder;
     
     // config
     float dpr;
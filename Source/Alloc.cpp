@@ -0,0 +1,146 @@
+//
+//  Alloc.cpp
+//  Solyaris
+//
+//  Created by CNPP on 19.10.2026.
+//  Copyright 2026 Beat Raess. All rights reserved.
+//
+//  This file is part of Solyaris.
+//
+//  Solyaris is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  Solyaris is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with Solyaris.  If not, see www.gnu.org/licenses/.
+
+
+#include "Alloc.h"
+#include <new>
+#include <cstdlib>
+#include <algorithm>
+
+
+#pragma mark -
+#pragma mark Counter
+
+#ifdef ALLOC_COUNT
+
+// exception specifications (dynamic ones are gone from C++17)
+#if __cplusplus >= 201103L
+#define ALLOC_THROW noexcept(false)
+#define ALLOC_NOTHROW noexcept
+#else
+#define ALLOC_THROW throw(std::bad_alloc)
+#define ALLOC_NOTHROW throw()
+#endif
+
+// counter
+static long allocations = 0;
+
+/**
+ * Counting operators, the nothrow and aligned forms included so no
+ * allocation escapes the count.
+ */
+void* operator new(std::size_t size) ALLOC_THROW {
+    __sync_fetch_and_add(&allocations, 1);
+    void *p = malloc(size > 0 ? size : 1);
+    if (! p) {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+void* operator new[](std::size_t size) ALLOC_THROW {
+    return operator new(size);
+}
+void* operator new(std::size_t size, const std::nothrow_t&) ALLOC_NOTHROW {
+    __sync_fetch_and_add(&allocations, 1);
+    return malloc(size > 0 ? size : 1);
+}
+void* operator new[](std::size_t size, const std::nothrow_t &nt) ALLOC_NOTHROW {
+    return operator new(size, nt);
+}
+void operator delete(void *p) ALLOC_NOTHROW {
+    free(p);
+}
+void operator delete[](void *p) ALLOC_NOTHROW {
+    free(p);
+}
+void operator delete(void *p, const std::nothrow_t&) ALLOC_NOTHROW {
+    free(p);
+}
+void operator delete[](void *p, const std::nothrow_t&) ALLOC_NOTHROW {
+    free(p);
+}
+#if __cpp_sized_deallocation
+void operator delete(void *p, std::size_t) ALLOC_NOTHROW {
+    free(p);
+}
+void operator delete[](void *p, std::size_t) ALLOC_NOTHROW {
+    free(p);
+}
+#endif
+#if __cpp_aligned_new
+void* operator new(std::size_t size, std::align_val_t al) ALLOC_THROW {
+    __sync_fetch_and_add(&allocations, 1);
+    void *p = 0;
+    std::size_t a = std::max((std::size_t)al, sizeof(void*));
+    if (posix_memalign(&p, a, size > 0 ? size : 1) != 0) {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+void* operator new[](std::size_t size, std::align_val_t al) ALLOC_THROW {
+    return operator new(size, al);
+}
+void* operator new(std::size_t size, std::align_val_t al, const std::nothrow_t&) ALLOC_NOTHROW {
+    __sync_fetch_and_add(&allocations, 1);
+    void *p = 0;
+    std::size_t a = std::max((std::size_t)al, sizeof(void*));
+    return posix_memalign(&p, a, size > 0 ? size : 1) == 0 ? p : 0;
+}
+void* operator new[](std::size_t size, std::align_val_t al, const std::nothrow_t &nt) ALLOC_NOTHROW {
+    return operator new(size, al, nt);
+}
+void operator delete(void *p, std::align_val_t) ALLOC_NOTHROW {
+    free(p);
+}
+void operator delete[](void *p, std::align_val_t) ALLOC_NOTHROW {
+    free(p);
+}
+void operator delete(void *p, std::size_t, std::align_val_t) ALLOC_NOTHROW {
+    free(p);
+}
+void operator delete[](void *p, std::size_t, std::align_val_t) ALLOC_NOTHROW {
+    free(p);
+}
+void operator delete(void *p, std::align_val_t, const std::nothrow_t&) ALLOC_NOTHROW {
+    free(p);
+}
+void operator delete[](void *p, std::align_val_t, const std::nothrow_t&) ALLOC_NOTHROW {
+    free(p);
+}
+#endif
+
+#endif
+
+
+#pragma mark -
+#pragma mark Business
+
+/**
+ * Allocations so far.
+ */
+long Alloc::count() {
+#ifdef ALLOC_COUNT
+    return allocations;
+#else
+    return 0;
+#endif
+}
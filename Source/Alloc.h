@@ -0,0 +1,41 @@
+//
+//  Alloc.h
+//  Solyaris
+//
+//  Created by CNPP on 19.10.2026.
+//  Copyright 2026 Beat Raess. All rights reserved.
+//
+//  This file is part of Solyaris.
+//
+//  Solyaris is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  Solyaris is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with Solyaris.  If not, see www.gnu.org/licenses/.
+
+
+#pragma once
+
+
+/**
+ * Allocation Counter.
+ * Builds with ALLOC_COUNT count the heap allocations made through new, so
+ * frames and ingests can report how much they allocate. Without the flag
+ * the count stays zero.
+ */
+class Alloc {
+    
+    // public
+    public:
+    
+    // Business
+    static long count();
+    
+};
@@ -0,0 +1,86 @@
+//
+//  Arena.cpp
+//  Solyaris
+//
+//  Created by CNPP on 19.10.2026.
+//  Copyright 2026 Beat Raess. All rights reserved.
+//
+//  This file is part of Solyaris.
+//
+//  Solyaris is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  Solyaris is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with Solyaris.  If not, see www.gnu.org/licenses/.
+
+
+#include "Arena.h"
+#include <cstdlib>
+#include <algorithm>
+
+
+// blocks
+vector< pair<char*,size_t> > Arena::blocks;
+size_t Arena::current = 0;
+size_t Arena::offset = 0;
+size_t Arena::total = 0;
+
+
+#pragma mark -
+#pragma mark Business
+
+/**
+ * Bumps n bytes, moving on to the next block when the current one is full.
+ */
+void* Arena::allocate(size_t n) {
+    
+    // align
+    n = (n + arenaAlign - 1) & ~(arenaAlign - 1);
+    
+    // next block
+    while (current < blocks.size() && offset + n > blocks[current].second) {
+        current++;
+        offset = 0;
+    }
+    
+    // new block
+    if (current >= blocks.size()) {
+        size_t size = max(n, arenaBlock);
+        char *block = static_cast<char*>(malloc(size));
+        if (! block) {
+            throw bad_alloc();
+        }
+        blocks.push_back(make_pair(block, size));
+        current = blocks.size() - 1;
+        offset = 0;
+    }
+    
+    // bump
+    void *p = blocks[current].first + offset;
+    offset += n;
+    total += n;
+    return p;
+}
+
+/**
+ * Rewinds the arena, the blocks are kept for the next frame.
+ */
+void Arena::reset() {
+    current = 0;
+    offset = 0;
+    total = 0;
+}
+
+/**
+ * Bytes handed out since the last reset.
+ */
+size_t Arena::used() {
+    return total;
+}
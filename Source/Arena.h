@@ -0,0 +1,115 @@
+//
+//  Arena.h
+//  Solyaris
+//
+//  Created by CNPP on 19.10.2026.
+//  Copyright 2026 Beat Raess. All rights reserved.
+//
+//  This file is part of Solyaris.
+//
+//  Solyaris is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  Solyaris is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with Solyaris.  If not, see www.gnu.org/licenses/.
+
+
+#pragma once
+#include <cstddef>
+#include <new>
+#include <string>
+#include <vector>
+
+
+// namespace
+using namespace std;
+
+
+// constants
+const size_t arenaBlock = 64 * 1024;
+const size_t arenaAlign = 16;
+
+
+/**
+ * Frame Arena.
+ * Bump allocator for transient scratch data. Memory is only given back by
+ * reset(), which Graph::update calls at the start of every frame, so arena
+ * backed containers must not outlive the call that created them.
+ */
+class Arena {
+    
+    // public
+    public:
+    
+    // Business
+    static void* allocate(size_t n);
+    static void reset();
+    static size_t used();
+    
+    
+    // private
+    private:
+    
+    // Blocks
+    static vector< pair<char*,size_t> > blocks;
+    static size_t current;
+    static size_t offset;
+    static size_t total;
+    
+};
+
+
+/**
+ * Arena Allocator.
+ * STL allocator on the frame arena, deallocation is a no-op.
+ */
+template <typename T>
+class ArenaAllocator {
+    
+    // public
+    public:
+    
+    // types
+    typedef T value_type;
+    typedef T* pointer;
+    typedef const T* const_pointer;
+    typedef T& reference;
+    typedef const T& const_reference;
+    typedef size_t size_type;
+    typedef ptrdiff_t difference_type;
+    template <typename U> struct rebind {
+        typedef ArenaAllocator<U> other;
+    };
+    
+    // ArenaAllocator
+    ArenaAllocator() {}
+    template <typename U> ArenaAllocator(const ArenaAllocator<U> &) {}
+    
+    // Allocator
+    pointer address(reference x) const { return &x; }
+    const_pointer address(const_reference x) const { return &x; }
+    pointer allocate(size_type n, const void* = 0) { return static_cast<pointer>(Arena::allocate(n * sizeof(T))); }
+    void deallocate(pointer, size_type) {}
+    size_type max_size() const { return size_t(-1) / sizeof(T); }
+    void construct(pointer p, const T &v) { new((void*)p) T(v); }
+    void destroy(pointer p) { p->~T(); }
+    
+};
+template <typename T, typename U>
+inline bool operator==(const ArenaAllocator<T> &, const ArenaAllocator<U> &) { return true; }
+template <typename T, typename U>
+inline bool operator!=(const ArenaAllocator<T> &, const ArenaAllocator<U> &) { return false; }
+
+
+// typedef
+typedef basic_string<char, char_traits<char>, ArenaAllocator<char> > ArenaString;
+typedef vector<ArenaString, ArenaAllocator<ArenaString> > ArenaStrings;
+typedef vector<float, ArenaAllocator<float> > ArenaFloats;
+typedef vector<int, ArenaAllocator<int> > ArenaInts;
@@ -0,0 +1,827 @@
+//
+//  Cache.cpp
+//  Solyaris
+//
+//  Created by CNPP on 19.10.2026.
+//  Copyright 2026 Beat Raess. All rights reserved.
+//
+//  This file is part of Solyaris.
+//
+//  Solyaris is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  Solyaris is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with Solyaris.  If not, see www.gnu.org/licenses/.
+
+#include "Cache.h"
+#include <zlib.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <dirent.h>
+#include <cstring>
+#include <cstdio>
+#include <ctime>
+
+
+// slot states
+const uint32_t slotEmpty = 0;
+const uint32_t slotLive = 1;
+const uint32_t slotDead = 2;
+
+
+#pragma mark -
+#pragma mark Object
+
+/**
+ * Creates a cache in the directory.
+ */
+Cache::Cache(const string &d) {
+
+    // files
+    dir = d;
+    ifd = -1;
+    pfd = -1;
+    pend = 0;
+    header = NULL;
+    slots = NULL;
+    mapped = 0;
+
+    // worker
+    scheduled = false;
+    busy = false;
+    running = false;
+
+    // endpoints
+    ttls["search"] = 24 * 3600;
+    ttls["popular"] = 6 * 3600;
+    ttls["now_playing"] = 6 * 3600;
+    ttls["movie"] = 7 * 24 * 3600;
+    ttls["person"] = 7 * 24 * 3600;
+}
+
+/**
+ * Closes the cache.
+ */
+Cache::~Cache() {
+    this->close();
+}
+
+
+#pragma mark -
+#pragma mark Business
+
+/**
+ * Opens the index and the pack, recovers entries the index missed and
+ * starts the worker.
+ */
+bool Cache::open() {
+    boost::mutex::scoped_lock lock(mutex);
+
+    // open
+    if (running) {
+        return true;
+    }
+    mkdir(dir.c_str(), 0755);
+    ifd = ::open((dir + "/responses.idx").c_str(), O_RDWR | O_CREAT, 0644);
+    if (ifd < 0) {
+        return false;
+    }
+
+    // index
+    struct stat st;
+    bool valid = false;
+    if (fstat(ifd, &st) == 0 && st.st_size >= (off_t)sizeof(CacheHeader)) {
+        CacheHeader h;
+        valid = pread(ifd, &h, sizeof(h), 0) == (ssize_t)sizeof(h)
+                && h.magic == cacheMagic && h.version == cacheVersion && h.capacity > 0
+                && st.st_size == (off_t)(sizeof(CacheHeader) + h.capacity * sizeof(CacheSlot));
+        if (valid) {
+            valid = this->map(h.capacity, false);
+        }
+    }
+    if (! valid) {
+        if (! this->map(cacheCapacity, true)) {
+            ::close(ifd);
+            ifd = -1;
+            return false;
+        }
+        header->generation = this->latest();
+    }
+
+    // pack
+    pfd = ::open(this->pack(header->generation).c_str(), O_RDWR | O_CREAT, 0644);
+    if (pfd < 0 || fstat(pfd, &st) != 0) {
+        this->unmap();
+        ::close(ifd);
+        ifd = -1;
+        return false;
+    }
+    pend = st.st_size;
+
+    // recover
+    if (! valid || pend < header->end) {
+        this->wipe();
+        this->recover(0);
+    }
+    else if (pend > header->end) {
+        this->recover(header->end);
+    }
+
+    // worker
+    running = true;
+    thread = boost::thread(boost::bind(&Cache::worker, this));
+    return true;
+}
+
+/**
+ * Stops the worker and syncs the index.
+ */
+void Cache::close() {
+
+    // stop
+    {
+        boost::mutex::scoped_lock lock(mutex);
+        running = false;
+        signal.notify_all();
+        idle.notify_all();
+    }
+    if (thread.joinable()) {
+        thread.join();
+    }
+
+    // files
+    boost::mutex::scoped_lock lock(mutex);
+    this->unmap();
+    if (pfd >= 0) {
+        ::close(pfd);
+        pfd = -1;
+    }
+    if (ifd >= 0) {
+        ::close(ifd);
+        ifd = -1;
+    }
+}
+
+/**
+ * Looks up a response, stale entries are returned as such.
+ */
+CacheState Cache::get(const string &request, string &body) {
+
+    // entry
+    string raw;
+    CacheSlot entry;
+    {
+        boost::mutex::scoped_lock lock(mutex);
+        CacheSlot *slot = header ? this->find(Cache::hash(request)) : NULL;
+        if (! slot) {
+            return cacheMiss;
+        }
+        entry = *slot;
+        if (! this->load(pfd, entry.offset, entry.length, raw)) {
+            return cacheMiss;
+        }
+    }
+
+    // inflate
+    string stored;
+    if (! this->decode(raw, stored, body) || stored != request) {
+        return cacheMiss;
+    }
+
+    // age
+    int64_t age = time(NULL) - entry.stored;
+    if (age <= entry.ttl) {
+        return cacheFresh;
+    }
+    else if (age <= entry.ttl + cacheStaleMax) {
+        return cacheStale;
+    }
+    return cacheMiss;
+}
+
+/**
+ * Appends a response, the previous entry of the request becomes dead.
+ */
+bool Cache::put(const string &request, const string &endpoint, const string &body) {
+
+    // record
+    int t = this->lifetime(endpoint);
+    int64_t now = time(NULL);
+    string record;
+    if (! this->encode(request, body, t, now, record)) {
+        return false;
+    }
+    uint64_t key = Cache::hash(request);
+
+    // append
+    boost::mutex::scoped_lock lock(mutex);
+    if (! header || pwrite(pfd, record.data(), record.size(), pend) != (ssize_t)record.size()) {
+        return false;
+    }
+
+    // index
+    CacheSlot *slot = this->find(key);
+    if (slot) {
+        header->live -= slot->length;
+        header->dead += slot->length;
+    }
+    else {
+        if (header->used + 1 > header->capacity * cacheLoad && ! this->grow()) {
+            return false;
+        }
+        slot = this->insert(key);
+    }
+    slot->offset = pend;
+    slot->length = record.size();
+    slot->stored = now;
+    slot->ttl = t;
+    pend += record.size();
+    header->live += record.size();
+    header->end = pend;
+
+    // compact
+    if (header->dead > cacheCompactMin && header->dead > header->live && ! scheduled) {
+        scheduled = true;
+        signal.notify_one();
+    }
+    return true;
+}
+
+/**
+ * Serves a request from the cache. Stale entries are returned at once and
+ * refreshed by the worker, misses are fetched and stored.
+ */
+CacheState Cache::fetch(const string &request, const string &endpoint, const CacheFetch &f, string &body) {
+
+    // cached
+    CacheState state = this->get(request, body);
+
+    // revalidate
+    if (state == cacheStale) {
+        boost::mutex::scoped_lock lock(mutex);
+        if (running && pending.insert(Cache::hash(request)).second) {
+            Refresh refresh;
+            refresh.request = request;
+            refresh.endpoint = endpoint;
+            refresh.fetch = f;
+            refreshes.push_back(refresh);
+            signal.notify_one();
+        }
+    }
+
+    // fetch
+    else if (state == cacheMiss) {
+        string fetched;
+        if (f(request, fetched)) {
+            this->put(request, endpoint, fetched);
+            body.swap(fetched);
+            return cacheFresh;
+        }
+    }
+    return state;
+}
+
+/**
+ * Waits until the worker has run the queued refreshes and compactions.
+ */
+void Cache::drain() {
+    boost::mutex::scoped_lock lock(mutex);
+    while (running && (busy || scheduled || ! refreshes.empty())) {
+        idle.wait(lock);
+    }
+}
+
+/**
+ * Drops the entry of a request.
+ */
+void Cache::invalidate(const string &request) {
+    boost::mutex::scoped_lock lock(mutex);
+    CacheSlot *slot = header ? this->find(Cache::hash(request)) : NULL;
+    if (slot) {
+        this->remove(slot);
+    }
+}
+
+/**
+ * Drops all entries and truncates the pack.
+ */
+void Cache::clear() {
+    boost::mutex::scoped_lock lock(mutex);
+    if (header) {
+        this->wipe();
+        if (ftruncate(pfd, 0) == 0) {
+            pend = 0;
+        }
+        header->end = pend;
+    }
+    refreshes.clear();
+    pending.clear();
+}
+
+/**
+ * Rewrites the pack without dead and expired entries.
+ */
+void Cache::compact() {
+    this->compaction();
+}
+
+
+#pragma mark -
+#pragma mark Settings
+
+/**
+ * Sets the time to live of an endpoint.
+ */
+void Cache::ttl(const string &endpoint, int seconds) {
+    boost::mutex::scoped_lock lock(mutex);
+    ttls[endpoint] = seconds;
+}
+
+
+#pragma mark -
+#pragma mark Accessors
+
+/**
+ * Live entries.
+ */
+int Cache::size() {
+    boost::mutex::scoped_lock lock(mutex);
+    return header ? header->count : 0;
+}
+
+/**
+ * Dead bytes in the pack.
+ */
+uint64_t Cache::dead() {
+    boost::mutex::scoped_lock lock(mutex);
+    return header ? header->dead : 0;
+}
+
+/**
+ * FNV-1a hash of a request.
+ */
+uint64_t Cache::hash(const string &request) {
+    uint64_t h = 14695981039346656037ULL;
+    for (string::const_iterator c = request.begin(); c != request.end(); ++c) {
+        h ^= (unsigned char)*c;
+        h *= 1099511628211ULL;
+    }
+    return h;
+}
+
+
+#pragma mark -
+#pragma mark Helpers
+
+/**
+ * Maps the index, a new one is zeroed.
+ */
+bool Cache::map(uint32_t capacity, bool init) {
+
+    // size
+    size_t size = sizeof(CacheHeader) + capacity * sizeof(CacheSlot);
+    if (init && ftruncate(ifd, size) != 0) {
+        return false;
+    }
+
+    // map
+    void *p = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, ifd, 0);
+    if (p == MAP_FAILED) {
+        return false;
+    }
+    mapped = size;
+    header = static_cast<CacheHeader*>(p);
+    slots = reinterpret_cast<CacheSlot*>(header + 1);
+
+    // init
+    if (init) {
+        memset(p, 0, size);
+        header->magic = cacheMagic;
+        header->version = cacheVersion;
+        header->capacity = capacity;
+    }
+    return true;
+}
+
+/**
+ * Syncs and unmaps the index.
+ */
+void Cache::unmap() {
+    if (header) {
+        msync(header, mapped, MS_SYNC);
+        munmap(header, mapped);
+    }
+    header = NULL;
+    slots = NULL;
+    mapped = 0;
+}
+
+/**
+ * Doubles the index capacity.
+ */
+bool Cache::grow() {
+
+    // live
+    vector<CacheSlot> live;
+    live.reserve(header->count);
+    for (uint32_t i = 0; i < header->capacity; i++) {
+        if (slots[i].state == slotLive) {
+            live.push_back(slots[i]);
+        }
+    }
+    CacheHeader h = *header;
+
+    // remap
+    this->unmap();
+    if (! this->map(h.capacity * 2, true)) {
+        this->map(h.capacity, false);
+        return false;
+    }
+    header->generation = h.generation;
+    header->live = h.live;
+    header->dead = h.dead;
+    header->end = h.end;
+
+    // rehash
+    for (vector<CacheSlot>::const_iterator s = live.begin(); s != live.end(); ++s) {
+        *this->insert(s->key) = *s;
+    }
+    return true;
+}
+
+/**
+ * Empties the index.
+ */
+void Cache::wipe() {
+    memset(slots, 0, header->capacity * sizeof(CacheSlot));
+    header->count = 0;
+    header->used = 0;
+    header->live = 0;
+    header->dead = 0;
+    header->end = 0;
+}
+
+/**
+ * Live slot of a key.
+ */
+CacheSlot* Cache::find(uint64_t key) {
+    uint32_t capacity = header->capacity;
+    for (uint32_t i = 0, s = key % capacity; i < capacity; i++, s = (s + 1) % capacity) {
+        if (slots[s].state == slotEmpty) {
+            break;
+        }
+        if (slots[s].state == slotLive && slots[s].key == key) {
+            return &slots[s];
+        }
+    }
+    return NULL;
+}
+
+/**
+ * Claims a slot for a key that is not in the index, dead slots are reused.
+ */
+CacheSlot* Cache::insert(uint64_t key) {
+
+    // probe
+    uint32_t capacity = header->capacity;
+    uint32_t s = key % capacity;
+    while (slots[s].state == slotLive) {
+        s = (s + 1) % capacity;
+    }
+
+    // claim
+    if (slots[s].state == slotEmpty) {
+        header->used++;
+    }
+    header->count++;
+    memset(&slots[s], 0, sizeof(CacheSlot));
+    slots[s].key = key;
+    slots[s].state = slotLive;
+    return &slots[s];
+}
+
+/**
+ * Marks a slot dead.
+ */
+void Cache::remove(CacheSlot *slot) {
+    slot->state = slotDead;
+    header->count--;
+    header->live -= slot->length;
+    header->dead += slot->length;
+}
+
+/**
+ * Deflates a response into a pack record.
+ */
+bool Cache::encode(const string &request, const string &body, int t, int64_t stored, string &record) {
+
+    // deflate
+    size_t offset = sizeof(CacheRecord) + request.size();
+    uLongf length = compressBound(body.size());
+    record.resize(offset + length);
+    if (compress2((Bytef*)&record[offset], &length, (const Bytef*)body.data(), body.size(), Z_BEST_SPEED) != Z_OK) {
+        return false;
+    }
+    record.resize(offset + length);
+
+    // header
+    CacheRecord r;
+    r.magic = cacheMagic;
+    r.request = request.size();
+    r.size = body.size();
+    r.length = length;
+    r.key = Cache::hash(request);
+    r.stored = stored;
+    r.ttl = t;
+    r.crc = crc32(0, (const Bytef*)&record[offset], length);
+    memcpy(&record[0], &r, sizeof(r));
+    memcpy(&record[sizeof(r)], request.data(), request.size());
+    return true;
+}
+
+/**
+ * Reads a raw record.
+ */
+bool Cache::load(int fd, uint64_t offset, uint32_t length, string &raw) {
+    raw.resize(length);
+    size_t done = 0;
+    while (done < length) {
+        ssize_t n = pread(fd, &raw[done], length - done, offset + done);
+        if (n <= 0) {
+            return false;
+        }
+        done += n;
+    }
+    return true;
+}
+
+/**
+ * Checks and inflates a raw record.
+ */
+bool Cache::decode(const string &raw, string &request, string &body) {
+
+    // header
+    CacheRecord r;
+    if (raw.size() < sizeof(r)) {
+        return false;
+    }
+    memcpy(&r, raw.data(), sizeof(r));
+    if (r.magic != cacheMagic || sizeof(r) + r.request + r.length != raw.size()) {
+        return false;
+    }
+    request.assign(raw.data() + sizeof(r), r.request);
+
+    // check
+    const Bytef *data = (const Bytef*)raw.data() + sizeof(r) + r.request;
+    if (crc32(0, data, r.length) != r.crc) {
+        return false;
+    }
+
+    // inflate
+    body.resize(r.size);
+    uLongf size = r.size;
+    if (r.size > 0 && (uncompress((Bytef*)&body[0], &size, data, r.length) != Z_OK || size != r.size)) {
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Indexes the records of the pack from an offset on, a torn tail is cut.
+ */
+void Cache::recover(uint64_t from) {
+
+    // scan
+    uint64_t offset = from;
+    while (offset + sizeof(CacheRecord) <= pend) {
+        CacheRecord r;
+        if (pread(pfd, &r, sizeof(r), offset) != (ssize_t)sizeof(r)) {
+            break;
+        }
+        uint64_t length = sizeof(r) + r.request + r.length;
+        if (r.magic != cacheMagic || offset + length > pend) {
+            break;
+        }
+
+        // index
+        CacheSlot *slot = this->find(r.key);
+        if (slot) {
+            header->live -= slot->length;
+            header->dead += slot->length;
+        }
+        else {
+            if (header->used + 1 > header->capacity * cacheLoad && ! this->grow()) {
+                break;
+            }
+            slot = this->insert(r.key);
+        }
+        slot->offset = offset;
+        slot->length = length;
+        slot->stored = r.stored;
+        slot->ttl = r.ttl;
+        header->live += length;
+        offset += length;
+    }
+
+    // torn
+    if (offset < pend && ftruncate(pfd, offset) == 0) {
+        pend = offset;
+    }
+    header->end = pend;
+}
+
+/**
+ * Copies the live entries to the next pack generation. The bulk is copied
+ * without holding the lock, entries written meanwhile are caught up before
+ * the packs are swapped.
+ */
+void Cache::compaction() {
+    boost::mutex::scoped_lock clock(cmutex);
+
+    // snapshot
+    vector<CacheSlot> snapshot;
+    uint32_t generation;
+    int ofd;
+    {
+        boost::mutex::scoped_lock lock(mutex);
+        if (! header) {
+            return;
+        }
+        generation = header->generation;
+        ofd = pfd;
+        for (uint32_t i = 0; i < header->capacity; i++) {
+            if (slots[i].state == slotLive) {
+                snapshot.push_back(slots[i]);
+            }
+        }
+    }
+
+    // next pack
+    string npath = this->pack(generation + 1);
+    int nfd = ::open(npath.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (nfd < 0) {
+        return;
+    }
+    int64_t now = time(NULL);
+    uint64_t nend = 0;
+    std::map< uint64_t, pair<uint64_t,uint64_t> > moved;
+
+    // copy
+    string raw;
+    for (vector<CacheSlot>::const_iterator s = snapshot.begin(); s != snapshot.end(); ++s) {
+        if (s->stored + s->ttl + cacheStaleMax < now || ! this->load(ofd, s->offset, s->length, raw)) {
+            continue;
+        }
+        if (pwrite(nfd, raw.data(), raw.size(), nend) != (ssize_t)raw.size()) {
+            ::close(nfd);
+            unlink(npath.c_str());
+            return;
+        }
+        moved[s->key] = make_pair(s->offset, nend);
+        nend += s->length;
+    }
+
+    // catch up
+    boost::mutex::scoped_lock lock(mutex);
+    if (! header || pfd != ofd) {
+        ::close(nfd);
+        unlink(npath.c_str());
+        return;
+    }
+    vector<CacheSlot> live;
+    for (uint32_t i = 0; i < header->capacity; i++) {
+        if (slots[i].state != slotLive || slots[i].stored + slots[i].ttl + cacheStaleMax < now) {
+            continue;
+        }
+        CacheSlot s = slots[i];
+        std::map< uint64_t, pair<uint64_t,uint64_t> >::const_iterator m = moved.find(s.key);
+        if (m != moved.end() && m->second.first == s.offset) {
+            s.offset = m->second.second;
+        }
+        else {
+            if (! this->load(ofd, s.offset, s.length, raw) || pwrite(nfd, raw.data(), raw.size(), nend) != (ssize_t)raw.size()) {
+                ::close(nfd);
+                unlink(npath.c_str());
+                return;
+            }
+            s.offset = nend;
+            nend += s.length;
+        }
+        live.push_back(s);
+    }
+    fsync(nfd);
+
+    // swap
+    uint32_t capacity = header->capacity;
+    memset(slots, 0, capacity * sizeof(CacheSlot));
+    header->count = 0;
+    header->used = 0;
+    header->live = 0;
+    for (vector<CacheSlot>::const_iterator s = live.begin(); s != live.end(); ++s) {
+        *this->insert(s->key) = *s;
+        header->live += s->length;
+    }
+    header->generation = generation + 1;
+    header->dead = 0;
+    header->end = nend;
+    msync(header, mapped, MS_SYNC);
+    ::close(ofd);
+    pfd = nfd;
+    pend = nend;
+    unlink(this->pack(generation).c_str());
+}
+
+/**
+ * Runs refreshes and scheduled compactions until the cache is closed.
+ */
+void Cache::worker() {
+    while (true) {
+
+        // next
+        Refresh refresh;
+        {
+            boost::mutex::scoped_lock lock(mutex);
+            while (running && refreshes.empty() && ! scheduled) {
+                signal.wait(lock);
+            }
+            if (! running) {
+                return;
+            }
+            if (refreshes.empty()) {
+                scheduled = false;
+            }
+            else {
+                refresh = refreshes.front();
+                refreshes.pop_front();
+            }
+            busy = true;
+        }
+
+        // compact
+        if (refresh.request.empty()) {
+            this->compaction();
+        }
+
+        // refresh
+        else {
+            string body;
+            if (refresh.fetch(refresh.request, body)) {
+                this->put(refresh.request, refresh.endpoint, body);
+            }
+        }
+
+        // done
+        boost::mutex::scoped_lock lock(mutex);
+        if (! refresh.request.empty()) {
+            pending.erase(Cache::hash(refresh.request));
+        }
+        busy = false;
+        idle.notify_all();
+    }
+}
+
+/**
+ * Time to live of an endpoint.
+ */
+int Cache::lifetime(const string &endpoint) {
+    boost::mutex::scoped_lock lock(mutex);
+    std::map<string,int>::const_iterator t = ttls.find(endpoint);
+    return (t != ttls.end()) ? t->second : cacheTTL;
+}
+
+/**
+ * Path of a pack generation.
+ */
+string Cache::pack(uint32_t generation) {
+    char name[32];
+    snprintf(name, sizeof(name), "/responses-%u.pack", generation);
+    return dir + name;
+}
+
+/**
+ * Newest pack generation on disk.
+ */
+uint32_t Cache::latest() {
+    uint32_t generation = 0;
+    DIR *d = opendir(dir.c_str());
+    if (d) {
+        struct dirent *e;
+        while ((e = readdir(d)) != NULL) {
+            unsigned int g;
+            if (sscanf(e->d_name, "responses-%u.pack", &g) == 1 && g > generation) {
+                generation = g;
+            }
+        }
+        closedir(d);
+    }
+    return generation;
+}
@@ -0,0 +1,193 @@
+//
+//  Cache.h
+//  Solyaris
+//
+//  Created by CNPP on 19.10.2026.
+//  Copyright 2026 Beat Raess. All rights reserved.
+//
+//  This file is part of Solyaris.
+//
+//  Solyaris is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  Solyaris is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with Solyaris.  If not, see www.gnu.org/licenses/.
+
+
+#pragma once
+#include <boost/function.hpp>
+#include <boost/thread.hpp>
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include <deque>
+#include <map>
+#include <set>
+
+
+// namespace
+using namespace std;
+
+// typedef
+typedef boost::function<bool(const string&, string&)> CacheFetch;
+
+// constants
+const uint32_t cacheMagic = 0x534c5943;
+const uint32_t cacheVersion = 1;
+const uint32_t cacheCapacity = 1024;
+const double cacheLoad = 0.7;
+const int cacheTTL = 24 * 3600;
+const int cacheStaleMax = 30 * 24 * 3600;
+const uint64_t cacheCompactMin = 1024 * 1024;
+
+// states
+enum CacheState {
+    cacheMiss,
+    cacheFresh,
+    cacheStale
+};
+
+
+/**
+ * Cache Header.
+ * Start of the index file.
+ */
+struct CacheHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t capacity;
+    uint32_t count;
+    uint32_t used;
+    uint32_t generation;
+    uint64_t live;
+    uint64_t dead;
+    uint64_t end;
+};
+
+/**
+ * Cache Slot.
+ * Open addressing slot of the index, pointing into the pack.
+ */
+struct CacheSlot {
+    uint64_t key;
+    uint64_t offset;
+    uint32_t length;
+    uint32_t state;
+    int64_t stored;
+    int32_t ttl;
+    uint32_t reserved;
+};
+
+/**
+ * Cache Record.
+ * Header of a pack entry, followed by the request and the deflated body.
+ */
+struct CacheRecord {
+    uint32_t magic;
+    uint32_t request;
+    uint32_t size;
+    uint32_t length;
+    uint64_t key;
+    int64_t stored;
+    int32_t ttl;
+    uint32_t crc;
+};
+
+
+/**
+ * Response Cache.
+ * Deflated response bodies are appended to a pack file and found through
+ * an mmap'd open addressing index keyed by the FNV-1a hash of the request.
+ * Entries expire by a per endpoint TTL and are served stale while a worker
+ * refreshes them; the worker also rewrites the pack once enough of it is
+ * dead. The index survives restarts, a lost tail is recovered from the pack.
+ */
+class Cache {
+
+    // public
+    public:
+
+    // Cache
+    Cache(const string &dir);
+    ~Cache();
+
+    // Business
+    bool open();
+    void close();
+    CacheState get(const string &request, string &body);
+    bool put(const string &request, const string &endpoint, const string &body);
+    CacheState fetch(const string &request, const string &endpoint, const CacheFetch &f, string &body);
+    void invalidate(const string &request);
+    void clear();
+    void compact();
+    void drain();
+
+    // Settings
+    void ttl(const string &endpoint, int seconds);
+
+    // Accessors
+    int size();
+    uint64_t dead();
+    static uint64_t hash(const string &request);
+
+
+    // private
+    private:
+
+    // Refresh
+    struct Refresh {
+        string request;
+        string endpoint;
+        CacheFetch fetch;
+    };
+
+    // Helpers
+    bool map(uint32_t capacity, bool init);
+    void unmap();
+    bool grow();
+    void wipe();
+    CacheSlot* find(uint64_t key);
+    CacheSlot* insert(uint64_t key);
+    void remove(CacheSlot *slot);
+    bool encode(const string &request, const string &body, int t, int64_t stored, string &record);
+    bool load(int fd, uint64_t offset, uint32_t length, string &raw);
+    bool decode(const string &raw, string &request, string &body);
+    void recover(uint64_t from);
+    void compaction();
+    void worker();
+    int lifetime(const string &endpoint);
+    string pack(uint32_t generation);
+    uint32_t latest();
+
+    // Files
+    string dir;
+    int ifd;
+    int pfd;
+    uint64_t pend;
+    CacheHeader *header;
+    CacheSlot *slots;
+    size_t mapped;
+
+    // Settings
+    std::map<string,int> ttls;
+
+    // Worker
+    boost::mutex mutex;
+    boost::mutex cmutex;
+    boost::condition_variable signal;
+    boost::condition_variable idle;
+    boost::thread thread;
+    deque<Refresh> refreshes;
+    set<uint64_t> pending;
+    bool scheduled;
+    bool busy;
+    bool running;
+
+};
@@ -45,10 +45,10 @@ void Configuration::setConfiguration(string key, string value) {
     // add
     configurations.insert(make_pair(key, Config(key,value)));
 }
-Config Configuration::getConfiguration(string key) {
+Config Configuration::getConfiguration(const string &key) const {
     
     // search
-    map<string,Config>::iterator it = configurations.find(key);
+    map<string,Config>::const_iterator it = configurations.find(key);
     if(it != configurations.end()) {
         return it->second;
     }
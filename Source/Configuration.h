@@ -52,7 +52,7 @@ class Configuration {
     
     // Accessors
     void setConfiguration(string key, string value);
-    Config getConfiguration(string key);
+    Config getConfiguration(const string &key) const;
     
     // Suffix
     static string sfx(float dpr);
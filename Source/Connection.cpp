@@ -31,12 +31,10 @@
  */
 Connection::Connection() {
 }
-Connection::Connection(string idc, NodePtr n1, NodePtr n2) {
+Connection::Connection(const string &idc, const NodePtr &n1, const NodePtr &n2) {
     
     // fields
     cid = idc;
-    redux = false;
-    dpr = 1.0;
     
     // nodes
     wnode1 = NodeWeakPtr(n1);
@@ -48,10 +46,6 @@ Connection::Connection(string idc, NodePtr n1, NodePtr n2) {
     // color
     cstroke = Color(0.78,0.78,0.78);
     cstrokes = Color(0.63,0.63,0.63);
-    
-    // size
-    s = 1.0;
-    d = 4.0;
 
 }
 
@@ -61,7 +55,7 @@ Connection::Connection(string idc, NodePtr n1, NodePtr n2) {
  */
 ConnectionRelated::ConnectionRelated(): Connection::Connection()  {    
 }
-ConnectionRelated::ConnectionRelated(string idc, NodePtr n1, NodePtr n2): Connection::Connection(idc,n1,n2) {
+ConnectionRelated::ConnectionRelated(const string &idc, const NodePtr &n1, const NodePtr &n2): Connection::Connection(idc,n1,n2) {
     
     // type
     type = connectionRelated;
@@ -69,38 +63,6 @@ ConnectionRelated::ConnectionRelated(string idc, NodePtr n1, NodePtr n2): Connec
 
 
 
-#pragma mark -
-#pragma mark Cinder
-
-/**
- * Applies the configuration.
- */
-void Connection::config(Configuration c) {
-    
-    // device redux
-    redux = false;
-    Config confDeviceRedux = c.getConfiguration(cDeviceRedux);
-    if (confDeviceRedux.isSet()) {
-        redux = confDeviceRedux.boolVal();
-    }
-    
-    // resolution
-    Config confDisplayResolution = c.getConfiguration(cDisplayResolution);
-    dpr = confDisplayResolution.floatVal();
-    
-    // size
-    s = 1.0 * dpr;
-    d = 4.0 * dpr;
-    
-}
-
-/**
- * Applies the settings.
- */
-void Connection::defaults(Defaults d) {
-}
-
-
 #pragma mark -
 #pragma mark Sketch
 
@@ -142,11 +104,12 @@ void Connection::draw() {
         selected ? gl::color(cstrokes) : gl::color(cstroke);
         
         // params
+        float s = Params::connection().s;
         int nb = 100;
-        float ox = node1->pos.x;
-        float oy = node1->pos.y;
-        float dx = (node2->pos.x - node1->pos.x) / (float)nb;
-        float dy = (node2->pos.y - node1->pos.y) / (float)nb;
+        float ox = node1->body->pos.x;
+        float oy = node1->body->pos.y;
+        float dx = (node2->body->pos.x - node1->body->pos.x) / (float)nb;
+        float dy = (node2->body->pos.y - node1->body->pos.y) / (float)nb;
         for (int i = 0; i < nb; i++) {
             gl::drawSolidRect( Rectf(ox+dx*i, oy+dy*i, ox+dx*i+s, oy+dy*i+s) );
         }
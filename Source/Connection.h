@@ -55,11 +55,7 @@ class Connection {
     
     // Connection
     Connection();
-    Connection(string idc, NodePtr n1, NodePtr n2); 
-    
-    // Cinder
-    void config(Configuration c);
-    void defaults(Defaults s);
+    Connection(const string &idc, const NodePtr &n1, const NodePtr &n2); 
     
     // Sketch
     void update();
@@ -79,18 +75,10 @@ class Connection {
     // States
     bool selected;
     
-    // config
-    bool redux;
-    float dpr;
-    
     // color
     Color cstroke;
     Color cstrokes;
     
-    // size
-    float s;
-    float d;
-    
 };
 
 class ConnectionRelated: public Connection {
@@ -100,7 +88,7 @@ class ConnectionRelated: public Connection {
     
     // Connection
     ConnectionRelated();
-    ConnectionRelated(string idc, NodePtr n1, NodePtr n2);
+    ConnectionRelated(const string &idc, const NodePtr &n1, const NodePtr &n2);
 };
 
 
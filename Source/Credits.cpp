@@ -0,0 +1,443 @@
+//
+//  Credits.cpp
+//  Solyaris
+//
+//  Created by CNPP on 19.10.2026.
+//  Copyright 2026 Beat Raess. All rights reserved.
+//
+//  This file is part of Solyaris.
+//
+//  Solyaris is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  Solyaris is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with Solyaris.  If not, see www.gnu.org/licenses/.
+
+#include "Credits.h"
+#include <algorithm>
+#include <cstdio>
+#include <cctype>
+
+
+// sort
+static bool creditByOrder(const Credit &a, const Credit &b) {
+    return a.order < b.order;
+}
+static bool creditByYear(const Credit &a, const Credit &b) {
+    return a.year > b.year;
+}
+
+
+#pragma mark -
+#pragma mark Object
+
+/**
+ * Creates an ingest for the credits of a node of the given type.
+ */
+CreditsIngest::CreditsIngest(const string &t) : json(this) {
+    type = t;
+    this->reset();
+}
+
+
+#pragma mark -
+#pragma mark Business
+
+/**
+ * Feeds the next chunk of the response.
+ */
+bool CreditsIngest::feed(const char *data, size_t length) {
+    return json.feed(data, length);
+}
+
+/**
+ * Ends the response and sorts the credits for display.
+ */
+bool CreditsIngest::finish() {
+
+    // parse
+    if (! json.finish()) {
+        return false;
+    }
+
+    // sort
+    if (type == creditMovie) {
+        stable_sort(records.begin(), records.end(), creditByOrder);
+    }
+    else {
+        stable_sort(records.begin(), records.end(), creditByYear);
+    }
+    index.clear();
+    return true;
+}
+
+/**
+ * Resets the ingest for the next response.
+ */
+void CreditsIngest::reset() {
+    json.reset();
+    section = sectionNone;
+    depth = 0;
+    sdepth = 0;
+    pending = fieldOther;
+    valid = true;
+    counter = 0;
+    root = 0;
+    records.clear();
+    index.clear();
+}
+
+/**
+ * Graph mutations for the credits, crew of a movie is flagged as excluded
+ * unless crew is enabled.
+ */
+void CreditsIngest::batch(MutationBatch &b, bool crew) const {
+    CreditsIngest::batch(type, root, records, crew, b);
+}
+
+/**
+ * Graph mutations for the sorted credits of a node.
+ */
+void CreditsIngest::batch(const string &type, int id, const vector<Credit> &credits, bool crew, MutationBatch &b) {
+
+    // parent
+    bool movie = (type == creditMovie);
+    b.nid = CreditsIngest::node(type, id);
+    b.type = type;
+    b.subtype.clear();
+    b.label.clear();
+    b.meta.clear();
+    b.category.clear();
+    b.mutations.clear();
+    b.mutations.reserve(credits.size());
+
+    // children
+    for (vector<Credit>::const_iterator credit = credits.begin(); credit != credits.end(); ++credit) {
+        b.mutations.push_back(Mutation());
+        Mutation &m = b.mutations.back();
+
+        // node
+        m.ctype = movie ? creditPerson : creditMovie;
+        m.cid = CreditsIngest::node(m.ctype, credit->id);
+        m.csubtype = movie ? credit->type : "";
+        m.clabel = credit->name;
+        m.cmeta = movie ? "" : credit->year;
+
+        // edge
+        m.eid = b.nid + "_edge_" + m.cid;
+        m.etype = credit->type;
+        m.job = (credit->type == creditDirector || credit->type == creditCrew);
+        m.elabel = m.job ? credit->job : credit->character;
+        m.excluded = movie && ! crew && credit->type == creditCrew;
+    }
+}
+
+
+#pragma mark -
+#pragma mark Accessors
+
+/**
+ * Id of the loaded node.
+ */
+int CreditsIngest::source() const {
+    return root;
+}
+
+/**
+ * Credits, sorted once finished.
+ */
+const vector<Credit>& CreditsIngest::credits() const {
+    return records;
+}
+
+/**
+ * Parse error.
+ */
+const string& CreditsIngest::error() const {
+    return json.error();
+}
+
+
+#pragma mark -
+#pragma mark JsonHandler
+
+/**
+ * Object, a credit inside cast or crew.
+ */
+void CreditsIngest::objectStart() {
+    depth++;
+
+    // credit
+    if (section != sectionNone && depth == sdepth + 1) {
+        current = Credit();
+        current.id = 0;
+        current.order = creditOrder;
+        title.clear();
+        valid = true;
+    }
+}
+
+/**
+ * Object end, commits a credit.
+ */
+void CreditsIngest::objectEnd() {
+    if (section != sectionNone && depth == sdepth + 1) {
+        this->commit();
+    }
+    depth--;
+}
+
+/**
+ * Array, cast or crew.
+ */
+void CreditsIngest::arrayStart() {
+    depth++;
+
+    // section
+    if (section == sectionNone && depth <= 3) {
+        if (pending == fieldCast) {
+            section = sectionCast;
+            sdepth = depth;
+        }
+        else if (pending == fieldCrew) {
+            section = sectionCrew;
+            sdepth = depth;
+        }
+    }
+}
+
+/**
+ * Array end.
+ */
+void CreditsIngest::arrayEnd() {
+    if (section != sectionNone && depth == sdepth) {
+        section = sectionNone;
+    }
+    depth--;
+}
+
+/**
+ * Key of the next value.
+ */
+void CreditsIngest::key(const string &k) {
+    if (k == "id") {
+        pending = fieldId;
+    }
+    else if (k == "name" || k == "original_title") {
+        pending = fieldName;
+    }
+    else if (k == "title") {
+        pending = fieldTitle;
+    }
+    else if (k == "character") {
+        pending = fieldCharacter;
+    }
+    else if (k == "department") {
+        pending = fieldDepartment;
+    }
+    else if (k == "job") {
+        pending = fieldJob;
+    }
+    else if (k == "order") {
+        pending = fieldOrder;
+    }
+    else if (k == "release_date") {
+        pending = fieldRelease;
+    }
+    else if (k == "media_type") {
+        pending = fieldMedia;
+    }
+    else if (k == "adult") {
+        pending = fieldAdult;
+    }
+    else if (k == "cast") {
+        pending = fieldCast;
+    }
+    else if (k == "crew") {
+        pending = fieldCrew;
+    }
+    else {
+        pending = fieldOther;
+    }
+}
+
+/**
+ * String field.
+ */
+void CreditsIngest::text(const string &s) {
+    if (! this->record()) {
+        return;
+    }
+
+    // fields
+    switch (pending) {
+        case fieldName:
+            current.name = s;
+            break;
+        case fieldTitle:
+            title = s;
+            break;
+        case fieldCharacter:
+            current.character = s;
+            break;
+        case fieldDepartment:
+            current.department = s;
+            break;
+        case fieldJob:
+            current.job = s;
+            break;
+        case fieldRelease:
+            current.year = s.substr(0, 4);
+            break;
+        case fieldMedia:
+            valid = valid && s == "movie";
+            break;
+        default:
+            break;
+    }
+}
+
+/**
+ * Number field, or the id of the loaded node.
+ */
+void CreditsIngest::number(double n) {
+
+    // root
+    if (depth == 1 && pending == fieldId) {
+        root = (int)n;
+        return;
+    }
+
+    // fields
+    if (! this->record()) {
+        return;
+    }
+    if (pending == fieldId) {
+        current.id = (int)n;
+    }
+    else if (pending == fieldOrder) {
+        current.order = (int)n;
+    }
+}
+
+/**
+ * Boolean field.
+ */
+void CreditsIngest::boolean(bool b) {
+    if (this->record() && pending == fieldAdult && b) {
+        valid = false;
+    }
+}
+
+
+#pragma mark -
+#pragma mark Helpers
+
+/**
+ * Value belongs to the current credit.
+ */
+bool CreditsIngest::record() const {
+    return section != sectionNone && depth == sdepth + 1;
+}
+
+/**
+ * Validates the current credit and merges it by id.
+ */
+void CreditsIngest::commit() {
+
+    // validate
+    if (current.name.empty()) {
+        current.name = title;
+    }
+    if (! valid || current.id <= 0) {
+        return;
+    }
+    if (type == creditPerson) {
+        string lower = current.name;
+        transform(lower.begin(), lower.end(), lower.begin(), ::tolower);
+        if (lower.find("obsolete") != string::npos) {
+            return;
+        }
+    }
+    counter++;
+
+    // merged
+    Credit *credit;
+    map<int,int>::iterator it = index.find(current.id);
+    if (it == index.end()) {
+        index[current.id] = records.size();
+        records.push_back(current);
+        credit = &records.back();
+        credit->type = "";
+        credit->character = "";
+        credit->department = "";
+        credit->job = "";
+        credit->order = creditOrder;
+    }
+    else {
+        credit = &records[it->second];
+    }
+
+    // cast
+    if (section == sectionCast) {
+        credit->type = this->category(credit->type, creditActor);
+        credit->character = this->merge(credit->character, current.character);
+        if (type == creditMovie) {
+            credit->order = min(credit->order, current.order);
+        }
+    }
+    // crew
+    else {
+        credit->type = this->category(credit->type, current.department);
+        credit->department = this->merge(credit->department, current.department);
+        credit->job = this->merge(credit->job, current.job);
+        if (type == creditMovie) {
+            credit->order = min(credit->order, counter);
+        }
+        if (credit->type == creditDirector) {
+            credit->order = -1;
+        }
+    }
+}
+
+/**
+ * Appends a value not yet contained.
+ */
+string CreditsIngest::merge(const string &original, const string &updated) const {
+    if (original.empty()) {
+        return updated;
+    }
+    if (! updated.empty() && original.find(updated) == string::npos) {
+        return original + ", " + updated;
+    }
+    return original;
+}
+
+/**
+ * Person type, directing wins over acting over crew.
+ */
+string CreditsIngest::category(const string &original, const string &updated) const {
+    if (updated.find("Directing") != string::npos || original.find(creditDirector) != string::npos) {
+        return creditDirector;
+    }
+    else if (updated == creditActor || original.find(creditActor) != string::npos) {
+        return creditActor;
+    }
+    return creditCrew;
+}
+
+/**
+ * Node id of a movie or person.
+ */
+string CreditsIngest::node(const string &t, int id) {
+    char nid[64];
+    snprintf(nid, sizeof(nid), "%s_%i", t.c_str(), id);
+    return nid;
+}
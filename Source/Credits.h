@@ -0,0 +1,152 @@
+//
+//  Credits.h
+//  Solyaris
+//
+//  Created by CNPP on 19.10.2026.
+//  Copyright 2026 Beat Raess. All rights reserved.
+//
+//  This file is part of Solyaris.
+//
+//  Solyaris is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  Solyaris is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with Solyaris.  If not, see www.gnu.org/licenses/.
+
+
+#pragma once
+#include "Json.h"
+#include "Mutation.h"
+#include <string>
+#include <vector>
+#include <map>
+
+
+// namespace
+using namespace std;
+
+
+// constants
+const string creditMovie = "movie";
+const string creditPerson = "person";
+const string creditActor = "person_actor";
+const string creditDirector = "person_director";
+const string creditCrew = "person_crew";
+const int creditOrder = 10000;
+
+
+/**
+ * Credit.
+ * A person of a movie or a movie of a person. Repeated entries of the same
+ * id are merged the way the TMDb parser merges them into Movie2Person.
+ */
+struct Credit {
+    int id;
+    string name;
+    string type;
+    string character;
+    string department;
+    string job;
+    string year;
+    int order;
+};
+
+
+/**
+ * Credits Ingest.
+ * Streams the cast and crew arrays of a TMDb response into credits, either
+ * top level or nested in credits / movie_credits. The type is the one of
+ * the loaded node, a movie yields persons and a person yields movies.
+ */
+class CreditsIngest : public JsonHandler {
+
+    // public
+    public:
+
+    // CreditsIngest
+    CreditsIngest(const string &t);
+
+    // Business
+    bool feed(const char *data, size_t length);
+    bool finish();
+    void reset();
+    void batch(MutationBatch &b, bool crew) const;
+    static void batch(const string &type, int id, const vector<Credit> &credits, bool crew, MutationBatch &b);
+
+    // Accessors
+    int source() const;
+    const vector<Credit>& credits() const;
+    const string& error() const;
+    static string node(const string &type, int id);
+
+    // JsonHandler
+    void objectStart();
+    void objectEnd();
+    void arrayStart();
+    void arrayEnd();
+    void key(const string &k);
+    void text(const string &s);
+    void number(double n);
+    void boolean(bool b);
+
+
+    // private
+    private:
+
+    // Sections
+    enum Section {
+        sectionNone,
+        sectionCast,
+        sectionCrew
+    };
+
+    // Fields
+    enum Field {
+        fieldOther,
+        fieldId,
+        fieldName,
+        fieldTitle,
+        fieldCharacter,
+        fieldDepartment,
+        fieldJob,
+        fieldOrder,
+        fieldRelease,
+        fieldMedia,
+        fieldAdult,
+        fieldCast,
+        fieldCrew
+    };
+
+    // Helpers
+    bool record() const;
+    void commit();
+    string merge(const string &original, const string &updated) const;
+    string category(const string &original, const string &updated) const;
+
+    // Parser
+    Json json;
+    string type;
+
+    // State
+    Section section;
+    int depth;
+    int sdepth;
+    Field pending;
+    Credit current;
+    string title;
+    bool valid;
+    int counter;
+    int root;
+
+    // Credits
+    vector<Credit> records;
+    map<int,int> index;
+
+};
@@ -45,10 +45,10 @@ void Defaults::setDefault(string key, string value) {
     // add
     defaults.insert(make_pair(key, Default(key,value)));
 }
-Default Defaults::getDefault(string key) {
+Default Defaults::getDefault(const string &key) const {
     
     // search
-    map<string,Default>::iterator it = defaults.find(key);
+    map<string,Default>::const_iterator it = defaults.find(key);
     if(it != defaults.end()) {
         return it->second;
     }
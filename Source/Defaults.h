@@ -39,6 +39,9 @@ const string  dGraphLayoutSubnodesDisabled     = "graph_layout_subnodes_disabled
 const string  dGraphCrewEnabled                = "graph_crew_enabled";	
 const string  dGraphNodeInitial                = "graph_node_initial";	
 const string  dGraphEdgeLength                 = "graph_edge_length";
+const string  dGraphLayoutSubsteps             = "graph_layout_substeps";
+const string  dGraphLayoutEngine               = "graph_layout_engine";
+const string  dGraphMutationBudget             = "graph_mutation_budget";
 
 
 
@@ -55,7 +58,7 @@ class Defaults {
     
     // Accessors
     void setDefault(string key, string value);
-    Default getDefault(string key);
+    Default getDefault(const string &key) const;
     
     // private
     private:
@@ -0,0 +1,1096 @@
+//
+//  Dump.cpp
+//  Solyaris
+//
+//  Created by CNPP on 19.10.2026.
+//  Copyright 2026 Beat Raess. All rights reserved.
+//
+//  This file is part of Solyaris.
+//
+//  Solyaris is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  Solyaris is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with Solyaris.  If not, see www.gnu.org/licenses/.
+
+#include "Dump.h"
+#include <boost/thread.hpp>
+#include <boost/bind.hpp>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+
+
+/**
+ * Dump Line.
+ * Collects the top level fields of a movie or person line.
+ */
+class DumpLine : public JsonHandler {
+
+    // public
+    public:
+
+    // DumpLine
+    DumpLine() : depth(0), id(0), year(0), adult(false) {}
+
+    // JsonHandler
+    void objectStart() { depth++; }
+    void objectEnd() { depth--; }
+    void arrayStart() { depth++; }
+    void arrayEnd() { depth--; }
+    void key(const string &k) { if (depth == 1) pending = k; }
+    void text(const string &s) {
+        if (depth != 1) {
+            return;
+        }
+        if (pending == "name" || pending == "title" || (pending == "original_title" && name.empty())) {
+            name = s;
+        }
+        else if (pending == "release_date") {
+            year = atoi(s.substr(0, 4).c_str());
+        }
+    }
+    void number(double n) { if (depth == 1 && pending == "id") id = (int)n; }
+    void boolean(bool b) { if (depth == 1 && pending == "adult") adult = b; }
+
+    // Fields
+    int depth;
+    string pending;
+    int id;
+    string name;
+    int year;
+    bool adult;
+
+};
+
+// sort
+struct DumpById {
+    template <typename T>
+    bool operator()(const T &a, const T &b) const { return a.id < b.id; }
+};
+struct DumpSameId {
+    template <typename T>
+    bool operator()(const T &a, const T &b) const { return a.id == b.id; }
+};
+struct DumpByYear {
+    const vector<DumpMovie> *movies;
+    bool operator()(const DumpCredit &a, const DumpCredit &b) const {
+        const DumpMovie &ma = (*movies)[a.node];
+        const DumpMovie &mb = (*movies)[b.node];
+        return ma.year > mb.year || (ma.year == mb.year && a.node < b.node);
+    }
+};
+struct DumpByKey {
+    const vector<char> *pool;
+    bool operator()(const DumpName &a, const DumpName &b) const {
+        int c = strcmp(&(*pool)[a.key], &(*pool)[b.key]);
+        return c < 0 || (c == 0 && a.node < b.node);
+    }
+};
+
+// merge, equal elements keep the order of their runs so the result is a
+// stable sort of the runs one after the other
+template <typename T, typename Less>
+struct DumpRuns {
+    const vector< pair<const T*, const T*> > *runs;
+    Less less;
+    bool operator()(size_t a, size_t b) const {
+        const T &ta = *(*runs)[a].first;
+        const T &tb = *(*runs)[b].first;
+        return less(tb, ta) || (! less(ta, tb) && b < a);
+    }
+};
+template <typename T, typename Less>
+static void dumpMerge(vector< pair<const T*, const T*> > runs, Less less, vector<T> &out) {
+    size_t total = 0;
+    vector<size_t> heap;
+    for (size_t r = 0; r < runs.size(); r++) {
+        total += runs[r].second - runs[r].first;
+        if (runs[r].first != runs[r].second) {
+            heap.push_back(r);
+        }
+    }
+    DumpRuns<T, Less> order;
+    order.runs = &runs;
+    order.less = less;
+    make_heap(heap.begin(), heap.end(), order);
+    out.clear();
+    out.reserve(total);
+    while (! heap.empty()) {
+        pop_heap(heap.begin(), heap.end(), order);
+        size_t r = heap.back();
+        out.push_back(*runs[r].first++);
+        if (runs[r].first == runs[r].second) {
+            heap.pop_back();
+        }
+        else {
+            push_heap(heap.begin(), heap.end(), order);
+        }
+    }
+}
+
+// helpers
+static string dumpLower(const string &s) {
+    string l(s);
+    for (string::iterator c = l.begin(); c != l.end(); ++c) {
+        if (*c >= 'A' && *c <= 'Z') {
+            *c += 'a' - 'A';
+        }
+    }
+    return l;
+}
+static void dumpTasks(const boost::function<void(int)> &task, int first, int n, int step) {
+    for (int t = first; t < n; t += step) {
+        task(t);
+    }
+}
+static double dumpNow() {
+    struct timeval t;
+    gettimeofday(&t, NULL);
+    return t.tv_sec + t.tv_usec / 1000000.0;
+}
+
+
+#pragma mark -
+#pragma mark DumpImport
+
+/**
+ * Merge state shared by the tasks of an import.
+ */
+struct DumpImport::Merge {
+
+    // chunks, movies then people then credits
+    vector<Chunk*> chunks;
+    size_t people;
+    size_t credits;
+    int parts;
+
+    // strings, interned in hash shards
+    vector<Strings> shards;
+    vector<uint32_t> bases;
+    uint32_t director;
+    uint32_t actor;
+    uint32_t crew;
+
+    // nodes
+    vector<DumpMovie> movies;
+    vector<DumpPerson> persons;
+    vector<uint32_t> mcount;
+    vector<uint32_t> pcount;
+    vector<uint32_t> pfill;
+    vector<int> pranks;
+
+    // rows
+    vector<DumpCredit> mrows;
+    vector<DumpCredit> prows;
+
+    // pool, shard strings then lowercased names
+    vector<char> used;
+    vector<uint32_t> offsets;
+    vector<uint32_t> keys;
+    vector<size_t> sizes;
+    vector<char> text;
+    vector<DumpName> names;
+    vector<DumpName> sorted;
+
+    // range of a part
+    size_t first(size_t n, int part) const { return n * part / parts; }
+    size_t last(size_t n, int part) const { return n * (part + 1) / parts; }
+};
+
+/**
+ * Creates an importer using the given number of threads, 0 for all cores.
+ */
+DumpImport::DumpImport(int t) {
+    memset(&info, 0, sizeof(info));
+    threads = (t > 0) ? t : max(1, (int)boost::thread::hardware_concurrency());
+}
+
+/**
+ * Imports the dumps into the graph file, any dump may be empty.
+ */
+bool DumpImport::run(const string &movies, const string &people, const string &credits, const string &out) {
+    double start = dumpNow();
+    memset(&info, 0, sizeof(info));
+    info.threads = threads;
+
+    // parse
+    vector<Chunk> mchunks;
+    vector<Chunk> pchunks;
+    vector<Chunk> cchunks;
+    if (! this->parse(movies, false, mchunks) || ! this->parse(people, false, pchunks) || ! this->parse(credits, true, cchunks)) {
+        return false;
+    }
+    info.parsing = dumpNow() - start;
+
+    // merge
+    Merge m;
+    m.parts = threads;
+    for (size_t c = 0; c < mchunks.size(); c++) {
+        m.chunks.push_back(&mchunks[c]);
+    }
+    m.people = m.chunks.size();
+    for (size_t c = 0; c < pchunks.size(); c++) {
+        m.chunks.push_back(&pchunks[c]);
+    }
+    m.credits = m.chunks.size();
+    for (size_t c = 0; c < cchunks.size(); c++) {
+        m.chunks.push_back(&cchunks[c]);
+    }
+    int nchunks = m.chunks.size();
+
+    // strings, each shard interns its share of every chunk
+    m.shards.resize(threads);
+    this->parallel(nchunks, boost::bind(&DumpImport::distribute, &m, _1));
+    this->parallel(threads, boost::bind(&DumpImport::intern, &m, _1));
+    boost::hash<string> hash;
+    m.director = m.shards[hash(creditDirector) % threads].intern(creditDirector);
+    m.actor = m.shards[hash(creditActor) % threads].intern(creditActor);
+    m.crew = m.shards[hash(creditCrew) % threads].intern(creditCrew);
+    m.bases.resize(threads + 1, 0);
+    for (int s = 0; s < threads; s++) {
+        m.bases[s + 1] = m.bases[s] + m.shards[s].size();
+    }
+    m.director += m.bases[hash(creditDirector) % threads];
+    m.actor += m.bases[hash(creditActor) % threads];
+    m.crew += m.bases[hash(creditCrew) % threads];
+
+    // nodes, sorted per chunk and merged
+    this->parallel(nchunks, boost::bind(&DumpImport::runs, &m, _1));
+    vector< pair<const DumpMovie*, const DumpMovie*> > mruns;
+    vector< pair<const DumpPerson*, const DumpPerson*> > pruns;
+    for (int c = 0; c < nchunks; c++) {
+        const Chunk *chunk = m.chunks[c];
+        if (! chunk->mrun.empty()) {
+            mruns.push_back(make_pair(&chunk->mrun[0], &chunk->mrun[0] + chunk->mrun.size()));
+        }
+        if (! chunk->prun.empty()) {
+            pruns.push_back(make_pair(&chunk->prun[0], &chunk->prun[0] + chunk->prun.size()));
+        }
+    }
+    dumpMerge(mruns, DumpById(), m.movies);
+    m.movies.erase(unique(m.movies.begin(), m.movies.end(), DumpSameId()), m.movies.end());
+    dumpMerge(pruns, DumpById(), m.persons);
+    m.persons.erase(unique(m.persons.begin(), m.persons.end(), DumpSameId()), m.persons.end());
+
+    // links, counted per node
+    m.mcount.assign(m.movies.size(), 0);
+    m.pcount.assign(m.persons.size(), 0);
+    m.pfill.assign(m.persons.size(), 0);
+    m.pranks.assign(m.persons.size(), -1);
+    this->parallel(nchunks - m.credits, boost::bind(&DumpImport::link, &m, _1));
+
+    // movie rows, lines are in billing order already
+    uint32_t sum = 0;
+    for (size_t i = 0; i < m.movies.size(); i++) {
+        m.movies[i].first = sum;
+        sum += m.mcount[i];
+    }
+    m.mrows.resize(sum);
+    m.prows.resize(sum);
+    vector<uint32_t> mfill(m.movies.size(), 0);
+    for (size_t c = m.credits; c < m.chunks.size(); c++) {
+        Chunk *chunk = m.chunks[c];
+        chunk->starts.resize(chunk->rows.size());
+        for (size_t r = 0; r < chunk->rows.size(); r++) {
+            uint32_t mi = chunk->mindex[r];
+            size_t end = (r + 1 < chunk->rows.size()) ? chunk->rows[r+1].second : chunk->links.size();
+            chunk->starts[r] = m.movies[mi].first + mfill[mi];
+            mfill[mi] += end - chunk->rows[r].second;
+        }
+    }
+
+    // person rows, latest first
+    sum = 0;
+    for (size_t i = 0; i < m.persons.size(); i++) {
+        int rank = m.pranks[i];
+        m.persons[i].first = sum;
+        m.persons[i].type = (rank == 2) ? m.director : ((rank == 1) ? m.actor : ((rank == 0) ? m.crew : 0));
+        sum += m.pcount[i];
+    }
+    this->parallel(nchunks - m.credits, boost::bind(&DumpImport::fill, &m, _1));
+    this->parallel(threads, boost::bind(&DumpImport::order, &m, _1));
+
+    // pool, shards and lowercased names measured, then copied in place
+    uint32_t nstrings = m.bases[threads];
+    m.used.assign(nstrings, 0);
+    for (size_t i = 0; i < m.movies.size(); i++) {
+        m.used[m.movies[i].title] = m.movies[i].title != 0;
+    }
+    for (size_t i = 0; i < m.persons.size(); i++) {
+        m.used[m.persons[i].name] = m.persons[i].name != 0;
+    }
+    m.offsets.resize(nstrings);
+    m.keys.resize(nstrings);
+    m.sizes.assign(2 * threads + 1, 0);
+    this->parallel(2 * threads, boost::bind(&DumpImport::measure, &m, _1));
+    for (int part = 0; part < 2 * threads; part++) {
+        m.sizes[part + 1] += m.sizes[part];
+    }
+    m.text.resize(m.sizes[2 * threads]);
+    this->parallel(2 * threads, boost::bind(&DumpImport::pool, &m, _1));
+
+    // names, sorted per range and merged
+    for (size_t i = 0; i < m.movies.size(); i++) {
+        if (m.movies[i].title) {
+            DumpName n = { m.keys[m.movies[i].title], (uint32_t)i };
+            m.names.push_back(n);
+        }
+    }
+    for (size_t i = 0; i < m.persons.size(); i++) {
+        if (m.persons[i].name) {
+            DumpName n = { m.keys[m.persons[i].name], (uint32_t)i | dumpPerson };
+            m.names.push_back(n);
+        }
+    }
+    this->parallel(threads, boost::bind(&DumpImport::sort, &m, _1));
+    vector< pair<const DumpName*, const DumpName*> > nruns;
+    for (int part = 0; part < threads; part++) {
+        const DumpName *names = m.names.empty() ? NULL : &m.names[0];
+        nruns.push_back(make_pair(names + m.first(m.names.size(), part), names + m.last(m.names.size(), part)));
+    }
+    DumpByKey byKey;
+    byKey.pool = &m.text;
+    dumpMerge(nruns, byKey, m.sorted);
+
+    // offsets
+    this->parallel(threads, boost::bind(&DumpImport::translate, &m, _1));
+
+    // sentinels
+    DumpMovie ms = { 0, 0, 0, (uint32_t)m.mrows.size() };
+    m.movies.push_back(ms);
+    DumpPerson ps = { 0, 0, 0, (uint32_t)m.prows.size() };
+    m.persons.push_back(ps);
+    info.merging = dumpNow() - start - info.parsing;
+
+    // write
+    if (! this->write(out, m.text, m.movies, m.persons, m.mrows, m.prows, m.sorted)) {
+        return false;
+    }
+
+    // stats
+    info.movies = m.movies.size() - 1;
+    info.persons = m.persons.size() - 1;
+    info.credits = m.mrows.size();
+    info.strings = nstrings;
+    info.seconds = dumpNow() - start;
+    return true;
+}
+
+/**
+ * Import statistics.
+ */
+const DumpStats& DumpImport::stats() const {
+    return info;
+}
+
+/**
+ * Import error.
+ */
+const string& DumpImport::error() const {
+    return err;
+}
+
+/**
+ * Maps a dump and parses it in one chunk per core, split at line ends.
+ */
+bool DumpImport::parse(const string &path, bool credits, vector<Chunk> &chunks) {
+    if (path.empty()) {
+        return true;
+    }
+
+    // map
+    int fd = ::open(path.c_str(), O_RDONLY);
+    struct stat st;
+    if (fd < 0 || fstat(fd, &st) != 0) {
+        if (fd >= 0) {
+            ::close(fd);
+        }
+        return this->fail("cannot open " + path);
+    }
+    size_t size = st.st_size;
+    if (size == 0) {
+        ::close(fd);
+        return true;
+    }
+    void *p = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (p == MAP_FAILED) {
+        return this->fail("cannot map " + path);
+    }
+    const char *data = static_cast<const char*>(p);
+    const char *end = data + size;
+
+    // chunks
+    chunks.resize(threads);
+    const char *begin = data;
+    for (int t = 0; t < threads; t++) {
+        const char *split = (t == threads - 1) ? end : data + size * (t + 1) / threads;
+        if (split < begin) {
+            split = begin;
+        }
+        while (split > data && split < end && *(split - 1) != '\n') {
+            split++;
+        }
+        chunks[t].begin = begin;
+        chunks[t].end = split;
+        chunks[t].lines = 0;
+        chunks[t].errors = 0;
+        begin = split;
+    }
+
+    // parse
+    boost::thread_group group;
+    for (int t = 0; t < threads; t++) {
+        group.create_thread(boost::bind(credits ? &DumpImport::credits : &DumpImport::entities, &chunks[t]));
+    }
+    group.join_all();
+    munmap(p, size);
+
+    // count
+    for (vector<Chunk>::const_iterator c = chunks.begin(); c != chunks.end(); ++c) {
+        info.lines += c->lines;
+        info.errors += c->errors;
+    }
+    return true;
+}
+
+/**
+ * Runs the tasks 0..n-1 on the import threads, round robin.
+ */
+void DumpImport::parallel(int n, const boost::function<void(int)> &task) {
+    int workers = min(n, threads);
+    if (workers <= 1) {
+        dumpTasks(task, 0, n, 1);
+        return;
+    }
+    boost::thread_group group;
+    for (int w = 0; w < workers; w++) {
+        group.create_thread(boost::bind(&dumpTasks, task, w, n, workers));
+    }
+    group.join_all();
+}
+
+/**
+ * Parses movie or person lines, adult entries are skipped.
+ */
+void DumpImport::entities(Chunk *chunk) {
+    const char *line = chunk->begin;
+    while (line < chunk->end) {
+        const char *eol = static_cast<const char*>(memchr(line, '\n', chunk->end - line));
+        if (! eol) {
+            eol = chunk->end;
+        }
+        if (eol > line + 1) {
+            chunk->lines++;
+            DumpLine l;
+            Json json(&l);
+            if (json.feed(line, eol - line) && json.finish() && l.id > 0) {
+                if (! l.adult) {
+                    Entity e;
+                    e.id = l.id;
+                    e.name = chunk->strings.intern(l.name);
+                    e.year = l.year;
+                    chunk->entities.push_back(e);
+                }
+            }
+            else {
+                chunk->errors++;
+            }
+        }
+        line = eol + 1;
+    }
+}
+
+/**
+ * Parses credit lines, one movie with its cast and crew per line. Strings
+ * are interned per chunk so the merge only sees the distinct ones.
+ */
+void DumpImport::credits(Chunk *chunk) {
+    CreditsIngest ingest(creditMovie);
+    const char *line = chunk->begin;
+    while (line < chunk->end) {
+        const char *eol = static_cast<const char*>(memchr(line, '\n', chunk->end - line));
+        if (! eol) {
+            eol = chunk->end;
+        }
+        if (eol > line + 1) {
+            chunk->lines++;
+            ingest.reset();
+            if (ingest.feed(line, eol - line) && ingest.finish() && ingest.source() > 0) {
+                chunk->rows.push_back(make_pair(ingest.source(), chunk->links.size()));
+                const vector<Credit> &credits = ingest.credits();
+                for (vector<Credit>::const_iterator c = credits.begin(); c != credits.end(); ++c) {
+                    bool job = (c->type == creditDirector || c->type == creditCrew);
+                    Link l = { c->id, (uint32_t)chunk->strings.intern(c->name), (uint32_t)chunk->strings.intern(c->type), (uint32_t)chunk->strings.intern(job ? c->job : c->character), c->order };
+                    chunk->links.push_back(l);
+                }
+            }
+            else {
+                chunk->errors++;
+            }
+        }
+        line = eol + 1;
+    }
+}
+
+/**
+ * Assigns the strings of a chunk to their hash shards, the empty string
+ * stays 0.
+ */
+void DumpImport::distribute(Merge *m, int c) {
+    Chunk *chunk = m->chunks[c];
+    boost::hash<string> hash;
+    chunk->shards.resize(m->shards.size());
+    chunk->remap.assign(chunk->strings.size(), 0);
+    for (size_t i = 1; i < chunk->strings.size(); i++) {
+        chunk->shards[hash(chunk->strings.get(i)) % m->shards.size()].push_back(i);
+    }
+}
+
+/**
+ * Interns the strings of a shard, chunk by chunk in order.
+ */
+void DumpImport::intern(Merge *m, int s) {
+    Strings &shard = m->shards[s];
+    for (size_t c = 0; c < m->chunks.size(); c++) {
+        Chunk *chunk = m->chunks[c];
+        const vector<uint32_t> &sids = chunk->shards[s];
+        for (size_t i = 0; i < sids.size(); i++) {
+            chunk->remap[sids[i]] = shard.intern(chunk->strings.get(sids[i]));
+        }
+    }
+}
+
+/**
+ * Resolves the strings of a chunk to pool ids and sorts its movies and
+ * persons into runs.
+ */
+void DumpImport::runs(Merge *m, int c) {
+    Chunk *chunk = m->chunks[c];
+    for (size_t s = 0; s < chunk->shards.size(); s++) {
+        const vector<uint32_t> &sids = chunk->shards[s];
+        for (size_t i = 0; i < sids.size(); i++) {
+            chunk->remap[sids[i]] += m->bases[s];
+        }
+    }
+    chunk->shards.clear();
+    chunk->strings.clear();
+
+    // entities
+    if ((size_t)c < m->credits) {
+        for (vector<Entity>::const_iterator e = chunk->entities.begin(); e != chunk->entities.end(); ++e) {
+            if ((size_t)c < m->people) {
+                DumpMovie dm = { e->id, chunk->remap[e->name], e->year, 0 };
+                chunk->mrun.push_back(dm);
+            }
+            else {
+                DumpPerson dp = { e->id, chunk->remap[e->name], 0, 0 };
+                chunk->prun.push_back(dp);
+            }
+        }
+        vector<Entity>().swap(chunk->entities);
+    }
+
+    // credits
+    else {
+        for (vector< pair<int,size_t> >::const_iterator r = chunk->rows.begin(); r != chunk->rows.end(); ++r) {
+            DumpMovie dm = { r->first, 0, 0, 0 };
+            chunk->mrun.push_back(dm);
+        }
+        for (vector<Link>::iterator l = chunk->links.begin(); l != chunk->links.end(); ++l) {
+            l->name = chunk->remap[l->name];
+            l->type = chunk->remap[l->type];
+            l->role = chunk->remap[l->role];
+            DumpPerson dp = { l->pid, l->name, 0, 0 };
+            chunk->prun.push_back(dp);
+        }
+    }
+    stable_sort(chunk->mrun.begin(), chunk->mrun.end(), DumpById());
+    stable_sort(chunk->prun.begin(), chunk->prun.end(), DumpById());
+    chunk->prun.erase(unique(chunk->prun.begin(), chunk->prun.end(), DumpSameId()), chunk->prun.end());
+}
+
+/**
+ * Resolves the movies and persons of a credits chunk and counts the rows,
+ * a person is typed by its highest ranking credit.
+ */
+void DumpImport::link(Merge *m, int c) {
+    Chunk *chunk = m->chunks[m->credits + c];
+    chunk->mindex.resize(chunk->rows.size());
+    chunk->pindex.resize(chunk->links.size());
+    for (size_t r = 0; r < chunk->rows.size(); r++) {
+        DumpMovie key = { chunk->rows[r].first, 0, 0, 0 };
+        uint32_t mi = lower_bound(m->movies.begin(), m->movies.end(), key, DumpById()) - m->movies.begin();
+        size_t end = (r + 1 < chunk->rows.size()) ? chunk->rows[r+1].second : chunk->links.size();
+        chunk->mindex[r] = mi;
+        __sync_fetch_and_add(&m->mcount[mi], (uint32_t)(end - chunk->rows[r].second));
+        for (size_t i = chunk->rows[r].second; i < end; i++) {
+            const Link &l = chunk->links[i];
+            DumpPerson key = { l.pid, 0, 0, 0 };
+            uint32_t pi = lower_bound(m->persons.begin(), m->persons.end(), key, DumpById()) - m->persons.begin();
+            chunk->pindex[i] = pi;
+            __sync_fetch_and_add(&m->pcount[pi], 1);
+            int rank = (l.type == m->director) ? 2 : ((l.type == m->actor) ? 1 : 0);
+            int current = m->pranks[pi];
+            while (rank > current) {
+                int seen = __sync_val_compare_and_swap(&m->pranks[pi], current, rank);
+                if (seen == current) {
+                    break;
+                }
+                current = seen;
+            }
+        }
+    }
+}
+
+/**
+ * Copies the credits of a chunk into both adjacencies.
+ */
+void DumpImport::fill(Merge *m, int c) {
+    Chunk *chunk = m->chunks[m->credits + c];
+    for (size_t r = 0; r < chunk->rows.size(); r++) {
+        uint32_t mi = chunk->mindex[r];
+        size_t end = (r + 1 < chunk->rows.size()) ? chunk->rows[r+1].second : chunk->links.size();
+        for (size_t i = chunk->rows[r].second; i < end; i++) {
+            const Link &l = chunk->links[i];
+            uint32_t pi = chunk->pindex[i];
+            DumpCredit dc = { pi, l.type, l.role, l.order };
+            m->mrows[chunk->starts[r] + i - chunk->rows[r].second] = dc;
+            dc.node = mi;
+            m->prows[m->persons[pi].first + __sync_fetch_and_add(&m->pfill[pi], 1)] = dc;
+        }
+    }
+}
+
+/**
+ * Sorts the person rows of a range latest first.
+ */
+void DumpImport::order(Merge *m, int part) {
+    DumpByYear byYear;
+    byYear.movies = &m->movies;
+    for (size_t p = m->first(m->persons.size(), part); p < m->last(m->persons.size(), part); p++) {
+        vector<DumpCredit>::iterator row = m->prows.begin() + m->persons[p].first;
+        std::sort(row, row + m->pcount[p], byYear);
+    }
+}
+
+/**
+ * Bytes of a pool part, the strings of a shard or the lowercased names of
+ * a range. Names without capitals are their own key.
+ */
+void DumpImport::measure(Merge *m, int part) {
+    int shards = m->shards.size();
+    size_t bytes = 0;
+    if (part < shards) {
+        const Strings &shard = m->shards[part];
+        for (size_t i = 0; i < shard.size(); i++) {
+            bytes += shard.get(i).size() + 1;
+        }
+    }
+    else {
+        size_t n = m->used.size();
+        for (size_t sid = m->first(n, part - shards); sid < m->last(n, part - shards); sid++) {
+            if (m->used[sid]) {
+                int s = upper_bound(m->bases.begin(), m->bases.end(), (uint32_t)sid) - m->bases.begin() - 1;
+                const string &name = m->shards[s].get(sid - m->bases[s]);
+                for (string::const_iterator ch = name.begin(); ch != name.end(); ++ch) {
+                    if (*ch >= 'A' && *ch <= 'Z') {
+                        m->used[sid] = 2;
+                        bytes += name.size() + 1;
+                        break;
+                    }
+                }
+            }
+        }
+    }
+    m->sizes[part + 1] = bytes;
+}
+
+/**
+ * Copies a pool part to its place.
+ */
+void DumpImport::pool(Merge *m, int part) {
+    int shards = m->shards.size();
+    size_t offset = m->sizes[part];
+    if (part < shards) {
+        const Strings &shard = m->shards[part];
+        for (size_t i = 0; i < shard.size(); i++) {
+            const string &s = shard.get(i);
+            uint32_t sid = m->bases[part] + i;
+            m->offsets[sid] = offset;
+            if (m->used[sid] != 2) {
+                m->keys[sid] = offset;
+            }
+            memcpy(&m->text[offset], s.c_str(), s.size() + 1);
+            offset += s.size() + 1;
+        }
+    }
+    else {
+        size_t n = m->used.size();
+        for (size_t sid = m->first(n, part - shards); sid < m->last(n, part - shards); sid++) {
+            if (m->used[sid] == 2) {
+                int s = upper_bound(m->bases.begin(), m->bases.end(), (uint32_t)sid) - m->bases.begin() - 1;
+                string name = dumpLower(m->shards[s].get(sid - m->bases[s]));
+                memcpy(&m->text[offset], name.c_str(), name.size() + 1);
+                m->keys[sid] = offset;
+                offset += name.size() + 1;
+            }
+        }
+    }
+}
+
+/**
+ * Sorts a range of the name index.
+ */
+void DumpImport::sort(Merge *m, int part) {
+    DumpByKey byKey;
+    byKey.pool = &m->text;
+    std::sort(m->names.begin() + m->first(m->names.size(), part), m->names.begin() + m->last(m->names.size(), part), byKey);
+}
+
+/**
+ * Turns the string ids of a range of nodes and rows into pool offsets.
+ */
+void DumpImport::translate(Merge *m, int part) {
+    for (size_t i = m->first(m->movies.size(), part); i < m->last(m->movies.size(), part); i++) {
+        m->movies[i].title = m->offsets[m->movies[i].title];
+    }
+    for (size_t i = m->first(m->persons.size(), part); i < m->last(m->persons.size(), part); i++) {
+        m->persons[i].name = m->offsets[m->persons[i].name];
+        m->persons[i].type = m->offsets[m->persons[i].type];
+    }
+    for (size_t i = m->first(m->mrows.size(), part); i < m->last(m->mrows.size(), part); i++) {
+        m->mrows[i].type = m->offsets[m->mrows[i].type];
+        m->mrows[i].role = m->offsets[m->mrows[i].role];
+        m->prows[i].type = m->offsets[m->prows[i].type];
+        m->prows[i].role = m->offsets[m->prows[i].role];
+    }
+}
+
+/**
+ * Writes the graph file.
+ */
+bool DumpImport::write(const string &out, const vector<char> &pool, const vector<DumpMovie> &movies, const vector<DumpPerson> &persons, const vector<DumpCredit> &mcredits, const vector<DumpCredit> &pcredits, const vector<DumpName> &names) {
+
+    // layout
+    DumpHeader h;
+    memset(&h, 0, sizeof(h));
+    h.magic = dumpMagic;
+    h.version = dumpVersion;
+    h.movies = movies.size() - 1;
+    h.persons = persons.size() - 1;
+    h.mcredits = mcredits.size();
+    h.pcredits = pcredits.size();
+    h.names = names.size();
+    h.strings = pool.size();
+    uint64_t offset = sizeof(DumpHeader);
+    h.ostrings = offset;
+    offset = (offset + pool.size() + 7) & ~7ULL;
+    h.omovies = offset;
+    offset += movies.size() * sizeof(DumpMovie);
+    h.opersons = offset;
+    offset += persons.size() * sizeof(DumpPerson);
+    h.omcredits = offset;
+    offset += mcredits.size() * sizeof(DumpCredit);
+    h.opcredits = offset;
+    offset += pcredits.size() * sizeof(DumpCredit);
+    h.onames = offset;
+
+    // write
+    FILE *f = fopen(out.c_str(), "wb");
+    if (! f) {
+        return this->fail("cannot write " + out);
+    }
+    static const char zero[8] = { 0 };
+    bool ok = fwrite(&h, sizeof(h), 1, f) == 1
+        && fwrite(&pool[0], 1, pool.size(), f) == pool.size()
+        && fwrite(zero, 1, h.omovies - h.ostrings - pool.size(), f) == h.omovies - h.ostrings - pool.size()
+        && fwrite(&movies[0], sizeof(DumpMovie), movies.size(), f) == movies.size()
+        && fwrite(&persons[0], sizeof(DumpPerson), persons.size(), f) == persons.size()
+        && (mcredits.empty() || fwrite(&mcredits[0], sizeof(DumpCredit), mcredits.size(), f) == mcredits.size())
+        && (pcredits.empty() || fwrite(&pcredits[0], sizeof(DumpCredit), pcredits.size(), f) == pcredits.size())
+        && (names.empty() || fwrite(&names[0], sizeof(DumpName), names.size(), f) == names.size());
+    if (fclose(f) != 0 || ! ok) {
+        return this->fail("cannot write " + out);
+    }
+    return true;
+}
+
+/**
+ * Keeps the error.
+ */
+bool DumpImport::fail(const string &msg) {
+    err = msg;
+    return false;
+}
+
+
+#pragma mark -
+#pragma mark Dump
+
+/**
+ * Creates a closed dump.
+ */
+Dump::Dump() {
+    data = NULL;
+    length = 0;
+    header = NULL;
+}
+
+/**
+ * Unmaps the file.
+ */
+Dump::~Dump() {
+    this->close();
+}
+
+/**
+ * Maps and validates a graph file.
+ */
+bool Dump::open(const string &path) {
+    this->close();
+
+    // map
+    int fd = ::open(path.c_str(), O_RDONLY);
+    struct stat st;
+    if (fd < 0 || fstat(fd, &st) != 0 || st.st_size < (off_t)sizeof(DumpHeader)) {
+        if (fd >= 0) {
+            ::close(fd);
+        }
+        return false;
+    }
+    length = st.st_size;
+    data = mmap(NULL, length, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (data == MAP_FAILED) {
+        data = NULL;
+        return false;
+    }
+
+    // validate
+    const char *base = static_cast<const char*>(data);
+    const DumpHeader *h = reinterpret_cast<const DumpHeader*>(base);
+    if (h->magic != dumpMagic || h->version != dumpVersion
+        || h->ostrings + h->strings > h->omovies
+        || h->onames + (uint64_t)h->names * sizeof(DumpName) > length) {
+        this->close();
+        return false;
+    }
+
+    // sections
+    header = h;
+    strings = base + h->ostrings;
+    movies = reinterpret_cast<const DumpMovie*>(base + h->omovies);
+    persons = reinterpret_cast<const DumpPerson*>(base + h->opersons);
+    mcredits = reinterpret_cast<const DumpCredit*>(base + h->omcredits);
+    pcredits = reinterpret_cast<const DumpCredit*>(base + h->opcredits);
+    names = reinterpret_cast<const DumpName*>(base + h->onames);
+    return true;
+}
+
+/**
+ * Unmaps the file.
+ */
+void Dump::close() {
+    if (data) {
+        munmap(data, length);
+    }
+    data = NULL;
+    length = 0;
+    header = NULL;
+}
+
+/**
+ * The node is in the dump.
+ */
+bool Dump::contains(const string &type, int id) const {
+    return (type == creditMovie) ? this->movie(id) != NULL : this->person(id) != NULL;
+}
+
+/**
+ * Credits of a movie in billing order or of a person latest first.
+ */
+int Dump::credits(const string &type, int id, vector<Credit> &credits) const {
+    credits.clear();
+    bool movie = (type == creditMovie);
+
+    // row
+    uint32_t first = 0;
+    uint32_t last = 0;
+    if (movie) {
+        const DumpMovie *m = this->movie(id);
+        if (m) {
+            first = m[0].first;
+            last = m[1].first;
+        }
+    }
+    else {
+        const DumpPerson *p = this->person(id);
+        if (p) {
+            first = p[0].first;
+            last = p[1].first;
+        }
+    }
+    credits.resize(last - first);
+
+    // credits
+    char year[16];
+    for (uint32_t i = first; i < last; i++) {
+        const DumpCredit &dc = movie ? mcredits[i] : pcredits[i];
+        Credit &c = credits[i - first];
+        c.type = this->text(dc.type);
+        if (c.type == creditActor) {
+            c.character = this->text(dc.role);
+        }
+        else {
+            c.job = this->text(dc.role);
+        }
+        c.order = dc.order;
+        if (movie) {
+            c.id = persons[dc.node].id;
+            c.name = this->text(persons[dc.node].name);
+        }
+        else {
+            c.id = movies[dc.node].id;
+            c.name = this->text(movies[dc.node].title);
+            if (movies[dc.node].year) {
+                snprintf(year, sizeof(year), "%d", movies[dc.node].year);
+                c.year = year;
+            }
+        }
+    }
+    return credits.size();
+}
+
+/**
+ * Movies and persons whose name starts with the prefix, ignoring case.
+ */
+int Dump::search(const string &prefix, int limit, vector<DumpResult> &results) const {
+    results.clear();
+    if (! header || prefix.empty()) {
+        return 0;
+    }
+
+    // first
+    string p = dumpLower(prefix);
+    const DumpName *lo = names;
+    const DumpName *hi = names + header->names;
+    while (lo < hi) {
+        const DumpName *mid = lo + (hi - lo) / 2;
+        if (strcmp(this->text(mid->key), p.c_str()) < 0) {
+            lo = mid + 1;
+        }
+        else {
+            hi = mid;
+        }
+    }
+
+    // matches
+    char year[16];
+    for (const DumpName *n = lo; n < names + header->names && (int)results.size() < limit; n++) {
+        if (strncmp(this->text(n->key), p.c_str(), p.size()) != 0) {
+            break;
+        }
+        results.push_back(DumpResult());
+        DumpResult &r = results.back();
+        if (n->node & dumpPerson) {
+            const DumpPerson &dp = persons[n->node & ~dumpPerson];
+            r.type = creditPerson;
+            r.id = dp.id;
+            r.name = this->text(dp.name);
+            r.meta = this->text(dp.type);
+        }
+        else {
+            const DumpMovie &dm = movies[n->node];
+            r.type = creditMovie;
+            r.id = dm.id;
+            r.name = this->text(dm.title);
+            if (dm.year) {
+                snprintf(year, sizeof(year), "%d", dm.year);
+                r.meta = year;
+            }
+        }
+    }
+    return results.size();
+}
+
+/**
+ * Title of a movie or name of a person.
+ */
+string Dump::name(const string &type, int id) const {
+    if (type == creditMovie) {
+        const DumpMovie *m = this->movie(id);
+        return m ? this->text(m->title) : "";
+    }
+    const DumpPerson *p = this->person(id);
+    return p ? this->text(p->name) : "";
+}
+
+/**
+ * Release year of a movie or type of a person, as in the search results.
+ */
+string Dump::meta(const string &type, int id) const {
+    if (type == creditMovie) {
+        const DumpMovie *m = this->movie(id);
+        if (! m || ! m->year) {
+            return "";
+        }
+        char year[16];
+        snprintf(year, sizeof(year), "%d", m->year);
+        return year;
+    }
+    const DumpPerson *p = this->person(id);
+    return p ? this->text(p->type) : "";
+}
+
+/**
+ * A file is mapped.
+ */
+bool Dump::opened() const {
+    return header != NULL;
+}
+
+/**
+ * Movie by id.
+ */
+const DumpMovie* Dump::movie(int id) const {
+    if (! header) {
+        return NULL;
+    }
+    DumpMovie key = { id, 0, 0, 0 };
+    const DumpMovie *m = lower_bound(movies, movies + header->movies, key, DumpById());
+    return (m != movies + header->movies && m->id == id) ? m : NULL;
+}
+
+/**
+ * Person by id.
+ */
+const DumpPerson* Dump::person(int id) const {
+    if (! header) {
+        return NULL;
+    }
+    DumpPerson key = { id, 0, 0, 0 };
+    const DumpPerson *p = lower_bound(persons, persons + header->persons, key, DumpById());
+    return (p != persons + header->persons && p->id == id) ? p : NULL;
+}
+
+/**
+ * Pooled string.
+ */
+const char* Dump::text(uint32_t offset) const {
+    return strings + offset;
+}
@@ -0,0 +1,270 @@
+//
+//  Dump.h
+//  Solyaris
+//
+//  Created by CNPP on 19.10.2026.
+//  Copyright 2026 Beat Raess. All rights reserved.
+//
+//  This file is part of Solyaris.
+//
+//  Solyaris is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  Solyaris is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with Solyaris.  If not, see www.gnu.org/licenses/.
+
+
+#pragma once
+#include "Credits.h"
+#include "Index.h"
+#include <boost/function.hpp>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+
+// namespace
+using namespace std;
+
+// constants
+const uint32_t dumpMagic = 0x534c5944;
+const uint32_t dumpVersion = 1;
+const uint32_t dumpPerson = 0x80000000;
+
+
+/**
+ * Dump Header.
+ * Start of the graph file, sections are 8 byte aligned.
+ */
+struct DumpHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t movies;
+    uint32_t persons;
+    uint32_t mcredits;
+    uint32_t pcredits;
+    uint32_t names;
+    uint32_t reserved;
+    uint64_t strings;
+    uint64_t ostrings;
+    uint64_t omovies;
+    uint64_t opersons;
+    uint64_t omcredits;
+    uint64_t opcredits;
+    uint64_t onames;
+};
+
+/**
+ * Dump Movie.
+ * Movies are sorted by id, first is the start of the credit row.
+ */
+struct DumpMovie {
+    int32_t id;
+    uint32_t title;
+    int32_t year;
+    uint32_t first;
+};
+
+/**
+ * Dump Person.
+ */
+struct DumpPerson {
+    int32_t id;
+    uint32_t name;
+    uint32_t type;
+    uint32_t first;
+};
+
+/**
+ * Dump Credit.
+ * Adjacency entry, node indexes the other side.
+ */
+struct DumpCredit {
+    uint32_t node;
+    uint32_t type;
+    uint32_t role;
+    int32_t order;
+};
+
+/**
+ * Dump Name.
+ * Lowercased name pointing at a movie or, flagged, a person.
+ */
+struct DumpName {
+    uint32_t key;
+    uint32_t node;
+};
+
+/**
+ * Dump Result.
+ */
+struct DumpResult {
+    string type;
+    int id;
+    string name;
+    string meta;
+};
+
+/**
+ * Dump Stats.
+ */
+struct DumpStats {
+    size_t lines;
+    size_t errors;
+    size_t movies;
+    size_t persons;
+    size_t credits;
+    size_t strings;
+    int threads;
+    double parsing;
+    double merging;
+    double seconds;
+};
+
+
+/**
+ * Dump Import.
+ * Reads JSON lines dumps of movies, people and per movie credits on all
+ * cores and writes the read-only graph file: a string pool, movies and
+ * persons sorted by id, both CSR adjacencies and a sorted name index.
+ * The merge runs on all cores as well: strings are interned in hash
+ * shards, every chunk is sorted on its own and the sorted runs are merged,
+ * rows are filled and ordered per chunk and per person range.
+ */
+class DumpImport {
+
+    // public
+    public:
+
+    // DumpImport
+    DumpImport(int t = 0);
+
+    // Business
+    bool run(const string &movies, const string &people, const string &credits, const string &out);
+
+    // Accessors
+    const DumpStats& stats() const;
+    const string& error() const;
+
+
+    // private
+    private:
+
+    // Entity
+    struct Entity {
+        int id;
+        uint32_t name;
+        int year;
+    };
+
+    // Link
+    struct Link {
+        int32_t pid;
+        uint32_t name;
+        uint32_t type;
+        uint32_t role;
+        int32_t order;
+    };
+
+    // Chunk
+    struct Chunk {
+        const char *begin;
+        const char *end;
+        vector<Entity> entities;
+        Strings strings;
+        vector<Link> links;
+        vector< pair<int,size_t> > rows;
+        size_t lines;
+        size_t errors;
+        vector< vector<uint32_t> > shards;
+        vector<uint32_t> remap;
+        vector<DumpMovie> mrun;
+        vector<DumpPerson> prun;
+        vector<uint32_t> mindex;
+        vector<uint32_t> pindex;
+        vector<uint32_t> starts;
+    };
+
+    // Merge
+    struct Merge;
+
+    // Helpers
+    bool parse(const string &path, bool credits, vector<Chunk> &chunks);
+    void parallel(int n, const boost::function<void(int)> &task);
+    static void entities(Chunk *chunk);
+    static void credits(Chunk *chunk);
+    static void distribute(Merge *m, int c);
+    static void intern(Merge *m, int s);
+    static void runs(Merge *m, int c);
+    static void link(Merge *m, int c);
+    static void fill(Merge *m, int c);
+    static void order(Merge *m, int part);
+    static void measure(Merge *m, int part);
+    static void pool(Merge *m, int part);
+    static void sort(Merge *m, int part);
+    static void translate(Merge *m, int part);
+    bool write(const string &out, const vector<char> &pool, const vector<DumpMovie> &movies, const vector<DumpPerson> &persons, const vector<DumpCredit> &mcredits, const vector<DumpCredit> &pcredits, const vector<DumpName> &names);
+    bool fail(const string &msg);
+
+    // State
+    DumpStats info;
+    string err;
+    int threads;
+
+};
+
+
+/**
+ * Dump.
+ * Read-only view of a memory-mapped graph file, lookups are binary searches
+ * and rows are read in place.
+ */
+class Dump {
+
+    // public
+    public:
+
+    // Dump
+    Dump();
+    ~Dump();
+
+    // Business
+    bool open(const string &path);
+    void close();
+    bool contains(const string &type, int id) const;
+    int credits(const string &type, int id, vector<Credit> &credits) const;
+    int search(const string &prefix, int limit, vector<DumpResult> &results) const;
+
+    // Accessors
+    string name(const string &type, int id) const;
+    string meta(const string &type, int id) const;
+    bool opened() const;
+
+
+    // private
+    private:
+
+    // Helpers
+    const DumpMovie* movie(int id) const;
+    const DumpPerson* person(int id) const;
+    const char* text(uint32_t offset) const;
+
+    // Mapping
+    void *data;
+    size_t length;
+    const DumpHeader *header;
+    const char *strings;
+    const DumpMovie *movies;
+    const DumpPerson *persons;
+    const DumpCredit *mcredits;
+    const DumpCredit *pcredits;
+    const DumpName *names;
+
+};
@@ -31,15 +31,10 @@
  */
 Edge::Edge() {
 }
-Edge::Edge(string ide, NodePtr n1, NodePtr n2) {
+Edge::Edge(const string &ide, const NodePtr &n1, const NodePtr &n2) {
     
     // fields
     eid = ide;
-    length = 480;
-    stiffness = 0.6;
-    damping = 0.9;
-    redux = false;
-    dpr = 1.0;
     
     // nodes
     wnode1 = NodeWeakPtr(n1);
@@ -49,26 +44,18 @@ Edge::Edge(string ide, NodePtr n1, NodePtr n2) {
     active = false;
     visible = false;
     selected = false;
+    relabel = true;
+    hot = false;
     
     // position
     pos.set(0,0);
     
-    // color
-    cstroke = Color(0.90,0.90,0.90);
-    cstrokea = Color(0.90,0.90,0.90);
-    cstrokes = Color(0.81,0.81,0.81);
-    
-    ctxt = Color(0.5,0.5,0.5);
-    ctxta = Color(0.5,0.5,0.5);
-    ctxts = Color(0.15,0.15,0.15);
-    
     // label
     label = "";
     
-    // font
-    font = Font("Helvetica",13);
-    loff.set(0,-13);
-    textureLabel = gl::Texture(1,1);
+    // style
+    style = styleEdgeDefault;
+    loff = 0;
 }
 
 
@@ -77,7 +64,7 @@ Edge::Edge(string ide, NodePtr n1, NodePtr n2) {
  */
 EdgeMovie::EdgeMovie(): Edge::Edge()  {    
 }
-EdgeMovie::EdgeMovie(string ide, NodePtr n1, NodePtr n2): Edge::Edge(ide,n1,n2) {
+EdgeMovie::EdgeMovie(const string &ide, const NodePtr &n1, const NodePtr &n2): Edge::Edge(ide,n1,n2) {
     
     // type
     type = edgeMovie;
@@ -89,7 +76,7 @@ EdgeMovie::EdgeMovie(string ide, NodePtr n1, NodePtr n2): Edge::Edge(ide,n1,n2)
  */
 EdgePerson::EdgePerson(): Edge::Edge()  {    
 }
-EdgePerson::EdgePerson(string ide, NodePtr n1, NodePtr n2): Edge::Edge(ide,n1,n2) {
+EdgePerson::EdgePerson(const string &ide, const NodePtr &n1, const NodePtr &n2): Edge::Edge(ide,n1,n2) {
     
     // type
     type = edgePerson;
@@ -98,50 +85,6 @@ EdgePerson::EdgePerson(string ide, NodePtr n1, NodePtr n2): Edge::Edge(ide,n1,n2
 
 
 
-#pragma mark -
-#pragma mark Cinder
-
-/**
- * Applies the configuration.
- */
-void Edge::config(Configuration c) {
-    
-    // device redux
-    redux = false;
-    Config confDeviceRedux = c.getConfiguration(cDeviceRedux);
-    if (confDeviceRedux.isSet()) {
-        redux = confDeviceRedux.boolVal();
-    }
-    
-    // resolution
-    Config confDisplayResolution = c.getConfiguration(cDisplayResolution);
-    dpr = confDisplayResolution.floatVal();
-    
-    // off
-    loff *= dpr;
-    
-    // font
-    font = Font("Helvetica",redux ? (12 * dpr) : (13 * dpr));
-}
-
-/**
- * Applies the settings.
- */
-void Edge::defaults(Defaults d) {
-    
-    // length
-    length = redux ? 300 : 480;
-    Default graphEdgeLength = d.getDefault(dGraphEdgeLength);
-    if (graphEdgeLength.isSet()) {
-        length = graphEdgeLength.doubleVal();
-    }
-    
-    // retina
-    length *= dpr;
-}
-
-
-
 #pragma mark -
 #pragma mark Sketch
 
@@ -163,7 +106,7 @@ void Edge::update() {
         }
         
         // position
-        pos = node1->pos + ((node2->pos - node1->pos) / 2.0);
+        pos = node1->body->pos + ((node2->body->pos - node1->body->pos) / 2.0);
     }
     
 }
@@ -181,22 +124,30 @@ void Edge::draw() {
         // unblend
         gl::enableAlphaBlending(true);
         
+        // style
+        const EdgeStyle &es = Style::edge(style);
+        
         // color
-        active ? gl::color(cstrokea) : gl::color(cstroke);
-        if (selected) {gl::color(cstrokes);}
+        active ? gl::color(es.cstrokea) : gl::color(es.cstroke);
+        if (selected) {gl::color(es.cstrokes);}
         
         // line
-        glLineWidth(dpr);
-        gl::drawLine(node1->pos, node2->pos);
+        glLineWidth(Params::edge().dpr);
+        gl::drawLine(node1->body->pos, node2->body->pos);
         
         // label
         if (active || selected) {
             
+            // deferred
+            if (relabel) {
+                this->renderLabel(label);
+            }
+            
             // color
-            selected ? gl::color(ctxts) : (active ? gl::color(ctxta) : gl::color(ctxt));
+            selected ? gl::color(es.ctxts) : (active ? gl::color(es.ctxta) : gl::color(es.ctxt));
             
             // angle 
-            float ar = cinder::math<float>::atan2(node2->pos.x - node1->pos.x, node2->pos.y - node1->pos.y);
+            float ar = cinder::math<float>::atan2(node2->body->pos.x - node1->body->pos.x, node2->body->pos.y - node1->body->pos.y);
             float ad = cinder::toDegrees(-ar);
             ad += (ad < 0) ? 90 : 270;
             
@@ -206,7 +157,7 @@ void Edge::draw() {
             gl::rotate(Vec3f(0, 0,ad));
             
             // draw
-            gl::draw( textureLabel, loff);
+            gl::draw( textureLabel, Vec2d(loff, es.loff.y));
             
             // and pop it goes
             gl::popMatrices();
@@ -231,27 +182,21 @@ void Edge::repulse() {
     // nodes
     NodePtr node1 = wnode1.lock();
     NodePtr node2 = wnode2.lock();
-    if (node1 && node2) {
+    if (node1 && node2 && (node1->body->due || node2->body->due)) {
         
-        // distance vector
-        Vec2d diff = node2->pos - node1->pos;
-      
-        // normalize / length
-        diff.safeNormalize();
-        diff *= length;
-        
-        // target
-        Vec2d target = node1->pos + diff;
+        // parameters
+        const EdgeParams &params = Params::edge();
         
         // force
-        Vec2d force = target - node2->pos;
-        force *= 0.5;
-        force *= stiffness;
-        force *= (1 - damping);
+        Vec2s force = Kernel::tension(node1->body->pos, node2->body->pos, (Scalar)params.length, (Scalar)params.stiffness, (Scalar)params.damping);
         
-        // update velocity
-        node1->velocity -= force;
-        node2->velocity += force;
+        // update force (nodes off their level of detail skip it)
+        if (node1->body->due) {
+            node1->body->force -= force;
+        }
+        if (node2->body->due) {
+            node2->body->force += force;
+        }
     }
 
 }
@@ -275,7 +220,7 @@ void Edge::show() {
             || (node2->isActive() && node1->isLoading())) {
             
             // label
-            font = Font("Helvetica-Bold",redux ? (12 * dpr) : (13 * dpr));
+            style = styleEdgeActive;
             this->renderLabel(label);
             
             // state
@@ -293,6 +238,10 @@ void Edge::hide() {
     // state
     visible = false;
     
+    // label (rendered again when shown)
+    textureLabel = gl::Texture();
+    relabel = true;
+    
 }
 
 /**
@@ -319,6 +268,11 @@ bool Edge::isVisible() {
     NodePtr node2 = wnode2.lock();
     if (node1 && node2) {
         
+        // clustered
+        if (node1->isClustered() || node2->isClustered()) {
+            return false;
+        }
+        
         // visible?
         v = active
         || (visible && ( (node1->isVisible() && ! node2->isLoading()) && (node2->isVisible() && ! node1->isLoading())) ) 
@@ -327,7 +281,7 @@ bool Edge::isVisible() {
     }
     return v;
 }
-bool Edge::isTouched(NodePtr n) {
+bool Edge::isTouched(const NodePtr &n) {
     bool touched = false;
     
     // nodes
@@ -345,9 +299,10 @@ bool Edge::isTouched(NodePtr n) {
 
 /**
  * Info.
+ * Built on the frame arena, only valid until the next frame.
  */
-string Edge::info(I18N translations) {
-    string nfo = "";
+ArenaString Edge::info(const I18N &translations) {
+    ArenaString nfo;
     
     // nodes
     NodePtr node1 = wnode1.lock();
@@ -355,26 +310,22 @@ string Edge::info(I18N translations) {
     if (node1 && node2) {
         
         // person / movie
-        string person = node1->label;
-        string movie = node2->label;
-        if (node1->type == nodeMovie) {
-            person = node2->label;
-            movie = node1->label;
-        }
+        bool movie1 = node1->type == nodeMovie;
+        const string &person = movie1 ? node2->info->label : node1->info->label;
+        const string &movie = movie1 ? node1->info->label : node2->info->label;
         
-        // movie
-        if (this->type == edgeMovie) {
-            nfo = person + translations.getTranslation(i18nTooltipActor1," is ") + this->label + translations.getTranslation(i18nTooltipActor2," in ") + movie;
-        }
-        
-        // actor
-        else if (this->type == edgePersonActor) {
-            nfo = person + translations.getTranslation(i18nTooltipActor1," is ") + this->label + translations.getTranslation(i18nTooltipActor2," in ") + movie;
+        // actor / movie
+        if (this->type == edgeMovie || this->type == edgePersonActor) {
+            nfo.append(person.c_str()).append(translations.getTranslation(i18nTooltipActor1," is ").c_str());
+            nfo.append(this->label.c_str()).append(translations.getTranslation(i18nTooltipActor2," in ").c_str());
+            nfo.append(movie.c_str());
         }
         
         // director / crew
         else if (this->type == edgePersonDirector || this->type == edgePersonCrew) {
-            nfo = person + translations.getTranslation(i18nTooltipCrew1," is the ") + this->label + translations.getTranslation(i18nTooltipCrew2," of ") + movie;
+            nfo.append(person.c_str()).append(translations.getTranslation(i18nTooltipCrew1," is the ").c_str());
+            nfo.append(this->label.c_str()).append(translations.getTranslation(i18nTooltipCrew2," of ").c_str());
+            nfo.append(movie.c_str());
         }
     }
     return nfo;
@@ -385,31 +336,41 @@ string Edge::info(I18N translations) {
 /**
  * Renders the label.
  */
-void Edge::renderLabel(string lbl) {
+void Edge::renderLabel(const string &lbl) {
     GLog();
     
     // field
     label = (lbl == "") ? " " : lbl;
+    relabel = false;
     
     // text
+    const EdgeStyle &es = Style::edge(style);
     TextLayout tlLabel;
 	tlLabel.clear(ColorA(0, 0, 0, 0));
-	tlLabel.setFont(font);
-	tlLabel.setColor(ctxt);
+	tlLabel.setFont(es.font);
+	tlLabel.setColor(es.ctxt);
 	tlLabel.addCenteredLine(label);
 	Surface8u rendered = tlLabel.render(true, true);
 	textureLabel = gl::Texture(rendered);
 
     
     // offset
-    loff.x = - textureLabel.getWidth() / 2.0;
+    loff = - textureLabel.getWidth() / 2.0;
     
 }
 
+/**
+ * Sets the label, it is rendered when first drawn.
+ */
+void Edge::deferLabel(const string &lbl) {
+    label = (lbl == "") ? " " : lbl;
+    relabel = true;
+}
+
 /**
  * Updates the type.
  */
-void Edge::updateType(string t) {
+void Edge::updateType(const string &t) {
     
     // type
     type = t;
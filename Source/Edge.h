@@ -65,11 +65,7 @@ class Edge {
     
     // Edge
     Edge();
-    Edge(string ide, NodePtr n1, NodePtr n2); 
-    
-    // Cinder
-    void config(Configuration c);
-    void defaults(Defaults s);
+    Edge(const string &ide, const NodePtr &n1, const NodePtr &n2); 
     
     // Sketch
     void update();
@@ -79,12 +75,13 @@ class Edge {
     void repulse();
     void hide();
     void show();
-    void renderLabel(string lbl);
-    void updateType(string t);
+    void renderLabel(const string &lbl);
+    void deferLabel(const string &lbl);
+    void updateType(const string &t);
     bool isActive();
     bool isVisible();
-    bool isTouched(NodePtr n);
-    string info(I18N translations);
+    bool isTouched(const NodePtr &n);
+    ArenaString info(const I18N &translations);
     
     
     // Public Fields
@@ -93,6 +90,7 @@ class Edge {
     NodeWeakPtr wnode2;
     string label;
     string type;
+    bool hot;
     
     
     // private
@@ -102,30 +100,14 @@ class Edge {
     bool active;
     bool visible;
     bool selected;
-    
-    // parameters
-    double length;
-    double stiffness;
-    double damping;
-    
-    // config
-    bool redux;
-    float dpr;
+    bool relabel;
     
     // position
-    Vec2d pos;
-    
-    // color
-    Color cstroke;
-    Color cstrokea;
-    Color cstrokes;
-    Color ctxt;
-    Color ctxta;
-    Color ctxts;
+    Vec2s pos;
     
-    // Font
-    Font font;
-    Vec2d loff;
+    // style
+    int style;
+    float loff;
     gl::Texture	textureLabel;
 
 };
@@ -137,7 +119,7 @@ class EdgeMovie: public Edge {
     
     // Node
     EdgeMovie();
-    EdgeMovie(string ide, NodePtr n1, NodePtr n2);
+    EdgeMovie(const string &ide, const NodePtr &n1, const NodePtr &n2);
 };
 class EdgePerson: public Edge {
     
@@ -146,5 +128,5 @@ class EdgePerson: public Edge {
     
     // Node
     EdgePerson();
-    EdgePerson(string ide, NodePtr n1, NodePtr n2);
+    EdgePerson(const string &ide, const NodePtr &n1, const NodePtr &n2);
 };
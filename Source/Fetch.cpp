@@ -0,0 +1,728 @@
+//
+//  Fetch.cpp
+//  Solyaris
+//
+//  Created by CNPP on 19.10.2026.
+//  Copyright 2026 Beat Raess. All rights reserved.
+//
+//  This file is part of Solyaris.
+//
+//  Solyaris is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  Solyaris is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with Solyaris.  If not, see www.gnu.org/licenses/.
+
+
+#include "Fetch.h"
+#include <boost/bind.hpp>
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <netdb.h>
+#include <unistd.h>
+#include <cstring>
+#include <algorithm>
+#include <cstdlib>
+#include <cstdio>
+
+
+// helpers
+static boost::posix_time::time_duration fetchSeconds(double s) {
+    return boost::posix_time::microseconds((int64_t)(s * 1000000));
+}
+
+
+#pragma mark -
+#pragma mark FetchHTTP
+
+/**
+ * Sends a GET request and reads the response until the server closes.
+ */
+bool FetchHTTP::send(const string &url, double timeout, FetchResponse &response) {
+    response.status = 0;
+    response.retry = 0;
+    response.body.clear();
+    response.error.clear();
+
+    // url
+    if (url.compare(0, 7, "http://") != 0) {
+        response.error = "unsupported url";
+        return false;
+    }
+    size_t slash = url.find('/', 7);
+    string authority = url.substr(7, (slash == string::npos) ? string::npos : slash - 7);
+    string path = (slash == string::npos) ? "/" : url.substr(slash);
+    string host = authority;
+    string port = "80";
+    size_t colon = authority.find(':');
+    if (colon != string::npos) {
+        host = authority.substr(0, colon);
+        port = authority.substr(colon + 1);
+    }
+
+    // resolve
+    struct addrinfo hints;
+    memset(&hints, 0, sizeof(hints));
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    struct addrinfo *addrs = NULL;
+    if (getaddrinfo(host.c_str(), port.c_str(), &hints, &addrs) != 0) {
+        response.error = "unknown host";
+        return false;
+    }
+
+    // connect
+    int fd = -1;
+    for (struct addrinfo *a = addrs; a && fd < 0; a = a->ai_next) {
+        fd = socket(a->ai_family, a->ai_socktype, a->ai_protocol);
+        if (fd < 0) {
+            continue;
+        }
+        struct timeval tv;
+        tv.tv_sec = (long)timeout;
+        tv.tv_usec = (long)((timeout - tv.tv_sec) * 1000000);
+        setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+        setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &tv, sizeof(tv));
+        #ifdef SO_NOSIGPIPE
+        int on = 1;
+        setsockopt(fd, SOL_SOCKET, SO_NOSIGPIPE, &on, sizeof(on));
+        #endif
+        if (connect(fd, a->ai_addr, a->ai_addrlen) != 0) {
+            ::close(fd);
+            fd = -1;
+        }
+    }
+    freeaddrinfo(addrs);
+    if (fd < 0) {
+        response.error = "connection failed";
+        return false;
+    }
+
+    // request
+    #ifdef MSG_NOSIGNAL
+    int flags = MSG_NOSIGNAL;
+    #else
+    int flags = 0;
+    #endif
+    string request = "GET " + path + " HTTP/1.0\r\nHost: " + authority + "\r\nAccept: application/json\r\nConnection: close\r\n\r\n";
+    size_t sent = 0;
+    while (sent < request.size()) {
+        ssize_t n = ::send(fd, request.data() + sent, request.size() - sent, flags);
+        if (n <= 0) {
+            ::close(fd);
+            response.error = "send failed";
+            return false;
+        }
+        sent += n;
+    }
+
+    // response
+    string raw;
+    char buffer[16384];
+    ssize_t n;
+    while ((n = recv(fd, buffer, sizeof(buffer), 0)) > 0) {
+        raw.append(buffer, n);
+    }
+    ::close(fd);
+    if (n < 0) {
+        response.error = "receive failed";
+        return false;
+    }
+
+    // status
+    size_t head = raw.find("\r\n\r\n");
+    if (head == string::npos || sscanf(raw.c_str(), "HTTP/%*d.%*d %d", &response.status) != 1) {
+        response.status = 0;
+        response.error = "invalid response";
+        return false;
+    }
+
+    // retry after, in seconds
+    string headers = raw.substr(0, head);
+    for (string::iterator c = headers.begin(); c != headers.end(); ++c) {
+        if (*c >= 'A' && *c <= 'Z') {
+            *c += 'a' - 'A';
+        }
+    }
+    size_t retry = headers.find("\r\nretry-after:");
+    if (retry != string::npos) {
+        response.retry = atof(headers.c_str() + retry + 14);
+    }
+
+    // body
+    response.body = raw.substr(head + 4);
+    return true;
+}
+
+
+#pragma mark -
+#pragma mark FetchBucket
+
+/**
+ * Creates a full bucket.
+ */
+FetchBucket::FetchBucket(double r, double b) {
+    rate = max(r, 0.01);
+    burst = max(b, 1.0);
+    tokens = burst;
+    stamp = boost::get_system_time();
+}
+
+/**
+ * Takes a token, or tells how many seconds until one is available.
+ */
+double FetchBucket::take() {
+    this->refill();
+    if (tokens >= 1) {
+        tokens -= 1;
+        return 0;
+    }
+    return (1 - tokens) / rate;
+}
+
+/**
+ * Seconds until the bucket holds the given level.
+ */
+double FetchBucket::until(double level) {
+    this->refill();
+    return max(0.0, (level - tokens) / rate);
+}
+
+/**
+ * Empties the bucket for the given time, all takers wait.
+ */
+void FetchBucket::drain(double seconds) {
+    this->refill();
+    tokens = min(tokens, 0.0) - seconds * rate;
+}
+
+/**
+ * Changes rate and burst.
+ */
+void FetchBucket::configure(double r, double b) {
+    this->refill();
+    rate = max(r, 0.01);
+    burst = max(b, 1.0);
+    tokens = min(tokens, burst);
+}
+
+/**
+ * Adds the tokens accrued since the last call.
+ */
+void FetchBucket::refill() {
+    boost::system_time now = boost::get_system_time();
+    tokens = min(burst, tokens + (now - stamp).total_microseconds() / 1000000.0 * rate);
+    stamp = now;
+}
+
+
+#pragma mark -
+#pragma mark Object
+
+/**
+ * Creates a scheduler on the transport.
+ */
+Fetch::Fetch(FetchTransport *t) : bucket(fetchRate, fetchBurst) {
+    transport = t;
+    responses = NULL;
+    memset(&info, 0, sizeof(info));
+    running = false;
+}
+
+/**
+ * Stops the workers.
+ */
+Fetch::~Fetch() {
+    this->stop();
+}
+
+
+#pragma mark -
+#pragma mark Business
+
+/**
+ * Starts the workers, requests queue up until then.
+ */
+void Fetch::start(int n) {
+    boost::mutex::scoped_lock lock(mutex);
+    if (running) {
+        return;
+    }
+    running = true;
+    for (int w = 0; w < max(1, n); w++) {
+        workers.create_thread(boost::bind(&Fetch::worker, this));
+    }
+}
+
+/**
+ * Stops the workers after their current request, cancels the rest.
+ */
+void Fetch::stop() {
+    {
+        boost::mutex::scoped_lock lock(mutex);
+        running = false;
+        signal.notify_all();
+    }
+    workers.join_all();
+    this->cancel();
+}
+
+/**
+ * Requests a url. Fresh cached responses are answered at once, stale ones
+ * too but are refreshed; a url already pending is joined.
+ */
+void Fetch::request(const FetchRequest &r, const FetchCallback &callback) {
+    FetchCallback cb = callback;
+
+    // cached
+    if (responses) {
+        FetchResult cached;
+        CacheState state = responses->get(r.url, cached.body);
+        if (state != cacheMiss) {
+            {
+                boost::mutex::scoped_lock lock(mutex);
+                info.cached++;
+            }
+            cached.url = r.url;
+            cached.status = fetchOk;
+            cached.code = 200;
+            cached.attempts = 0;
+            cached.cached = true;
+            if (cb) {
+                cb(cached);
+            }
+            if (state == cacheFresh) {
+                return;
+            }
+            cb = FetchCallback();
+        }
+    }
+
+    // coalesce
+    boost::mutex::scoped_lock lock(mutex);
+    info.requests++;
+    std::map<string,Job>::iterator j = jobs.find(r.url);
+    if (j != jobs.end()) {
+        info.coalesced++;
+        j->second.cancelled = false;
+        if (j->second.background) {
+            j->second.background = false;
+            deque<string>::iterator b = find(background.begin(), background.end(), r.url);
+            if (b != background.end()) {
+                background.erase(b);
+                ready.push_back(r.url);
+                signal.notify_one();
+            }
+        }
+        if (cb) {
+            j->second.callbacks.push_back(cb);
+        }
+        return;
+    }
+
+    // queue
+    Job &job = jobs[r.url];
+    job.request = r;
+    job.attempts = 0;
+    job.active = false;
+    job.cancelled = false;
+    job.background = false;
+    if (cb) {
+        job.callbacks.push_back(cb);
+    }
+    ready.push_back(r.url);
+    signal.notify_one();
+}
+
+/**
+ * Requests a url at low priority, from tokens above the reserve. Cached
+ * urls are answered at once, pending ones are joined.
+ */
+void Fetch::prefetch(const FetchRequest &r, const FetchCallback &callback) {
+
+    // cached
+    if (responses) {
+        FetchResult cached;
+        if (responses->get(r.url, cached.body) != cacheMiss) {
+            {
+                boost::mutex::scoped_lock lock(mutex);
+                info.cached++;
+            }
+            cached.url = r.url;
+            cached.status = fetchOk;
+            cached.code = 200;
+            cached.attempts = 0;
+            cached.cached = true;
+            if (callback) {
+                callback(cached);
+            }
+            return;
+        }
+    }
+
+    // pending
+    boost::mutex::scoped_lock lock(mutex);
+    info.prefetches++;
+    std::map<string,Job>::iterator j = jobs.find(r.url);
+    if (j != jobs.end()) {
+        j->second.cancelled = false;
+        if (callback) {
+            j->second.callbacks.push_back(callback);
+        }
+        return;
+    }
+
+    // queue
+    Job &job = jobs[r.url];
+    job.request = r;
+    job.attempts = 0;
+    job.active = false;
+    job.cancelled = false;
+    job.background = true;
+    if (callback) {
+        job.callbacks.push_back(callback);
+    }
+    background.push_back(r.url);
+    signal.notify_one();
+}
+
+/**
+ * Requests all urls in parallel, the callback gets the results in order
+ * once the last one is in.
+ */
+void Fetch::group(const vector<FetchRequest> &rs, const FetchGroupCallback &callback) {
+
+    // nothing
+    if (rs.empty()) {
+        if (callback) {
+            callback(vector<FetchResult>());
+        }
+        return;
+    }
+
+    // fan out
+    boost::shared_ptr<Group> g(new Group());
+    g->results.resize(rs.size());
+    g->remaining = rs.size();
+    g->callback = callback;
+    for (size_t i = 0; i < rs.size(); i++) {
+        this->request(rs[i], boost::bind(&Fetch::joined, this, g, i, _1));
+    }
+}
+
+/**
+ * Drops all pending requests, their callbacks are told so. Requests in
+ * flight are finished but ignored.
+ */
+void Fetch::cancel() {
+    this->discard(false);
+}
+
+/**
+ * Drops the request of a url with all its callbacks, they are told so. A
+ * request in flight is finished but ignored.
+ */
+void Fetch::cancel(const string &url) {
+
+    // pending
+    vector<FetchCallback> callbacks;
+    FetchResult result;
+    {
+        boost::mutex::scoped_lock lock(mutex);
+        std::map<string,Job>::iterator j = jobs.find(url);
+        if (j == jobs.end()) {
+            return;
+        }
+        callbacks.swap(j->second.callbacks);
+        result = Fetch::result(j->second, fetchCancelled);
+        deque<string>::iterator q = find(ready.begin(), ready.end(), url);
+        if (q != ready.end()) {
+            ready.erase(q);
+        }
+        q = find(background.begin(), background.end(), url);
+        if (q != background.end()) {
+            background.erase(q);
+        }
+        for (multimap<boost::system_time,string>::iterator d = delayed.begin(); d != delayed.end();) {
+            if (d->second == url) {
+                delayed.erase(d++);
+            }
+            else {
+                ++d;
+            }
+        }
+        if (j->second.active) {
+            j->second.cancelled = true;
+        }
+        else {
+            jobs.erase(j);
+        }
+    }
+
+    // notify
+    for (vector<FetchCallback>::iterator c = callbacks.begin(); c != callbacks.end(); ++c) {
+        (*c)(result);
+    }
+}
+
+/**
+ * Drops the prefetches no request has joined.
+ */
+void Fetch::cancelPrefetch() {
+    this->discard(true);
+}
+
+
+#pragma mark -
+#pragma mark Settings
+
+/**
+ * Sets the quota in requests per second and the burst allowed.
+ */
+void Fetch::rate(double rps, double burst) {
+    boost::mutex::scoped_lock lock(mutex);
+    bucket.configure(rps, burst);
+}
+
+/**
+ * Serves and stores responses in the cache.
+ */
+void Fetch::cache(Cache *c) {
+    boost::mutex::scoped_lock lock(mutex);
+    responses = c;
+}
+
+
+#pragma mark -
+#pragma mark Accessors
+
+/**
+ * Counters since creation.
+ */
+FetchStats Fetch::stats() {
+    boost::mutex::scoped_lock lock(mutex);
+    return info;
+}
+
+
+#pragma mark -
+#pragma mark Helpers
+
+/**
+ * Sends ready requests as tokens allow until stopped.
+ */
+void Fetch::worker() {
+    boost::mutex::scoped_lock lock(mutex);
+    while (running) {
+        boost::system_time now = boost::get_system_time();
+
+        // due retries
+        while (! delayed.empty() && delayed.begin()->first <= now) {
+            std::map<string,Job>::iterator d = jobs.find(delayed.begin()->second);
+            if (d != jobs.end()) {
+                (d->second.background ? background : ready).push_back(d->first);
+            }
+            delayed.erase(delayed.begin());
+        }
+
+        // queue, prefetches keep the reserve for requests
+        deque<string> *queue = NULL;
+        double reserve = background.empty() ? 0 : bucket.until(fetchReserve + 1);
+        if (! ready.empty()) {
+            queue = &ready;
+        }
+        else if (! background.empty() && reserve <= 0) {
+            queue = &background;
+        }
+
+        // idle
+        if (! queue) {
+            boost::system_time wake(boost::posix_time::pos_infin);
+            if (! delayed.empty()) {
+                wake = delayed.begin()->first;
+            }
+            if (! background.empty()) {
+                wake = min(wake, now + fetchSeconds(reserve));
+            }
+            if (wake.is_pos_infinity()) {
+                signal.wait(lock);
+            }
+            else {
+                signal.timed_wait(lock, wake);
+            }
+            continue;
+        }
+
+        // pace
+        double wait = bucket.take();
+        if (wait > 0) {
+            info.throttled++;
+            signal.timed_wait(lock, now + fetchSeconds(wait));
+            continue;
+        }
+
+        // next
+        string url = queue->front();
+        queue->pop_front();
+        std::map<string,Job>::iterator j = jobs.find(url);
+        if (j == jobs.end()) {
+            continue;
+        }
+        j->second.active = true;
+        j->second.attempts++;
+        if (j->second.attempts > 1) {
+            info.retries++;
+        }
+        info.sent++;
+        FetchRequest request = j->second.request;
+
+        // send
+        lock.unlock();
+        FetchResponse response;
+        bool sent = transport->send(request.url, (request.timeout > 0) ? request.timeout : fetchTimeout, response);
+        int code = sent ? response.status : 0;
+        bool ok = code >= 200 && code < 300;
+        if (ok && responses) {
+            responses->put(request.url, request.endpoint, response.body);
+        }
+        lock.lock();
+
+        // cancelled
+        j = jobs.find(url);
+        j->second.active = false;
+        if (j->second.cancelled) {
+            jobs.erase(j);
+            continue;
+        }
+
+        // throttled by the server
+        if (code == 429) {
+            bucket.drain((response.retry > 0) ? response.retry : this->backoff(j->second.attempts, 0));
+        }
+
+        // retry
+        bool transient = code == 0 || code == 429 || code >= 500;
+        if (! ok && transient && j->second.attempts < fetchAttempts && running) {
+            delayed.insert(make_pair(boost::get_system_time() + fetchSeconds(this->backoff(j->second.attempts, response.retry)), url));
+            continue;
+        }
+
+        // result
+        FetchResult result = Fetch::result(j->second, ok ? fetchOk : ((code == 404) ? fetchNotFound : fetchFailed));
+        result.code = code;
+        result.body.swap(response.body);
+        result.error = response.error;
+        if (! ok) {
+            info.failed++;
+            if (result.error.empty()) {
+                char e[32];
+                snprintf(e, sizeof(e), "status %i", code);
+                result.error = e;
+            }
+        }
+        vector<FetchCallback> callbacks;
+        callbacks.swap(j->second.callbacks);
+        jobs.erase(j);
+
+        // notify
+        lock.unlock();
+        for (vector<FetchCallback>::iterator c = callbacks.begin(); c != callbacks.end(); ++c) {
+            (*c)(result);
+        }
+        lock.lock();
+    }
+}
+
+/**
+ * Drops pending requests or only the prefetches.
+ */
+void Fetch::discard(bool prefetches) {
+
+    // pending
+    vector<FetchCallback> callbacks;
+    vector<FetchResult> results;
+    {
+        boost::mutex::scoped_lock lock(mutex);
+        background.clear();
+        if (! prefetches) {
+            ready.clear();
+        }
+        for (multimap<boost::system_time,string>::iterator d = delayed.begin(); d != delayed.end();) {
+            std::map<string,Job>::iterator j = jobs.find(d->second);
+            if (! prefetches || j == jobs.end() || j->second.background) {
+                delayed.erase(d++);
+            }
+            else {
+                ++d;
+            }
+        }
+        for (std::map<string,Job>::iterator j = jobs.begin(); j != jobs.end();) {
+            if (prefetches && ! j->second.background) {
+                ++j;
+                continue;
+            }
+            for (vector<FetchCallback>::iterator c = j->second.callbacks.begin(); c != j->second.callbacks.end(); ++c) {
+                callbacks.push_back(*c);
+                results.push_back(Fetch::result(j->second, fetchCancelled));
+            }
+            j->second.callbacks.clear();
+            if (j->second.active) {
+                j->second.cancelled = true;
+                ++j;
+            }
+            else {
+                jobs.erase(j++);
+            }
+        }
+    }
+
+    // notify
+    for (size_t i = 0; i < callbacks.size(); i++) {
+        callbacks[i](results[i]);
+    }
+}
+
+/**
+ * Collects a result of a group.
+ */
+void Fetch::joined(boost::shared_ptr<Group> g, size_t index, const FetchResult &result) {
+    bool done;
+    {
+        boost::mutex::scoped_lock lock(gmutex);
+        g->results[index] = result;
+        done = --g->remaining == 0;
+    }
+    if (done && g->callback) {
+        g->callback(g->results);
+    }
+}
+
+/**
+ * Jittered exponential backoff, at least what the server asked for.
+ */
+double Fetch::backoff(int attempt, double retry) {
+    double d = min(fetchBackoffMax, fetchBackoff * (1 << min(max(attempt - 1, 0), 16)));
+    d = d * 0.5 + d * 0.5 * (rand() / (double)RAND_MAX);
+    return max(d, retry);
+}
+
+/**
+ * Empty result of a job.
+ */
+FetchResult Fetch::result(const Job &job, FetchStatus status) {
+    FetchResult r;
+    r.url = job.request.url;
+    r.status = status;
+    r.code = 0;
+    r.attempts = job.attempts;
+    r.cached = false;
+    return r;
+}
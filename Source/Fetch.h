@@ -0,0 +1,265 @@
+//
+//  Fetch.h
+//  Solyaris
+//
+//  Created by CNPP on 19.10.2026.
+//  Copyright 2026 Beat Raess. All rights reserved.
+//
+//  This file is part of Solyaris.
+//
+//  Solyaris is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  Solyaris is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with Solyaris.  If not, see www.gnu.org/licenses/.
+
+
+#pragma once
+#include "Cache.h"
+#include <boost/function.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/thread.hpp>
+#include <string>
+#include <vector>
+#include <deque>
+#include <map>
+
+
+// namespace
+using namespace std;
+
+// declarations
+struct FetchResult;
+
+// typedef
+typedef boost::function<void(const FetchResult&)> FetchCallback;
+typedef boost::function<void(const vector<FetchResult>&)> FetchGroupCallback;
+
+// constants
+const int fetchWorkers = 4;
+const double fetchRate = 4.0;
+const double fetchBurst = 8.0;
+const int fetchAttempts = 4;
+const double fetchBackoff = 0.5;
+const double fetchBackoffMax = 16.0;
+const double fetchTimeout = 15.0;
+const double fetchReserve = 2.0;
+
+// status
+enum FetchStatus {
+    fetchOk,
+    fetchFailed,
+    fetchNotFound,
+    fetchCancelled
+};
+
+
+/**
+ * Fetch Request.
+ * The url identifies the request, the endpoint selects the cache lifetime.
+ */
+struct FetchRequest {
+    string url;
+    string endpoint;
+    double timeout;
+};
+
+/**
+ * Fetch Response.
+ * What the transport received, status 0 if the connection failed.
+ */
+struct FetchResponse {
+    int status;
+    string body;
+    double retry;
+    string error;
+};
+
+/**
+ * Fetch Result.
+ * Outcome of a request as seen by its callbacks.
+ */
+struct FetchResult {
+    string url;
+    FetchStatus status;
+    int code;
+    string body;
+    string error;
+    int attempts;
+    bool cached;
+};
+
+/**
+ * Fetch Stats.
+ */
+struct FetchStats {
+    size_t requests;
+    size_t prefetches;
+    size_t coalesced;
+    size_t cached;
+    size_t sent;
+    size_t retries;
+    size_t throttled;
+    size_t failed;
+};
+
+
+/**
+ * Fetch Transport.
+ * Sends a single request, the scheduler decides about retries.
+ */
+class FetchTransport {
+
+    // public
+    public:
+
+    // FetchTransport
+    virtual ~FetchTransport() {}
+
+    // Business
+    virtual bool send(const string &url, double timeout, FetchResponse &response) = 0;
+
+};
+
+/**
+ * Fetch HTTP.
+ * Plain HTTP/1.0 over a socket, enough for the API and for a local
+ * stand-in server.
+ */
+class FetchHTTP: public FetchTransport {
+
+    // public
+    public:
+
+    // Business
+    bool send(const string &url, double timeout, FetchResponse &response);
+
+};
+
+
+/**
+ * Fetch Bucket.
+ * Token bucket refilled at the rate of the API quota, up to a burst.
+ * Not synchronized, the scheduler holds its lock.
+ */
+class FetchBucket {
+
+    // public
+    public:
+
+    // FetchBucket
+    FetchBucket(double rate, double burst);
+
+    // Business
+    double take();
+    double until(double level);
+    void drain(double seconds);
+    void configure(double rate, double burst);
+
+
+    // private
+    private:
+
+    // Helpers
+    void refill();
+
+    // Bucket
+    double rate;
+    double burst;
+    double tokens;
+    boost::system_time stamp;
+
+};
+
+
+/**
+ * Fetch Scheduler.
+ * Runs requests on a bounded set of workers, paced by the token bucket.
+ * Requests for a url already queued or in flight join it instead of being
+ * sent again. Connection errors, 429 and 5xx responses are retried with
+ * jittered exponential backoff, a 429 also drains the bucket for all
+ * workers. Prefetches only go out while the bucket holds more than the
+ * reserve and turn into requests once one joins them. Callbacks run on
+ * a worker thread, or on the caller's for cached responses.
+ */
+class Fetch {
+
+    // public
+    public:
+
+    // Fetch
+    Fetch(FetchTransport *t);
+    ~Fetch();
+
+    // Business
+    void start(int workers = fetchWorkers);
+    void stop();
+    void request(const FetchRequest &r, const FetchCallback &callback);
+    void group(const vector<FetchRequest> &rs, const FetchGroupCallback &callback);
+    void prefetch(const FetchRequest &r, const FetchCallback &callback);
+    void cancel();
+    void cancel(const string &url);
+    void cancelPrefetch();
+
+    // Settings
+    void rate(double rps, double burst);
+    void cache(Cache *c);
+
+    // Accessors
+    FetchStats stats();
+
+
+    // private
+    private:
+
+    // Job
+    struct Job {
+        FetchRequest request;
+        vector<FetchCallback> callbacks;
+        int attempts;
+        bool active;
+        bool cancelled;
+        bool background;
+    };
+
+    // Group
+    struct Group {
+        vector<FetchResult> results;
+        size_t remaining;
+        FetchGroupCallback callback;
+    };
+
+    // Helpers
+    void worker();
+    void discard(bool prefetches);
+    void joined(boost::shared_ptr<Group> g, size_t index, const FetchResult &result);
+    double backoff(int attempt, double retry);
+    static FetchResult result(const Job &job, FetchStatus status);
+
+    // Transport
+    FetchTransport *transport;
+    Cache *responses;
+
+    // Queue
+    std::map<string,Job> jobs;
+    deque<string> ready;
+    deque<string> background;
+    multimap<boost::system_time,string> delayed;
+    FetchBucket bucket;
+    FetchStats info;
+
+    // Workers
+    boost::mutex mutex;
+    boost::mutex gmutex;
+    boost::condition_variable signal;
+    boost::thread_group workers;
+    bool running;
+
+};
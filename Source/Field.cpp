@@ -0,0 +1,280 @@
+//
+//  Field.cpp
+//  Solyaris
+//
+//  Created by CNPP on 19.10.2026.
+//  Copyright 2026 Beat Raess. All rights reserved.
+//
+//  This file is part of Solyaris.
+//
+//  Solyaris is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  Solyaris is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with Solyaris.  If not, see www.gnu.org/licenses/.
+
+#include "Field.h"
+
+
+#pragma mark -
+#pragma mark Object
+
+/**
+ * Creates a field.
+ */
+template <typename T>
+FieldT<T>::FieldT() {
+    cell = 1;
+    ncolumns = 0;
+    nrows = 0;
+}
+
+
+#pragma mark -
+#pragma mark Business
+
+/**
+ * Clears the bodies.
+ */
+template <typename T>
+void FieldT<T>::clear() {
+    gathered.clear();
+    bodies.clear();
+    ncolumns = 0;
+    nrows = 0;
+}
+
+/**
+ * Adds a body of node with pos and mass. Bodies that don't receive only
+ * act on the others, a body of weight w acts like w bodies.
+ */
+template <typename T>
+void FieldT<T>::add(const Vec2<T> &pos, T mass, bool receives, int node, T weight) {
+    Body body;
+    body.pos = pos;
+    body.force = Vec2<T>(0,0);
+    body.mass = mass;
+    body.weight = weight;
+    body.node = node;
+    body.receives = receives;
+    gathered.push_back(body);
+}
+
+/**
+ * Node attraction within range (Node::attract), every pair once: each
+ * cell meets itself and the four neighbours ahead of it.
+ */
+template <typename T>
+void FieldT<T>::attract(T range, T ramp, T strength) {
+
+    // grid
+    this->bin(range);
+
+    // cells
+    static const int ahead[4][2] = { {1,0}, {-1,1}, {0,1}, {1,1} };
+    for (int cy = 0; cy < nrows; cy++) {
+        for (int cx = 0; cx < ncolumns; cx++) {
+
+            // run
+            int begin, end;
+            this->run(cx, cy, begin, end);
+            if (begin == end) {
+                continue;
+            }
+
+            // own cell
+            this->pairs(begin, end, begin, end, range, ramp, strength);
+
+            // neighbours
+            for (int a = 0; a < 4; a++) {
+                int nx = cx + ahead[a][0];
+                int ny = cy + ahead[a][1];
+                if (nx >= 0 && nx < ncolumns && ny < nrows) {
+                    int obegin, oend;
+                    this->run(nx, ny, obegin, oend);
+                    this->pairs(begin, end, obegin, oend, range, ramp, strength);
+                }
+            }
+        }
+    }
+}
+
+/**
+ * Bodies, stored cell by cell after attract.
+ */
+template <typename T>
+int FieldT<T>::size() {
+    return bodies.size();
+}
+template <typename T>
+const typename FieldT<T>::Body& FieldT<T>::body(int b) {
+    return bodies[b];
+}
+
+
+#pragma mark -
+#pragma mark Grid
+
+/**
+ * Grid dimensions.
+ */
+template <typename T>
+int FieldT<T>::columns() {
+    return ncolumns;
+}
+template <typename T>
+int FieldT<T>::rows() {
+    return nrows;
+}
+
+/**
+ * Run of the bodies in cell cx/cy.
+ */
+template <typename T>
+void FieldT<T>::run(int cx, int cy, int &begin, int &end) {
+    int key = cy * ncolumns + cx;
+    begin = starts[key];
+    end = starts[key+1];
+}
+
+/**
+ * Appends the nodes of the bodies within radius of pos, as binned by the
+ * last attract: only the cells the radius overlaps are visited.
+ */
+template <typename T>
+void FieldT<T>::within(const Vec2<T> &pos, T radius, vector<int> &nodes) {
+    if (ncolumns == 0 || nrows == 0) {
+        return;
+    }
+    
+    // cells
+    int x0 = max(0, (int)floor((pos.x - radius - origin.x) / cell));
+    int y0 = max(0, (int)floor((pos.y - radius - origin.y) / cell));
+    int x1 = min(ncolumns-1, (int)floor((pos.x + radius - origin.x) / cell));
+    int y1 = min(nrows-1, (int)floor((pos.y + radius - origin.y) / cell));
+    
+    // bodies
+    T r2 = radius * radius;
+    for (int cy = y0; cy <= y1; cy++) {
+        for (int cx = x0; cx <= x1; cx++) {
+            int begin, end;
+            this->run(cx, cy, begin, end);
+            for (int b = begin; b < end; b++) {
+                if ((bodies[b].pos - pos).lengthSquared() < r2) {
+                    nodes.push_back(bodies[b].node);
+                }
+            }
+        }
+    }
+}
+
+
+#pragma mark -
+#pragma mark Helpers
+
+/**
+ * Bins the bodies into the grid by counting sort. Cells are at least range
+ * wide, coarser when the graph is sparse so the grid stays within a few
+ * cells per body.
+ */
+template <typename T>
+void FieldT<T>::bin(T range) {
+
+    // empty
+    int n = gathered.size();
+    if (n == 0) {
+        bodies.clear();
+        ncolumns = 0;
+        nrows = 0;
+        return;
+    }
+
+    // bounds
+    Vec2<T> bmin = gathered[0].pos;
+    Vec2<T> bmax = gathered[0].pos;
+    for (int b = 1; b < n; b++) {
+        bmin.set(min(bmin.x, gathered[b].pos.x), min(bmin.y, gathered[b].pos.y));
+        bmax.set(max(bmax.x, gathered[b].pos.x), max(bmax.y, gathered[b].pos.y));
+    }
+    origin = bmin;
+
+    // cells
+    double cap = fieldCellsPerBody * n + 16;
+    cell = max(range, (T)1);
+    ncolumns = (int)((bmax.x - bmin.x) / cell) + 1;
+    nrows = (int)((bmax.y - bmin.y) / cell) + 1;
+    while ((double)ncolumns * nrows > cap) {
+        cell *= 2;
+        ncolumns = (int)((bmax.x - bmin.x) / cell) + 1;
+        nrows = (int)((bmax.y - bmin.y) / cell) + 1;
+    }
+
+    // count (the grid grows as the layout spreads, up to the cap)
+    int ncells = ncolumns * nrows;
+    keys.resize(n);
+    starts.reserve((int)cap + 1);
+    starts.assign(ncells + 1, 0);
+    for (int b = 0; b < n; b++) {
+        int cx = min(ncolumns-1, (int)((gathered[b].pos.x - origin.x) / cell));
+        int cy = min(nrows-1, (int)((gathered[b].pos.y - origin.y) / cell));
+        keys[b] = cy * ncolumns + cx;
+        starts[keys[b]+1]++;
+    }
+    for (int c = 0; c < ncells; c++) {
+        starts[c+1] += starts[c];
+    }
+
+    // store cell by cell
+    bodies.resize(n);
+    for (int b = 0; b < n; b++) {
+        bodies[starts[keys[b]]++] = gathered[b];
+    }
+    for (int c = ncells; c > 0; c--) {
+        starts[c] = starts[c-1];
+    }
+    starts[0] = 0;
+}
+
+/**
+ * Attraction between the bodies of two runs, within a run every pair once.
+ */
+template <typename T>
+void FieldT<T>::pairs(int begin, int end, int obegin, int oend, T range, T ramp, T strength) {
+    T r2 = range * range;
+    for (int a = begin; a < end; a++) {
+        Body &ba = bodies[a];
+        for (int b = (obegin == begin) ? a+1 : obegin; b < oend; b++) {
+            Body &bb = bodies[b];
+            if (! ba.receives && ! bb.receives) {
+                continue;
+            }
+
+            // distance
+            Vec2<T> d = ba.pos - bb.pos;
+            T d2 = d.lengthSquared();
+            if (d2 > 0 && d2 < r2) {
+
+                // force
+                T f = Layout<T>::attraction(sqrt(d2), range, ramp, strength);
+                if (bb.receives) {
+                    bb.force += d * (f * ba.weight / ba.mass);
+                }
+                if (ba.receives) {
+                    ba.force -= d * (f * bb.weight / bb.mass);
+                }
+            }
+        }
+    }
+}
+
+
+// instances
+template class FieldT<float>;
+template class FieldT<double>;
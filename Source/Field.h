@@ -0,0 +1,99 @@
+//
+//  Field.h
+//  Solyaris
+//
+//  Created by CNPP on 19.10.2026.
+//  Copyright 2026 Beat Raess. All rights reserved.
+//
+//  This file is part of Solyaris.
+//
+//  Solyaris is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  Solyaris is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with Solyaris.  If not, see www.gnu.org/licenses/.
+
+#pragma once
+#include "cinder/Vector.h"
+#include "Layout.h"
+#include <vector>
+
+
+// namespace
+using namespace std;
+using namespace ci;
+
+
+// constants
+const int fieldCellsPerBody = 4;
+
+
+/**
+ * Field.
+ * Node attraction over a contiguous body pool. The bodies are binned into
+ * a uniform grid of range sized cells and stored cell by cell, so a cell
+ * is one contiguous run and a body only meets the bodies of its own and
+ * the neighbouring cells: O(n·k) instead of O(n²).
+ * Templated on the scalar type, instantiated for float and double.
+ */
+template <typename T>
+class FieldT {
+
+    // public
+    public:
+
+    // Body
+    struct Body {
+        Vec2<T> pos;
+        Vec2<T> force;
+        T mass;
+        T weight;
+        int node;
+        bool receives;
+    };
+
+    // Field
+    FieldT();
+
+    // Business
+    void clear();
+    void add(const Vec2<T> &pos, T mass, bool receives, int node, T weight = 1);
+    void attract(T range, T ramp, T strength);
+    int size();
+    const Body& body(int b);
+
+    // Grid
+    int columns();
+    int rows();
+    void run(int cx, int cy, int &begin, int &end);
+    void within(const Vec2<T> &pos, T radius, vector<int> &nodes);
+
+
+    // private
+    private:
+
+    // Helpers
+    void bin(T range);
+    void pairs(int begin, int end, int obegin, int oend, T range, T ramp, T strength);
+
+    // Bodies
+    vector<Body> gathered;
+    vector<Body> bodies;
+
+    // Grid
+    Vec2<T> origin;
+    T cell;
+    int ncolumns;
+    int nrows;
+    vector<int> keys;
+    vector<int> starts;
+
+};
+typedef FieldT<Scalar> Field;
@@ -21,6 +21,7 @@
 //  along with Solyaris.  If not, see www.gnu.org/licenses/.
 
 #include "Graph.h"
+#include "Prefetch.h"
 
 
 #pragma mark -
@@ -30,9 +31,23 @@
  * Creates a graph.
  */
 Graph::Graph() {
+    
+    // commands
+    commands = boost::shared_ptr<GraphQueue>(new GraphQueue());
+    mbudget = graphMutationBudget;
+    
+    // bodies
+    pool = NodePoolPtr(new NodePool());
 }
 Graph::Graph(int w, int h, int o) {
     
+    // commands
+    commands = boost::shared_ptr<GraphQueue>(new GraphQueue());
+    mbudget = graphMutationBudget;
+    
+    // bodies
+    pool = NodePoolPtr(new NodePool());
+    
     // fields
     width = w;
     height = h;
@@ -52,9 +67,39 @@ Graph::Graph(int w, int h, int o) {
     vpos.set(0,0);
     vppos.set(0,0);
     
-    // movement
-    speed = 45;
-    friction = 5.1;
+    // movement (1/s)
+    speed = 1.348;
+    friction = 13.09;
+    
+    // timestep
+    tstep = graphTimestep;
+    taccum = 0;
+    tlast = -1;
+    substeps = 1;
+    ticks = 0;
+    
+    // cooling
+    energy = 0;
+    penergy = 0;
+    temperature = graphTemperatureMax;
+    calm = 0;
+    theat = 0;
+    settled = false;
+    
+    // relaxation
+    localized = false;
+    frozen = false;
+    
+    // engine
+    engine = graphEngineFlat;
+    remodel = false;
+    
+    // report
+    tphysics = 0;
+    nphysics = 0;
+    nalloc = 0;
+    falloc = 0;
+    nframes = 0;
     
     // hitarea
     harea = 20;
@@ -108,7 +153,7 @@ void Graph::resize(int w, int h, int o) {
 /**
  * Applies the settings.
  */
-void Graph::config(Configuration c) {
+void Graph::config(const Configuration &c) {
     
     // reference
     conf = c;
@@ -124,6 +169,11 @@ void Graph::config(Configuration c) {
     Config confDisplayResolution = conf.getConfiguration(cDisplayResolution);
     dpr = confDisplayResolution.floatVal();
     
+    // style / parameters
+    Style::config(conf);
+    Params::config(conf);
+    FLog("node %d bytes (body %d, info %d), edge %d bytes", (int)sizeof(Node), (int)sizeof(NodeBody), (int)sizeof(NodeInfo), (int)sizeof(Edge));
+    
     // tooltip / action
     for (int t = 1; t <= nbtouch; t++) {
         tooltips[t].config(conf);
@@ -163,7 +213,7 @@ void Graph::config(Configuration c) {
 /**
  * Applies the settings.
  */
-void Graph::defaults(Defaults d) {
+void Graph::defaults(const Defaults &d) {
     
     // reference
     dflts = d;
@@ -182,31 +232,51 @@ void Graph::defaults(Defaults d) {
         layout_subnodes = ! graphLayoutSubnodes.boolVal();
     }
     
-    
-    // apply to nodes
-    for (NodeIt node = nodes.begin(); node != nodes.end(); ++node) {
-        (*node)->defaults(dflts);
+    // engine
+    engine = graphEngineFlat;
+    Default graphLayoutEngine = d.getDefault(dGraphLayoutEngine);
+    if (graphLayoutEngine.isSet()) {
+        engine = graphLayoutEngine.stringVal();
     }
     
-    // apply to edges
-    for (EdgeIt edge = edges.begin(); edge != edges.end(); ++edge) {
-        (*edge)->defaults(dflts);
+    // substeps
+    substeps = 1;
+    Default graphLayoutSubsteps = d.getDefault(dGraphLayoutSubsteps);
+    if (graphLayoutSubsteps.isSet()) {
+        substeps = max(1, min(graphSubstepsMax, (int) graphLayoutSubsteps.doubleVal()));
     }
     
-    // apply to connections
-    for (ConnectionIt connection = connections.begin(); connection != connections.end(); ++connection) {
-        (*connection)->defaults(dflts);
+    // mutation budget (ms)
+    mbudget = graphMutationBudget;
+    Default graphMutation = d.getDefault(dGraphMutationBudget);
+    if (graphMutation.isSet()) {
+        mbudget = max(0.0, graphMutation.doubleVal() / 1000.0);
     }
     
+    
+    // parameters
+    Params::defaults(dflts);
+    
+    // relayout
+    this->heat(graphTemperatureMax);
+    
 }
 
 /**
  * Applies the translations.
  */
-void Graph::i18n(I18N tls) {
+void Graph::i18n(const I18N &tls) {
     translations = tls;
 }
 
+/**
+ * Called with the id of a node unloaded or removed, its pending load is
+ * of no use anymore.
+ */
+void Graph::abort(const GraphAbort &a) {
+    aborts = a;
+}
+
 
 #pragma mark -
 #pragma mark Sketch
@@ -214,15 +284,131 @@ void Graph::i18n(I18N tls) {
 
 /**
  * Updates the graph.
+ * The layout advances in fixed ticks of tstep seconds, independent of the
+ * display rate. Each tick is split into substeps for stiff graphs.
  */
 void Graph::update() {
     
+    // parameters of the frame
+    Params::pin();
+    
+    // commands
+    this->drain();
+    
+    // allocations, besides the commands
+    long acount = Alloc::count();
+    
+    // scratch
+    Arena::reset();
 
     // randomize
     Rand::randomize();
     
+    // elapsed
+    double now = ci::app::getElapsedSeconds();
+    double elapsed = (tlast >= 0) ? min(now - tlast, graphElapsedMax) : tstep;
+    tlast = now;
+    
+    // multilevel engine
+    if (remodel && layout_nodes && engine == graphEngineMultilevel) {
+        this->multilevel();
+    }
+    remodel = false;
+    
+    // animations
+    Timeline::update(elapsed);
+    
+    // ticks
+    taccum += elapsed;
+    int nb = 0;
+    while (taccum >= tstep && nb < graphStepsMax) {
+        
+        // relaxation (the cold graph catches up every few ticks)
+        frozen = localized && (ticks % graphRelaxCold != 0);
+        
+        // level of detail
+        int phase = 0;
+        for (NodeIt node = nodes.begin(); node != nodes.end(); ++node) {
+            (*node)->body->lod = this->detail(*node);
+            (*node)->body->due = (ticks + phase++) % (*node)->body->lod == 0;
+        }
+        
+        // children follow their parent
+        for (NodeIt node = nodes.begin(); node != nodes.end(); ++node) {
+            if ((*node)->isActive() || (*node)->isLoading()) {
+                for (NodeIt child = (*node)->children.begin(); child != (*node)->children.end(); ++child) {
+                    if ((*node)->isNodeChild(*child)) {
+                        (*child)->body->lod = (*node)->body->lod;
+                        (*child)->body->due = (*node)->body->due;
+                    }
+                }
+            }
+        }
+        
+        // substeps
+        double tp = ci::app::getElapsedSeconds();
+        for (int s = 0; s < substeps; s++) {
+            this->step(tstep / substeps);
+        }
+        tphysics += ci::app::getElapsedSeconds() - tp;
+        nphysics++;
+        
+        // report
+        if (ticks % graphReportTicks == 0) {
+            this->report();
+        }
+        
+        // cool
+        this->cool();
+        
+        // next
+        taccum -= tstep;
+        ticks++;
+        nb++;
+    }
+    
+    // drop what we can't catch up with
+    taccum = min(taccum, tstep);
+    
+    // edges
+    for (EdgeIt edge = edges.begin(); edge != edges.end(); ++edge) {
+        
+        // active
+        if ((*edge)->isVisible()) {
+            (*edge)->update();
+        }
+    }
+    
+    // connections
+    for (ConnectionIt connection = connections.begin(); connection != connections.end(); ++connection) {
+        
+        // update
+        (*connection)->update();
+    }
+    
+    // tooltip / actions
+    for (int t = 1; t <= nbtouch; t++) {
+        tooltips[t].update();
+        actions[t].update();
+    }
+    
+    // allocations
+    long allocated = Alloc::count() - acount;
+    nalloc += allocated;
+    if (allocated > 0) {
+        falloc++;
+    }
+    nframes++;
+
+}
+
+/**
+ * Advances the layout by dt seconds.
+ */
+void Graph::step(double dt) {
+    
     // layout nodes
-    if (layout_nodes) {
+    if (layout_nodes && ! settled) {
         
         // attract
         this->attract();
@@ -233,23 +419,43 @@ void Graph::update() {
     }
     
     // layout subnodes
-    if (layout_subnodes && ci::app::getElapsedFrames() % 6 == 0) {
+    if (layout_subnodes && ! settled) {
         this->subnodes();
     }
     
     // virtual position
     Vec2d dd = vmpos - vpos;
     vppos = vpos;
-    vpos += dd / friction;
+    vpos += dd * (1.0 - exp(-friction * dt));
     translate += (vpos - vppos);
     
     
     // virtual offset
     Vec2d dm = vmoff - voff;
     vpoff = voff;
-    voff += dm/speed;
+    voff += dm * (1.0 - exp(-speed * dt));
     Vec2d vmove = (voff - vpoff);
+    if (frozen) {
+        fshift += vmove;
+    }
+    
+    
+    // energy
+    double e = 0;
+    int ne = 0;
     
+    // mutated (one relaxation for all of them)
+    mseeds.clear();
+    for (NodeIt node = nodes.begin(); node != nodes.end(); ++node) {
+        if ((*node)->body->mutated) {
+            (*node)->body->mutated = false;
+            mseeds.push_back(*node);
+        }
+    }
+    if (! mseeds.empty()) {
+        this->heat(graphHeatMutation);
+        this->relax(mseeds);
+    }
     
     // nodes
     for (NodeIt node = nodes.begin(); node != nodes.end(); ++node) {
@@ -257,15 +463,40 @@ void Graph::update() {
         // active
         if ((*node)->isActive() || (*node)->isLoading()) {
             
-            // global movement
-            (*node)->move(vmove);
+            // frozen, a cold node only follows the global movement
+            bool cold = frozen && (*node)->body->relax == 0;
+            if (cold) {
+                (*node)->translate(vmove);
+            }
+            else {
+                (*node)->move(vmove);
+            }
             
-            // update
-            (*node)->update();
+            // level of detail and cold nodes (no forces until due)
+            if (cold || ! (*node)->body->due) {
+                (*node)->skip();
+                for (NodeIt child = (*node)->children.begin(); child != (*node)->children.end(); ++child) {
+                    if ((*node)->isNodeChild(*child)) {
+                        if (cold) {
+                            (*child)->translate(vmove);
+                        }
+                        (*child)->skip();
+                    }
+                }
+                continue;
+            }
+            
+            // update (over the skipped steps)
+            (*node)->body->force *= temperature;
+            (*node)->update(dt);
+            if (! localized || (*node)->body->relax > 0) {
+                e += (*node)->body->velocity.lengthSquared();
+                ne++;
+            }
             
             // node movement
-            Vec2d ndist = (*node)->mpos - (*node)->pos;
-            float nmov = (ndist.length() > 1) ? ndist.length() * 0.0045 : 0;
+            Vec2s ndist = (*node)->body->mpos - (*node)->body->pos;
+            float nmov = (ndist.length() > 1) ? ndist.length() * 0.0045 * nodeFrameRate * dt * (*node)->body->lod : 0;
 
             // children
             for (NodeIt child = (*node)->children.begin(); child != (*node)->children.end(); ++child) {
@@ -274,13 +505,18 @@ void Graph::update() {
                 if ((*node)->isNodeChild(*child)) {
                     
                     // follow
-                    (*child)->translate((*node)->pos - (*node)->ppos);
+                    (*child)->translate((*node)->body->pos - (*node)->body->ppos);
                     
                     // randomize
                     (*child)->move(Rand::randFloat(-1,1)*nmov,Rand::randFloat(-1,1)*nmov);
                     
                     // update
-                    (*child)->update();
+                    (*child)->body->force *= temperature;
+                    (*child)->update(dt);
+                    if (! localized || (*child)->body->relax > 0) {
+                        e += (*child)->body->velocity.lengthSquared();
+                        ne++;
+                    }
                 }
                 
             }
@@ -289,28 +525,278 @@ void Graph::update() {
         
     }
     
-    // edges
-    for (EdgeIt edge = edges.begin(); edge != edges.end(); ++edge) {
+    // mean squared speed
+    energy = (ne > 0) ? e / ne : 0;
+    
+}
+
+
+#pragma mark -
+#pragma mark Layout
+
+/**
+ * Heats the layout up after a mutation.
+ */
+void Graph::heat(double h) {
+    
+    // temperature
+    temperature = min(graphTemperatureMax, temperature + h);
+    
+    // structural change
+    remodel = remodel || h >= graphHeatMutation;
+    
+    // wake up
+    if (settled) {
+        theat = ticks;
+    }
+    settled = false;
+    calm = 0;
+}
+
+/**
+ * Adaptive cooling: cools down while the energy drops, faster when it rises
+ * again (oscillation). The layout is settled once the energy stays low.
+ */
+void Graph::cool() {
+    
+    // temperature
+    double c = (energy <= penergy) ? graphCooling : graphCooling * graphCooling;
+    temperature = max(graphTemperatureMin, temperature * c);
+    penergy = energy;
+    
+    // relaxation budget, cooled nodes leave the hot ones
+    if (localized) {
+        int h = 0;
+        for (int n = 0; n < (int)hnodes.size(); n++) {
+            if (--hnodes[n]->body->relax > 0) {
+                hnodes[h++] = hnodes[n];
+            }
+        }
+        hnodes.resize(h);
         
-        // active
-        if ((*edge)->isVisible()) {
-            (*edge)->update();
+        // hot edges, until both ends cooled
+        int k = 0;
+        for (int e = 0; e < (int)hedges.size(); e++) {
+            NodePtr node1 = hedges[e]->wnode1.lock();
+            NodePtr node2 = hedges[e]->wnode2.lock();
+            if (node1 && node2 && (node1->body->relax > 0 || node2->body->relax > 0)) {
+                hedges[k++] = hedges[e];
+            }
+            else {
+                hedges[e]->hot = false;
+            }
+        }
+        hedges.resize(k);
+        
+        // spent
+        if (hnodes.empty()) {
+            this->release();
         }
     }
     
-    // connections
-    for (ConnectionIt connection = connections.begin(); connection != connections.end(); ++connection) {
+    // settled
+    if (! settled) {
+        calm = (energy < graphEnergySettled) ? calm + 1 : 0;
+        if (calm >= graphSettleTicks) {
+            
+            // local relaxation done, let the whole graph settle
+            if (localized) {
+                FLog("relaxed after %d ticks", ticks - theat);
+                this->release();
+                calm = 0;
+            }
+            else {
+                FLog("settled after %d ticks", ticks - theat);
+                settled = true;
+                temperature = graphTemperatureMin;
+            }
+        }
+    }
+}
+
+/**
+ * Localizes the relaxation around a mutated node: nodes within a few hops
+ * or within a radius get the full update rate, the rest of the graph is
+ * frozen and only catches up every graphRelaxCold ticks.
+ */
+void Graph::relax(const NodePtr &n) {
+    mseeds.clear();
+    mseeds.push_back(n);
+    this->relax(mseeds);
+}
+
+/**
+ * Localizes the relaxation around the mutated nodes of a tick. The hops
+ * follow the adjacency kept by createEdge/removeNode, the radius hits come
+ * from the field grid: the cost follows the neighbourhood of the seeds,
+ * not the size of the graph.
+ */
+void Graph::relax(const NodeVectorPtr &seeds) {
+    GLog();
+    
+    // small graphs
+    if ((int)nodes.size() < graphRelaxNodesMin) {
+        return;
+    }
+    
+    // seeds
+    Scalar r = graphRelaxRadius * dpr;
+    for (int s = 0; s < (int)seeds.size(); s++) {
+        const NodePtr &seed = seeds[s];
+        this->warm(seed);
         
-        // update
-        (*connection)->update();
+        // hops
+        set<Node*> visited;
+        visited.insert(seed.get());
+        NodeVectorPtr frontier;
+        frontier.push_back(seed);
+        for (int h = 0; h < graphRelaxHops && ! frontier.empty(); h++) {
+            NodeVectorPtr next;
+            for (NodeIt f = frontier.begin(); f != frontier.end(); ++f) {
+                map<Node*,EdgeVectorPtr>::iterator incident = adjacency.find((*f).get());
+                if (incident == adjacency.end()) {
+                    continue;
+                }
+                for (EdgeIt edge = incident->second.begin(); edge != incident->second.end(); ++edge) {
+                    NodePtr a = (*edge)->wnode1.lock();
+                    if (a == *f) {
+                        a = (*edge)->wnode2.lock();
+                    }
+                    if (a && visited.insert(a.get()).second) {
+                        this->warm(a);
+                        next.push_back(a);
+                    }
+                }
+            }
+            frontier.swap(next);
+        }
+        
+        // radius
+        fhits.clear();
+        field.within(seed->body->pos - fshift, r, fhits);
+        for (vector<int>::iterator hit = fhits.begin(); hit != fhits.end(); ++hit) {
+            const NodeBody &b = pool->body(*hit);
+            if (b.live) {
+                this->warm(b.node->sref.lock());
+            }
+        }
     }
     
-    // tooltip / actions
-    for (int t = 1; t <= nbtouch; t++) {
-        tooltips[t].update();
-        actions[t].update();
+    // most of the graph is hot anyway
+    localized = hnodes.size() * 2 < nodes.size();
+    if (! localized) {
+        this->release();
+    }
+}
+
+/**
+ * Gives a node the full relaxation budget, it joins the hot nodes with its
+ * edges.
+ */
+void Graph::warm(const NodePtr &n) {
+    
+    // node
+    if (n->body->relax <= 0) {
+        hnodes.push_back(n);
+    }
+    n->body->relax = graphRelaxTicks;
+    
+    // edges
+    map<Node*,EdgeVectorPtr>::iterator incident = adjacency.find(n.get());
+    if (incident != adjacency.end()) {
+        for (EdgeIt edge = incident->second.begin(); edge != incident->second.end(); ++edge) {
+            if (! (*edge)->hot) {
+                (*edge)->hot = true;
+                hedges.push_back(*edge);
+            }
+        }
+    }
+}
+
+/**
+ * Releases the localized relaxation.
+ */
+void Graph::release() {
+    GLog();
+    
+    // budget
+    for (NodeIt node = hnodes.begin(); node != hnodes.end(); ++node) {
+        (*node)->body->relax = 0;
+    }
+    for (EdgeIt edge = hedges.begin(); edge != hedges.end(); ++edge) {
+        (*edge)->hot = false;
+    }
+    
+    // reset
+    hnodes.clear();
+    hedges.clear();
+    localized = false;
+    frozen = false;
+}
+
+/**
+ * Multilevel engine: lays out the expanded nodes of a large graph in one go,
+ * the flat simulation then refines the result.
+ */
+void Graph::multilevel() {
+    GLog();
+    
+    // expanded nodes
+    NodeVectorPtr mnodes;
+    map<Node*,int> mindex;
+    for (NodeIt node = nodes.begin(); node != nodes.end(); ++node) {
+        if ((*node)->isActive() && ! (*node)->isClosed()) {
+            mindex[(*node).get()] = mnodes.size();
+            mnodes.push_back(*node);
+        }
     }
+    if ((int)mnodes.size() < graphMultilevelNodesMin) {
+        return;
+    }
+    
+    // links
+    vector< pair<int,int> > links;
+    for (EdgeIt edge = edges.begin(); edge != edges.end(); ++edge) {
+        NodePtr node1 = (*edge)->wnode1.lock();
+        NodePtr node2 = (*edge)->wnode2.lock();
+        if (node1 && node2) {
+            map<Node*,int>::iterator it1 = mindex.find(node1.get());
+            map<Node*,int>::iterator it2 = mindex.find(node2.get());
+            if (it1 != mindex.end() && it2 != mindex.end()) {
+                links.push_back(make_pair(it1->second, it2->second));
+            }
+        }
+    }
+    
+    // positions
+    vector<Vec2s> positions;
+    for (NodeIt node = mnodes.begin(); node != mnodes.end(); ++node) {
+        positions.push_back((*node)->body->mpos);
+    }
+    
+    // layout
+    mlayout.layout(positions, links, Params::edge().length);
+    FLog("multilevel layout of %d nodes over %d levels", (int)mnodes.size(), mlayout.depth());
+    
+    // apply
+    for (int m = 0; m < (int)mnodes.size(); m++) {
+        if (! mnodes[m]->isSelected()) {
+            mnodes[m]->moveTo(positions[m]);
+        }
+    }
+}
 
+/**
+ * Layout metrics.
+ */
+double Graph::layoutEnergy() {
+    return energy;
+}
+double Graph::layoutTemperature() {
+    return temperature;
+}
+bool Graph::isSettled() {
+    return settled;
 }
 
 /**
@@ -347,7 +833,7 @@ void Graph::draw() {
     for (NodeIt node = nodes.begin(); node != nodes.end(); ++node) {
         
         // draw if visible and on stage
-        if ((*node)->isVisible() && this->onStage(*node)) {
+        if ((*node)->isVisible() && ! (*node)->isClustered() && this->onStage(*node)) {
             (*node)->draw();
         }
     }
@@ -375,7 +861,13 @@ void Graph::draw() {
 void Graph::reset() {
     DLog();
     
+    // relaxation
+    this->release();
+    
     // clear
+    for (NodeIt node = nodes.begin(); node != nodes.end(); ++node) {
+        (*node)->body->live = false;
+    }
     connections.clear(); 
     edges.clear(); 
     nodes.clear(); 
@@ -384,11 +876,16 @@ void Graph::reset() {
     nmap.clear();
     emap.clear();
     cmap.clear();
+    adjacency.clear();
+    field.clear();
     
     // zoom
     scale = 1.0;
     translate.set(0,0);
     
+    // cooling
+    this->heat(graphTemperatureMax);
+    
 }
 
 
@@ -432,11 +929,11 @@ NodePtr Graph::touchBegan(Vec2d tpos, int tid) {
     for (NodeIt node = nodes.begin(); node != nodes.end(); ++node) {
         
         // visible
-        if ((*node)->isVisible()) {
+        if ((*node)->isVisible() && ! (*node)->isClustered()) {
             
             // distance
-            float d = (*node)->pos.distance(ztpos);
-            if (d < (*node)->core+harea) {
+            float d = (*node)->body->pos.distance(ztpos);
+            if (d < (*node)->body->core+harea) {
                 
                 // touched
                 GLog("tid = %d, node = ",tid);
@@ -476,6 +973,10 @@ void Graph::touchMoved(Vec2d tpos, Vec2d ppos, int tid){
         
         // move
         touched[tid]->moveTo(ztpos);
+        this->heat(graphHeatDrag);
+        if (touched[tid]->body->relax <= 0) {
+            this->relax(touched[tid]);
+        }
         
         // tooltip
         tooltips[tid].position(tpos);
@@ -535,11 +1036,11 @@ NodePtr Graph::doubleTap(Vec2d tpos, int tid) {
     for (NodeIt node = nodes.begin(); node != nodes.end(); ++node) {
         
         // visible
-        if ((*node)->isVisible()) {
+        if ((*node)->isVisible() && ! (*node)->isClustered()) {
             
             // distance
-            float d = (*node)->pos.distance(ztpos);
-            if (d < (*node)->core+harea) {
+            float d = (*node)->body->pos.distance(ztpos);
+            if (d < (*node)->body->core+harea) {
                 
                 // tapped
                 (*node)->tapped();
@@ -598,20 +1099,80 @@ void Graph::pinched(Vec2d p, Vec2d pp, double s, double ps) {
 
 /**
  * Attraction.
+ * The bodies of the active nodes are gathered from the pool into the field,
+ * which only pairs up bodies of neighbouring cells, the forces are then
+ * handed back to the nodes. While frozen only the hot nodes are gathered,
+ * with the cold ones around them: the field of the last full tick still
+ * bins the cold nodes, they have only been shifted since.
  */
 void Graph::attract() {
+    const NodeParams &params = Params::node();
     
-    // nodes
-    for (NodeIt n1 = nodes.begin(); n1 != nodes.end(); ++n1) {
+    // frozen
+    if (frozen) {
         
-        // attract others
-        for (NodeIt n2 = nodes.begin(); n2 != nodes.end(); ++n2) {
-            if ((*n1)->isActive() && (*n2)->isActive() && ! (*n1)->isClosed() && ! (*n2)->isClosed() && (*n1) != (*n2)) {
-                (*n1)->attract(*n2);
+        // hot bodies
+        hfield.clear();
+        for (NodeIt node = hnodes.begin(); node != hnodes.end(); ++node) {
+            this->gather(hfield, (*node)->slot, (*node)->body->due);
+        }
+        
+        // cold bodies in range (missed ones at the edge of the range would
+        // not pull anyway)
+        fhits.clear();
+        for (NodeIt node = hnodes.begin(); node != hnodes.end(); ++node) {
+            field.within((*node)->body->pos - fshift, (Scalar)params.perimeter, fhits);
+        }
+        sort(fhits.begin(), fhits.end());
+        fhits.erase(unique(fhits.begin(), fhits.end()), fhits.end());
+        for (vector<int>::iterator hit = fhits.begin(); hit != fhits.end(); ++hit) {
+            if (pool->body(*hit).relax == 0) {
+                this->gather(hfield, *hit, false);
             }
         }
+        
+        // attract
+        hfield.attract(params.perimeter, params.ramp, params.strength);
+        for (int b = 0; b < hfield.size(); b++) {
+            const Field::Body &body = hfield.body(b);
+            if (body.receives) {
+                pool->body(body.node).force += body.force / body.weight;
+            }
+        }
+        return;
     }
     
+    // bodies (nodes off their level of detail only push the others)
+    field.clear();
+    fshift.set(0,0);
+    for (int s = 0; s < pool->capacity(); s++) {
+        this->gather(field, s, pool->body(s).due);
+    }
+    
+    // attract
+    field.attract(params.perimeter, params.ramp, params.strength);
+    
+    // forces
+    for (int b = 0; b < field.size(); b++) {
+        const Field::Body &body = field.body(b);
+        if (body.receives) {
+            pool->body(body.node).force += body.force / body.weight;
+        }
+    }
+    
+}
+
+/**
+ * Adds the body in slot s if its node is expanded, clusters push and
+ * resist with the weight of their members.
+ */
+void Graph::gather(Field &f, int s, bool receives) {
+    const NodeBody &b = pool->body(s);
+    if (b.live && b.active && (! b.closed || b.cluster)) {
+        Scalar w = b.cluster ? Kernel::weight(b.mass, b.radius) : 1;
+        Scalar m = b.mass / w;
+        f.add(b.pos, b.selected ? m*2 : m, receives, s, w);
+    }
 }
 
 /**
@@ -619,8 +1180,11 @@ void Graph::attract() {
  */
 void Graph::repulse() {
     
+    // hot edges only while frozen
+    EdgeVectorPtr &redges = frozen ? hedges : edges;
+    
     // edges
-    for (EdgeIt edge = edges.begin(); edge != edges.end(); ++edge) {
+    for (EdgeIt edge = redges.begin(); edge != redges.end(); ++edge) {
         
         // active
         if ((*edge)->isActive()) {
@@ -633,43 +1197,58 @@ void Graph::repulse() {
 
 /**
  * Subnodes.
+ * Orbital layout: the children of a node are sorted by angle and only
+ * angular neighbours push each other apart, the ring is bounded by
+ * nodeUnfoldMin/nodeUnfoldMax. O(k log k) per parent.
  */
 void Graph::subnodes() {
     
+    // hot nodes only while frozen
+    NodeVectorPtr &snodes = frozen ? hnodes : nodes;
+    
     // nodes
-    for (NodeIt node = nodes.begin(); node != nodes.end(); ++node) {
+    for (NodeIt node = snodes.begin(); node != snodes.end(); ++node) {
         
         // active node on stage
-        if ((*node)->isActive() && ! (*node)->isClosed() && ! (*node)->isLoading() && this->onStage(*node)) {
+        if ((*node)->body->due && (*node)->isActive() && ! (*node)->isClosed() && ! (*node)->isLoading() && this->onStage(*node)) {
             
             // sphere
-            float smin = (*node)->radius * nodeUnfoldMin;
-            float smax = (*node)->radius * nodeUnfoldMax;
+            Vec2s p = (*node)->body->pos;
+            float smin = (*node)->body->radius * nodeUnfoldMin;
+            float smax = (*node)->body->radius * nodeUnfoldMax;
             
-            // children
-            for (NodeIt c1 = (*node)->children.begin(); c1 != (*node)->children.end(); ++c1) {
+            // orbit
+            NodeVectorPtr &children = (*node)->children;
+            orbit.clear();
+            for (int c = 0; c < (int)children.size(); c++) {
                 
                 // child
-                if ((*node)->isNodeChild(*c1) && ! (*c1)->isSelected()) {
+                if ((*node)->isNodeChild(children[c]) && ! children[c]->isSelected()) {
                     
-                    // distract siblings
-                    for (NodeIt c2 = (*node)->children.begin(); c2 != (*node)->children.end(); ++c2) {
-                        if ((*node)->isNodeChild(*c2) && ! (*c2)->isSelected() && (*c1) != (*c2)) {
-                            (*c1)->distract(*c2);
-                        }
-                    }
+                    // angle
+                    Vec2s d = children[c]->body->pos - p;
+                    orbit.push_back(make_pair((float)atan2(d.y, d.x), c));
                     
                     // sphere repulsion
-                    float dist = (*node)->pos.distance((*c1)->pos);
+                    float dist = d.length();
                     if (dist < smin) {
-                        (*c1)->repulse((*node)->pos, smin, 1);
+                        children[c]->repulse(p, smin, 1);
                     }
                     else if (dist > smax) {
-                        (*c1)->repulse((*node)->pos, smax, -1);
+                        children[c]->repulse(p, smax, -1);
                     }
-
                 }
-                
+            }
+            sort(orbit.begin(), orbit.end());
+            
+            // angular neighbours (wrapping around)
+            int k = orbit.size();
+            int pairs = (k > 2) ? k : k - 1;
+            for (int o = 0; o < pairs; o++) {
+                NodePtr &c1 = children[orbit[o].second];
+                NodePtr &c2 = children[orbit[(o+1) % k].second];
+                c1->distract(c2);
+                c2->distract(c1);
             }
             
         }
@@ -740,50 +1319,83 @@ Vec3d Graph::coordinates(double px, double py, double d) {
 /**
  * Creates a node.
  */
-NodePtr Graph::createNode(string nid, string type) {
+NodePtr Graph::createNode(const string &nid, const string &type) {
     GLog();
     
     // scale
     double sf = (1.0/scale);
     
-    // position
-    int b = 150*sf;
-    Vec2d np = Vec2d( ((width*sf/2.0)-b + arc4random() % (2*b)), ((height*sf/2.0)-b + arc4random() % (2*b)) );
+    // centre
+    Vec2d cp = Vec2d(width*sf/2.0, height*sf/2.0) - translate*(1.0/scale);
     
-    // rezoom
-    np -= translate*(1.0/scale);
+    // grid of the visible nodes, clearance sized cells
+    double clearance = graphPlacementClearance * dpr;
+    map< pair<int,int>, NodeVectorPtr > grid;
+    for (NodeIt node = nodes.begin(); node != nodes.end(); ++node) {
+        if ((*node)->isVisible()) {
+            grid[make_pair((int)floor((*node)->body->pos.x / clearance), (int)floor((*node)->body->pos.y / clearance))].push_back(*node);
+        }
+    }
+    
+    // pack next to the existing roots, the outermost candidate if all are taken
+    Vec2d np = cp;
+    double golden = M_PI * (3.0 - sqrt(5.0));
+    for (int c = 0; c < graphPlacementCandidates; c++) {
+        
+        // spiral
+        double r = clearance * 0.5 * sqrt((double)c);
+        Vec2d p = cp + Vec2d(r * cos(c * golden), r * sin(c * golden));
+        
+        // free (neighbouring cells only)
+        bool free = true;
+        int px = (int)floor(p.x / clearance);
+        int py = (int)floor(p.y / clearance);
+        for (int gx = -1; gx <= 1 && free; gx++) {
+            for (int gy = -1; gy <= 1 && free; gy++) {
+                map< pair<int,int>, NodeVectorPtr >::iterator cell = grid.find(make_pair(px+gx, py+gy));
+                if (cell == grid.end()) {
+                    continue;
+                }
+                for (NodeIt node = cell->second.begin(); node != cell->second.end() && free; ++node) {
+                    double d = (*node)->isActive() ? clearance : clearance * 0.5;
+                    free = (*node)->body->pos.distanceSquared(p) > d * d;
+                }
+            }
+        }
+        np = p;
+        if (free) {
+            break;
+        }
+    }
     
     // create
     return createNode(nid,type,np.x,np.y);
 }
-NodePtr Graph::createNode(string nid, string type, double x, double y) {
+NodePtr Graph::createNode(const string &nid, const string &type, double x, double y) {
     GLog();
     
+    // relayout
+    this->heat(graphHeatMutation);
+    
     // node map
     nmap.insert(make_pair(nid, nodes.size()));
     
     // node
     if (type == nodeMovie) {
-        boost::shared_ptr<NodeMovie> node(new NodeMovie(nid,x,y));
+        boost::shared_ptr<NodeMovie> node(new NodeMovie(pool,nid,x,y));
         node->sref = node;
-        node->config(conf);
-        node->defaults(dflts);
         nodes.push_back(node);
         return node;
     }
     else if (type == nodePerson) {
-        boost::shared_ptr<NodePerson> node(new NodePerson(nid,x,y));
+        boost::shared_ptr<NodePerson> node(new NodePerson(pool,nid,x,y));
         node->sref = node;
-        node->config(conf);
-        node->defaults(dflts);
         nodes.push_back(node);
         return node;
     }
     else {
-        boost::shared_ptr<Node> node(new Node(nid,x,y));
+        boost::shared_ptr<Node> node(new Node(pool,nid,x,y));
         node->sref = node;
-        node->config(conf);
-        node->defaults(dflts);
         nodes.push_back(node);
         return node;
     }
@@ -794,7 +1406,7 @@ NodePtr Graph::createNode(string nid, string type, double x, double y) {
 /**
  * Gets a node.
  */
-NodePtr Graph::getNode(string nid) {
+NodePtr Graph::getNode(const string &nid) {
     GLog();
     
     // find the key
@@ -811,41 +1423,41 @@ NodePtr Graph::getNode(string nid) {
 /**
  * Creates an edge.
  */
-EdgePtr Graph::createEdge(string eid, string type, NodePtr n1, NodePtr n2) {
+EdgePtr Graph::createEdge(const string &eid, const string &type, const NodePtr &n1, const NodePtr &n2) {
     GLog();
     
     // edge map
     emap.insert(make_pair(eid, edges.size()));
     
-    // node
+    // edge
+    EdgePtr edge;
     if (type == edgeMovie) {
-        boost::shared_ptr<Edge> edge(new EdgeMovie(eid,n1,n2));
-        edge->config(conf);
-        edge->defaults(dflts);
-        edges.push_back(edge);
-        return edge;
+        edge = EdgePtr(new EdgeMovie(eid,n1,n2));
     }
     else if (type == edgePerson) {
-        boost::shared_ptr<Edge> edge(new EdgePerson(eid,n1,n2));
-        edge->config(conf);
-        edge->defaults(dflts);
-        edges.push_back(edge);
-        return edge;
+        edge = EdgePtr(new EdgePerson(eid,n1,n2));
     }
     else {
-        boost::shared_ptr<Edge> edge(new Edge(eid,n1,n2));
-        edge->config(conf);
-        edge->defaults(dflts);
-        edges.push_back(edge);
-        return edge;
+        edge = EdgePtr(new Edge(eid,n1,n2));
     }
-
+    edges.push_back(edge);
+    
+    // adjacency
+    adjacency[n1.get()].push_back(edge);
+    adjacency[n2.get()].push_back(edge);
+    
+    // hot
+    if (n1->body->relax > 0 || n2->body->relax > 0) {
+        edge->hot = true;
+        hedges.push_back(edge);
+    }
+    return edge;
 }
 
 /**
  * Gets an edge.
  */
-EdgePtr Graph::getEdge(string nid1, string nid2) {
+EdgePtr Graph::getEdge(const string &nid1, const string &nid2) {
     GLog();
     
     // find the key
@@ -866,7 +1478,7 @@ EdgePtr Graph::getEdge(string nid1, string nid2) {
 /**
  * Creates a connection.
  */
-ConnectionPtr Graph::createConnection(string cid, string type, NodePtr n1, NodePtr n2) {
+ConnectionPtr Graph::createConnection(const string &cid, const string &type, const NodePtr &n1, const NodePtr &n2) {
     GLog();
     
     // connection map
@@ -875,15 +1487,11 @@ ConnectionPtr Graph::createConnection(string cid, string type, NodePtr n1, NodeP
     // type
     if (type == connectionRelated) {
         boost::shared_ptr<Connection> connection(new ConnectionRelated(cid,n1,n2));
-        connection->config(conf);
-        connection->defaults(dflts);
         connections.push_back(connection);
         return connection;
     }
     else {
         boost::shared_ptr<Connection> connection(new Connection(cid,n1,n2));
-        connection->config(conf);
-        connection->defaults(dflts);
         connections.push_back(connection);
         return connection;
     }
@@ -893,7 +1501,7 @@ ConnectionPtr Graph::createConnection(string cid, string type, NodePtr n1, NodeP
 /**
  * Gets a connection.
  */
-ConnectionPtr Graph::getConnection(string nid1, string nid2) {
+ConnectionPtr Graph::getConnection(const string &nid1, const string &nid2) {
     GLog();
     
     // find the key
@@ -910,13 +1518,129 @@ ConnectionPtr Graph::getConnection(string nid1, string nid2) {
     return ConnectionPtr();
 }
 
+/**
+ * Applies the credits of a loaded node in one pass. Children are looked up
+ * or created next to it, linked once and labeled; labels render when they
+ * are first drawn and jobs are translated once per batch.
+ */
+NodePtr Graph::applyBatch(const MutationBatch &batch, const GraphTranslate &job) {
+    GLog();
+    
+    // node
+    NodePtr node = this->getNode(batch.nid);
+    if (! node) {
+        return node;
+    }
+    
+    // properties
+    this->describe(node, batch);
+    
+    // capacity
+    size_t count = batch.mutations.size();
+    nodes.reserve(nodes.size() + count);
+    edges.reserve(edges.size() + count);
+    node->children.reserve(node->children.size() + count);
+    
+    // linked
+    set<string> linked;
+    for (NodeIt child = node->children.begin(); child != node->children.end(); ++child) {
+        linked.insert((*child)->nid);
+    }
+    
+    // mutations
+    map<string,string> jobs;
+    for (vector<Mutation>::const_iterator m = batch.mutations.begin(); m != batch.mutations.end(); ++m) {
+        
+        // child
+        NodePtr child = this->getNode(m->cid);
+        bool existing = child != NULL;
+        if (! existing) {
+            
+            // excluded crew
+            if (m->excluded) {
+                continue;
+            }
+            
+            // new child
+            child = this->createNode(m->cid, m->ctype, node->body->pos.x, node->body->pos.y);
+            if (! m->csubtype.empty()) {
+                child->updateType(m->csubtype);
+            }
+            if (! m->cmeta.empty()) {
+                child->updateMeta(m->cmeta);
+            }
+            child->deferLabel(m->clabel);
+        }
+        
+        // add to node
+        if (! m->excluded && linked.insert(m->cid).second) {
+            node->addChild(child);
+        }
+        
+        // edge
+        EdgePtr edge = this->getEdge(batch.nid, m->cid);
+        if (edge == NULL) {
+            edge = this->createEdge(m->eid, m->ctype, node, child);
+            edge->updateType(m->etype);
+            
+            // label
+            if (m->job && job) {
+                map<string,string>::iterator translated = jobs.find(m->elabel);
+                if (translated == jobs.end()) {
+                    translated = jobs.insert(make_pair(m->elabel, job(m->elabel))).first;
+                }
+                edge->deferLabel(translated->second);
+            }
+            else {
+                edge->deferLabel(m->elabel);
+            }
+        }
+        if (existing) {
+            edge->show();
+        }
+    }
+    
+    // loaded
+    node->loaded();
+    return node;
+}
+
+/**
+ * Applies the properties of a batch to its node, without the credits.
+ */
+void Graph::describe(const NodePtr &n, const MutationBatch &batch) {
+    GLog();
+    
+    // properties
+    if (! batch.label.empty()) {
+        n->renderLabel(batch.label);
+    }
+    if (! batch.subtype.empty()) {
+        n->updateType(batch.subtype);
+    }
+    if (! batch.meta.empty()) {
+        n->updateMeta(batch.meta);
+    }
+    if (! batch.category.empty()) {
+        n->updateCategory(batch.category);
+    }
+}
+
 
 /**
  * Removes a node.
  */
-void Graph::removeNode(string nid) {
+void Graph::removeNode(const string &nid) {
     FLog();
     
+    // abort
+    if (aborts) {
+        aborts(nid);
+    }
+    
+    // relaxation
+    this->release();
+    
     // erase from nodes
     int eraser = -1;
     int index = 0;
@@ -927,26 +1651,46 @@ void Graph::removeNode(string nid) {
         index++;
     }
     if (eraser >= 0) {
+        
+        // adjacency
+        Node *node = nodes[eraser].get();
+        map<Node*,EdgeVectorPtr>::iterator incident = adjacency.find(node);
+        if (incident != adjacency.end()) {
+            for (EdgeIt edge = incident->second.begin(); edge != incident->second.end(); ++edge) {
+                NodePtr other = (*edge)->wnode1.lock();
+                if (other.get() == node) {
+                    other = (*edge)->wnode2.lock();
+                }
+                if (other && other.get() != node) {
+                    EdgeVectorPtr &oedges = adjacency[other.get()];
+                    oedges.erase(remove(oedges.begin(), oedges.end(), *edge), oedges.end());
+                }
+            }
+            adjacency.erase(incident);
+        }
+        
+        // node
+        node->body->live = false;
         nodes.erase(nodes.begin()+eraser); 
     }
     
-    // erase from map
-    map<string,int>::iterator it = nmap.find(nid);
-    if(it != nmap.end()) {
-        nmap.erase(it);
-    }
+    // remap (indices behind the eraser shifted)
+    this->reindex();
+    
+    // relayout
+    this->heat(graphHeatMutation);
 }
 
 
 /**
  * Prepares the graph for loading.
  */
-void Graph::load(NodePtr n) {
+void Graph::load(const NodePtr &n) {
     FLog();
     
     // scale
     float sf = (1.0/scale);
-    Vec2d p = (n)->mpos + (translate * sf);
+    Vec2d p = (n)->body->mpos + (translate * sf);
     
     // bounds
     Vec2d d = Vec2d(0,0);
@@ -965,18 +1709,27 @@ void Graph::load(NodePtr n) {
     
     // move it
     this->move(d);
+    
+    // relayout
+    this->heat(graphHeatMutation);
+    this->relax(n);
 }
 
 /**
  * Unloads a node.
  */
-void Graph::unload(NodePtr n) {
+void Graph::unload(const NodePtr &n) {
     FLog();
     
     // parent
     NodePtr pp = n->parent.lock();
     if (pp) {
         
+        // abort
+        if (aborts) {
+            aborts(n->nid);
+        }
+        
         // unload
         n->unload();
     }
@@ -989,11 +1742,11 @@ void Graph::unload(NodePtr n) {
 /**
  * Indicates if a node is on stage.
  */
-bool Graph::onStage(NodePtr n) {
+bool Graph::onStage(const NodePtr &n) {
     
     // scale
     float sf = (1.0/scale);
-    Vec2d p = (n)->pos + (translate * sf);
+    Vec2d p = (n)->body->pos + (translate * sf);
     
     // borderline
     float b = 300;
@@ -1002,6 +1755,220 @@ bool Graph::onStage(NodePtr n) {
 }
 
 
+/**
+ * Rebuilds the index maps.
+ */
+void Graph::reindex() {
+    
+    // nodes
+    nmap.clear();
+    for (int n = 0; n < (int)nodes.size(); n++) {
+        nmap.insert(make_pair(nodes[n]->nid, n));
+    }
+    
+    // edges
+    emap.clear();
+    for (int e = 0; e < (int)edges.size(); e++) {
+        emap.insert(make_pair(edges[e]->eid, e));
+    }
+}
+
+
+/**
+ * Reports the physics cost and the allocations since the last report.
+ */
+void Graph::report() {
+    
+    // physics
+    if (nphysics > 0) {
+        FLog("physics %.3f ms/tick (%d nodes), %ld allocations in %d of %d frames", (tphysics / nphysics) * 1000.0, (int)nodes.size(), nalloc, falloc, nframes);
+    }
+    tphysics = 0;
+    nphysics = 0;
+    nalloc = 0;
+    falloc = 0;
+    nframes = 0;
+}
+
+/**
+ * Level of detail: update interval of a node in ticks. On screen nodes are
+ * updated every tick, nodes within the margin every few ticks, far nodes
+ * rarely.
+ */
+int Graph::detail(const NodePtr &n) {
+    
+    // always
+    if (n->isSelected() || n->isLoading() || n->body->relax > 0) {
+        return 1;
+    }
+    
+    // scale
+    float sf = (1.0/scale);
+    Vec2d p = (n)->body->pos + (translate * sf);
+    
+    // distance off screen
+    double dx = max(max(-p.x, p.x - width*sf), 0.0);
+    double dy = max(max(-p.y, p.y - height*sf), 0.0);
+    double off = max(dx, dy) * scale;
+    
+    // interval
+    if (off <= 0) {
+        return 1;
+    }
+    return (off < graphLodMargin) ? graphLodNear : graphLodFar;
+}
+
+
+/**
+ * Posts a command for the next update, from any thread. The command is
+ * taken, it is left empty.
+ */
+void Graph::post(GraphCommand &c) {
+    commands->push(c);
+}
+
+/**
+ * Applies posted commands until the frame budget is spent, at least one
+ * per frame so a backlog always drains.
+ */
+void Graph::drain() {
+    
+    // budget
+    double start = ci::app::getElapsedSeconds();
+    
+    // commands
+    GraphCommand command;
+    int applied = 0;
+    while ((applied == 0 || ci::app::getElapsedSeconds() - start < mbudget) && commands->pop(command)) {
+        this->apply(command);
+        applied++;
+    }
+}
+
+/**
+ * Applies a command.
+ */
+void Graph::apply(const GraphCommand &c) {
+    GLog();
+    
+    // action
+    switch (c.action) {
+        
+        // create
+        case graphCreate: {
+            NodePtr node = this->getNode(c.nid);
+            if (! node) {
+                node = c.positioned ? this->createNode(c.nid, c.type, c.x, c.y) : this->createNode(c.nid, c.type);
+                if (! c.subtype.empty()) {
+                    node->updateType(c.subtype);
+                }
+                if (! c.label.empty()) {
+                    node->deferLabel(c.label);
+                }
+            }
+            break;
+        }
+        
+        // link
+        case graphLink: {
+            NodePtr parent = this->getNode(c.nid);
+            NodePtr child = this->getNode(c.cid);
+            if (parent && child && ! this->getEdge(c.nid, c.cid)) {
+                EdgePtr edge = this->createEdge(c.nid + "_edge_" + c.cid, c.type, parent, child);
+                if (! c.subtype.empty()) {
+                    edge->updateType(c.subtype);
+                }
+                edge->deferLabel(c.label);
+                if (find(parent->children.begin(), parent->children.end(), child) == parent->children.end()) {
+                    parent->addChild(child);
+                }
+            }
+            break;
+        }
+        
+        // label
+        case graphLabel: {
+            NodePtr node = this->getNode(c.nid);
+            if (node) {
+                node->deferLabel(c.label);
+            }
+            break;
+        }
+        
+        // load
+        case graphLoad: {
+            NodePtr node = this->getNode(c.nid);
+            if (node && ! node->isLoading()) {
+                node->load();
+                this->load(node);
+            }
+            break;
+        }
+        
+        // unload
+        case graphUnload: {
+            NodePtr node = this->getNode(c.nid);
+            if (node) {
+                this->unload(node);
+            }
+            break;
+        }
+        
+        // remove
+        case graphRemove:
+            if (this->getNode(c.nid)) {
+                this->removeNode(c.nid);
+            }
+            break;
+        
+        // batch
+        case graphBatch:
+            this->applyBatch(c.batch, c.job);
+            break;
+        
+        // describe
+        case graphDescribe: {
+            NodePtr node = this->getNode(c.batch.nid);
+            if (node) {
+                this->describe(node, c.batch);
+            }
+            break;
+        }
+    }
+}
+
+
+/**
+ * Visible children of the active nodes that are not loaded yet, with their
+ * billing position and screen distance to the touch.
+ */
+void Graph::candidates(Vec2d tpos, vector<PrefetchCandidate> &cands) {
+    
+    // zoomed
+    Vec2d ztpos = (tpos - translate)*(1.0/scale);
+    
+    // children
+    cands.clear();
+    for (NodeIt node = nodes.begin(); node != nodes.end(); ++node) {
+        if (! (*node)->isActive()) {
+            continue;
+        }
+        for (int c = 0; c < (int)(*node)->children.size(); c++) {
+            NodePtr child = (*node)->children[c];
+            if (child->isVisible() && ! child->isClustered() && ! child->isActive() && ! child->isLoading()) {
+                PrefetchCandidate cand;
+                cand.nid = child->nid;
+                cand.type = child->type;
+                cand.order = c;
+                cand.distance = child->body->pos.distance(ztpos) * scale;
+                cand.score = 0;
+                cands.push_back(cand);
+            }
+        }
+    }
+}
+
+
 /**
  * Sets the tooltip.
  */
@@ -1010,7 +1977,7 @@ void Graph::tooltip(int tid) {
     
     // selected edges
     bool etouch = false;
-    vector<string> txts = vector<string>();
+    ArenaStrings txts;
     for (EdgeIt edge = edges.begin(); edge != edges.end(); ++edge) {
         
         // touched
@@ -1023,7 +1990,7 @@ void Graph::tooltip(int tid) {
     // touched
     if (etouch) {
         tooltips[tid].renderText(txts);
-        tooltips[tid].offset((touched[tid]->radius+12.0*dpr));
+        tooltips[tid].offset((touched[tid]->body->radius+12.0*dpr));
         tooltips[tid].show();
     }
     
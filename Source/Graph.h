@@ -34,8 +34,15 @@
 #include "Configuration.h"
 #include "Defaults.h"
 #include "I18N.h"
+#include "Multilevel.h"
+#include "Field.h"
+#include "Alloc.h"
+#include "Mutation.h"
+#include "Queue.h"
+#include <boost/function.hpp>
 #include <vector>
 #include <map>
+#include <set>
 
 
 
@@ -44,6 +51,103 @@ using namespace ci;
 using namespace ci::app;
 using namespace std;
 
+// declarations
+struct PrefetchCandidate;
+
+// typedef
+typedef boost::function<string(const string&)> GraphTranslate;
+typedef boost::function<void(const string&)> GraphAbort;
+
+
+// timestep
+const double graphTimestep = 1.0/60.0;
+const double graphElapsedMax = 0.25;
+const int graphStepsMax = 4;
+const int graphSubstepsMax = 8;
+
+// cooling
+const double graphTemperatureMin = 0.1;
+const double graphTemperatureMax = 1.0;
+const double graphCooling = 0.985;
+const double graphHeatMutation = 0.6;
+const double graphHeatDrag = 0.3;
+const double graphEnergySettled = 64.0;
+const int graphSettleTicks = 30;
+
+// placement
+const float graphPlacementClearance = 320;
+const int graphPlacementCandidates = 240;
+
+// engines
+const string graphEngineFlat = "flat";
+const string graphEngineMultilevel = "multilevel";
+const int graphMultilevelNodesMin = 64;
+
+// level of detail (update interval in ticks)
+const float graphLodMargin = 300;
+const int graphLodNear = 4;
+const int graphLodFar = 16;
+
+// report
+const int graphReportTicks = 600;
+
+// relaxation
+const int graphRelaxHops = 2;
+const float graphRelaxRadius = 600;
+const int graphRelaxTicks = 240;
+const int graphRelaxCold = 8;
+const int graphRelaxNodesMin = 120;
+
+// commands (budget in seconds per frame)
+const double graphMutationBudget = 0.004;
+
+
+/**
+ * Graph Command.
+ * A mutation posted from any thread and applied at the start of the next
+ * update. Create makes node nid of type at x/y if positioned, link adds an
+ * edge of type/subtype from nid to cid; label, load, unload and remove act
+ * on nid, batch applies the mutation batch with the job translation.
+ */
+enum GraphAction {
+    graphCreate,
+    graphLink,
+    graphLabel,
+    graphLoad,
+    graphUnload,
+    graphRemove,
+    graphBatch,
+    graphDescribe
+};
+struct GraphCommand {
+    GraphCommand() : action(graphCreate), x(0), y(0), positioned(false) {}
+    GraphAction action;
+    string nid;
+    string cid;
+    string type;
+    string subtype;
+    string label;
+    double x;
+    double y;
+    bool positioned;
+    MutationBatch batch;
+    GraphTranslate job;
+    void swap(GraphCommand &c) {
+        std::swap(action, c.action);
+        nid.swap(c.nid);
+        cid.swap(c.cid);
+        type.swap(c.type);
+        subtype.swap(c.subtype);
+        label.swap(c.label);
+        std::swap(x, c.x);
+        std::swap(y, c.y);
+        std::swap(positioned, c.positioned);
+        batch.swap(c.batch);
+        job.swap(c.job);
+    }
+};
+typedef Queue<GraphCommand> GraphQueue;
+
 
 /**
  * Graph.
@@ -59,16 +163,32 @@ class Graph {
 
     // Cinder
     void resize(int w, int h, int o);
-    void config(Configuration c);
-    void defaults(Defaults d);
-    void i18n(I18N tls);
+    void config(const Configuration &c);
+    void defaults(const Defaults &d);
+    void i18n(const I18N &tls);
+    void abort(const GraphAbort &a);
     
     
     // Sketch
     void reset();
     void update();
+    void step(double dt);
     void draw();
     
+    // Layout
+    void heat(double h);
+    void cool();
+    void relax(const NodePtr &n);
+    void relax(const NodeVectorPtr &seeds);
+    void warm(const NodePtr &n);
+    void release();
+    void multilevel();
+    void reindex();
+    void report();
+    double layoutEnergy();
+    double layoutTemperature();
+    bool isSettled();
+    
     // Touch
 	NodePtr touchBegan(Vec2d tpos, int tid);
     void touchMoved(Vec2d tpos, Vec2d ppos, int tid);
@@ -83,26 +203,36 @@ class Graph {
     
     // Business
     void attract();
+    void gather(Field &f, int s, bool receives);
     void repulse();
     void subnodes();
     void move(Vec2d d);
     void drag(Vec2d d);
     void shift(Vec2d d);
     Vec3d coordinates(double px, double py, double d);
-    NodePtr createNode(string nid, string type);
-    NodePtr createNode(string nid, string type, double x, double y);
-    NodePtr getNode(string nid);
-    EdgePtr createEdge(string eid, string type, NodePtr n1, NodePtr n2);
-    EdgePtr getEdge(string nid1, string nid2);
-    ConnectionPtr createConnection(string cid, string type, NodePtr n1, NodePtr n2);
-    ConnectionPtr getConnection(string nid1, string nid2);
-    void removeNode(string nid);
-    void load(NodePtr n);
-    void unload(NodePtr n);
-    bool onStage(NodePtr n);
+    NodePtr createNode(const string &nid, const string &type);
+    NodePtr createNode(const string &nid, const string &type, double x, double y);
+    NodePtr getNode(const string &nid);
+    EdgePtr createEdge(const string &eid, const string &type, const NodePtr &n1, const NodePtr &n2);
+    EdgePtr getEdge(const string &nid1, const string &nid2);
+    ConnectionPtr createConnection(const string &cid, const string &type, const NodePtr &n1, const NodePtr &n2);
+    ConnectionPtr getConnection(const string &nid1, const string &nid2);
+    NodePtr applyBatch(const MutationBatch &batch, const GraphTranslate &job);
+    void describe(const NodePtr &n, const MutationBatch &batch);
+    void removeNode(const string &nid);
+    void load(const NodePtr &n);
+    void unload(const NodePtr &n);
+    bool onStage(const NodePtr &n);
+    int detail(const NodePtr &n);
+    void candidates(Vec2d tpos, vector<PrefetchCandidate> &cands);
     void tooltip(int tid);
     void action(int tid);
     
+    // Commands
+    void post(GraphCommand &c);
+    void drain();
+    void apply(const GraphCommand &c);
+    
     
     // private
     private:
@@ -119,11 +249,56 @@ class Graph {
     float harea;
     bool layout_nodes, layout_subnodes;
     
+    // timestep
+    double tstep;
+    double taccum;
+    double tlast;
+    int substeps;
+    int ticks;
+    
+    // cooling
+    double energy;
+    double penergy;
+    double temperature;
+    int calm;
+    int theat;
+    bool settled;
+    
+    // relaxation
+    bool localized;
+    bool frozen;
+    NodeVectorPtr hnodes;
+    EdgeVectorPtr hedges;
+    NodeVectorPtr mseeds;
+    map<Node*,EdgeVectorPtr> adjacency;
+    
+    // orbits
+    vector< pair<float,int> > orbit;
+    
+    // engine
+    string engine;
+    bool remodel;
+    Multilevel mlayout;
+    
+    // attraction
+    Field field;
+    Field hfield;
+    vector<int> fhits;
+    Vec2s fshift;
+    
+    // report
+    double tphysics;
+    int nphysics;
+    long nalloc;
+    int falloc;
+    int nframes;
+    
     // background
     gl::Texture bg_portrait, bg_landscape;
     
     
     // data
+    NodePoolPtr pool;
     NodeVectorPtr nodes;
     EdgeVectorPtr edges;
     ConnectionVectorPtr connections;
@@ -168,5 +343,12 @@ class Graph {
     // translations
     I18N translations;
     
+    // aborts pending loads
+    GraphAbort aborts;
+    
+    // commands
+    boost::shared_ptr<GraphQueue> commands;
+    double mbudget;
+    
 };
 
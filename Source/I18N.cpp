@@ -39,16 +39,18 @@ I18N::I18N() {
 
 /**
  * Set/get default.
+ * The translation is returned from the table without a copy, a missing
+ * one returns def, which has to outlive the reference.
  */
-void I18N::setTranslation(string key, string value) {
+void I18N::setTranslation(const string &key, const string &value) {
     
     // add
     translations.insert(make_pair(key, value));
 }
-string I18N::getTranslation(string key, string def) {
+const string& I18N::getTranslation(const string &key, const string &def) const {
     
     // search
-    map<string,string>::iterator it = translations.find(key);
+    map<string,string>::const_iterator it = translations.find(key);
     if(it != translations.end()) {
         return it->second;
     }
@@ -62,7 +64,7 @@ string I18N::getTranslation(string key, string def) {
 /**
  * Translates.
  */
-string I18N::translate(string msg, string key, string value) {
+string I18N::translate(string msg, const string &key, const string &value) {
     
     // search
     string term = this->getTranslation(key, value);
@@ -47,9 +47,9 @@ class I18N {
     I18N();
     
     // Accessors
-    void setTranslation(string key, string value);
-    string getTranslation(string key, string def);
-    string translate(string msg, string key, string value);
+    void setTranslation(const string &key, const string &value);
+    const string& getTranslation(const string &key, const string &def) const;
+    string translate(string msg, const string &key, const string &value);
     
     // private
 private:
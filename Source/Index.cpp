@@ -0,0 +1,391 @@
+//
+//  Index.cpp
+//  Solyaris
+//
+//  Created by CNPP on 19.10.2026.
+//  Copyright 2026 Beat Raess. All rights reserved.
+//
+//  This file is part of Solyaris.
+//
+//  Solyaris is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  Solyaris is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with Solyaris.  If not, see www.gnu.org/licenses/.
+
+#include "Index.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+
+
+#pragma mark -
+#pragma mark Strings
+
+/**
+ * Creates the table with the empty string.
+ */
+Strings::Strings() {
+    this->clear();
+}
+
+/**
+ * Id of a string, new strings are appended.
+ */
+int Strings::intern(const string &s) {
+    boost::unordered_map<string,int>::const_iterator it = ids.find(s);
+    if (it != ids.end()) {
+        return it->second;
+    }
+    int sid = values.size();
+    values.push_back(s);
+    ids[s] = sid;
+    return sid;
+}
+
+/**
+ * String of an id.
+ */
+const string& Strings::get(int sid) const {
+    return values[sid];
+}
+
+/**
+ * Drops all but the empty string.
+ */
+void Strings::clear() {
+    values.assign(1, string());
+    ids.clear();
+    ids[string()] = 0;
+}
+
+/**
+ * Interned strings.
+ */
+size_t Strings::size() const {
+    return values.size();
+}
+
+
+#pragma mark -
+#pragma mark Object
+
+/**
+ * Creates an empty index.
+ */
+Index::Index() {
+    this->clear();
+}
+
+
+#pragma mark -
+#pragma mark Business
+
+/**
+ * Appends the credits of a movie or person, known pairs are updated.
+ */
+void Index::append(const string &type, int id, const vector<Credit> &credits) {
+    bool movie = (type == creditMovie);
+
+    // credits
+    for (vector<Credit>::const_iterator c = credits.begin(); c != credits.end(); ++c) {
+        int mid = movie ? id : c->id;
+        int pid = movie ? c->id : id;
+        int year = atoi(c->year.c_str());
+
+        // name
+        if (movie) {
+            names[pid] = strings.intern(c->name);
+        }
+        else {
+            titles[mid] = strings.intern(c->name);
+        }
+
+        // known
+        uint64_t key = ((uint64_t)(uint32_t)mid << 32) | (uint32_t)pid;
+        boost::unordered_map<uint64_t,int>::const_iterator it = pairs.find(key);
+        if (it != pairs.end()) {
+            IndexCredit &r = records[it->second];
+            r.type = c->type.empty() ? r.type : strings.intern(c->type);
+            r.character = c->character.empty() ? r.character : strings.intern(c->character);
+            r.job = c->job.empty() ? r.job : strings.intern(c->job);
+            if (movie && r.order != c->order) {
+                r.order = c->order;
+                this->sort(movies, true, mid);
+            }
+            if (year && r.year != year) {
+                r.year = year;
+                this->sort(persons, false, pid);
+            }
+            continue;
+        }
+
+        // new
+        IndexCredit r;
+        r.mid = mid;
+        r.pid = pid;
+        r.type = strings.intern(c->type);
+        r.character = strings.intern(c->character);
+        r.job = strings.intern(c->job);
+        r.order = c->order;
+        r.year = year;
+        int entry = records.size();
+        records.push_back(r);
+        pairs[key] = entry;
+        this->insert(movies, true, mid, entry);
+        this->insert(persons, false, pid, entry);
+    }
+
+    // fold
+    if (movies.pending + persons.pending > max(indexCompact, records.size() / 2)) {
+        this->compact();
+    }
+}
+
+/**
+ * Sorted credits of a movie or person, with the names of the other side.
+ */
+int Index::credits(const string &type, int id, vector<Credit> &credits) const {
+    bool movie = (type == creditMovie);
+
+    // row
+    this->row(movie ? movies : persons, movie, id, scratch);
+    credits.resize(scratch.size());
+
+    // credits
+    char year[16];
+    for (size_t i = 0; i < scratch.size(); i++) {
+        const IndexCredit &r = records[scratch[i]];
+        Credit &c = credits[i];
+        c.id = movie ? r.pid : r.mid;
+        c.name = this->name(movie ? creditPerson : creditMovie, c.id);
+        c.type = strings.get(r.type);
+        c.character = strings.get(r.character);
+        c.department.clear();
+        c.job = strings.get(r.job);
+        c.order = r.order;
+        if (r.year) {
+            snprintf(year, sizeof(year), "%d", r.year);
+            c.year = year;
+        }
+        else {
+            c.year.clear();
+        }
+    }
+    return credits.size();
+}
+
+/**
+ * Sorted raw credits of a movie or person.
+ */
+int Index::lookup(const string &type, int id, vector<IndexCredit> &credits) const {
+    bool movie = (type == creditMovie);
+    this->row(movie ? movies : persons, movie, id, scratch);
+    credits.resize(scratch.size());
+    for (size_t i = 0; i < scratch.size(); i++) {
+        credits[i] = records[scratch[i]];
+    }
+    return credits.size();
+}
+
+/**
+ * Credits of the node are indexed.
+ */
+bool Index::contains(const string &type, int id) const {
+    const IndexRows &rows = (type == creditMovie) ? movies : persons;
+    return binary_search(rows.keys.begin(), rows.keys.end(), id) || rows.delta.find(id) != rows.delta.end();
+}
+
+/**
+ * Folds the delta rows into the sparse rows.
+ */
+void Index::compact() {
+    this->build(movies, true);
+    this->build(persons, false);
+}
+
+/**
+ * Empties the index.
+ */
+void Index::clear() {
+    strings.clear();
+    records.clear();
+    pairs.clear();
+    titles.clear();
+    names.clear();
+    IndexRows empty;
+    empty.offsets.push_back(0);
+    empty.pending = 0;
+    movies = empty;
+    persons = empty;
+}
+
+
+#pragma mark -
+#pragma mark Accessors
+
+/**
+ * Title of a movie or name of a person.
+ */
+const string& Index::name(const string &type, int id) const {
+    const boost::unordered_map<int,int> &table = (type == creditMovie) ? titles : names;
+    boost::unordered_map<int,int>::const_iterator it = table.find(id);
+    return strings.get(it != table.end() ? it->second : 0);
+}
+
+/**
+ * Interned string.
+ */
+const string& Index::text(int sid) const {
+    return strings.get(sid);
+}
+
+/**
+ * Indexed credits.
+ */
+size_t Index::size() const {
+    return records.size();
+}
+
+/**
+ * Approximate footprint of the records and rows.
+ */
+size_t Index::bytes() const {
+    size_t b = records.capacity() * sizeof(IndexCredit);
+    b += (movies.keys.capacity() + movies.offsets.capacity() + movies.entries.capacity()) * sizeof(int);
+    b += (persons.keys.capacity() + persons.offsets.capacity() + persons.entries.capacity()) * sizeof(int);
+    b += (movies.pending + persons.pending) * sizeof(int);
+    return b;
+}
+
+
+#pragma mark -
+#pragma mark Helpers
+
+/**
+ * Movie rows by billing order, person rows latest first.
+ */
+bool Index::Order::operator()(int a, int b) const {
+    const IndexCredit &ra = (*records)[a];
+    const IndexCredit &rb = (*records)[b];
+    if (movie) {
+        return ra.order < rb.order || (ra.order == rb.order && a < b);
+    }
+    return ra.year > rb.year || (ra.year == rb.year && a < b);
+}
+
+/**
+ * Inserts an entry into its sorted delta row.
+ */
+void Index::insert(IndexRows &rows, bool movie, int key, int entry) {
+    vector<int> &d = rows.delta[key];
+    d.insert(upper_bound(d.begin(), d.end(), entry, this->order(movie)), entry);
+    rows.pending++;
+}
+
+/**
+ * Restores the order of a row after a credit changed.
+ */
+void Index::sort(IndexRows &rows, bool movie, int key) {
+
+    // sparse
+    vector<int>::iterator k = lower_bound(rows.keys.begin(), rows.keys.end(), key);
+    if (k != rows.keys.end() && *k == key) {
+        int r = k - rows.keys.begin();
+        std::sort(rows.entries.begin() + rows.offsets[r], rows.entries.begin() + rows.offsets[r+1], this->order(movie));
+    }
+
+    // delta
+    map< int, vector<int> >::iterator d = rows.delta.find(key);
+    if (d != rows.delta.end()) {
+        std::sort(d->second.begin(), d->second.end(), this->order(movie));
+    }
+}
+
+/**
+ * Sparse row merged with its delta row.
+ */
+void Index::row(const IndexRows &rows, bool movie, int key, vector<int> &entries) const {
+    entries.clear();
+
+    // sparse
+    const int *first = NULL;
+    const int *last = NULL;
+    vector<int>::const_iterator k = lower_bound(rows.keys.begin(), rows.keys.end(), key);
+    if (k != rows.keys.end() && *k == key) {
+        int r = k - rows.keys.begin();
+        first = &rows.entries[0] + rows.offsets[r];
+        last = &rows.entries[0] + rows.offsets[r+1];
+    }
+
+    // delta
+    map< int, vector<int> >::const_iterator d = rows.delta.find(key);
+    if (d == rows.delta.end()) {
+        entries.assign(first, last);
+    }
+    else {
+        entries.resize((last - first) + d->second.size());
+        merge(first, last, d->second.begin(), d->second.end(), entries.begin(), this->order(movie));
+    }
+}
+
+/**
+ * Rebuilds the sparse rows with the delta rows folded in.
+ */
+void Index::build(IndexRows &rows, bool movie) {
+    if (rows.delta.empty()) {
+        return;
+    }
+
+    // keys
+    vector<int> keys;
+    keys.reserve(rows.keys.size() + rows.delta.size());
+    vector<int>::iterator k = rows.keys.begin();
+    for (map< int, vector<int> >::const_iterator d = rows.delta.begin(); d != rows.delta.end(); ++d) {
+        while (k != rows.keys.end() && *k < d->first) {
+            keys.push_back(*k++);
+        }
+        if (k != rows.keys.end() && *k == d->first) {
+            k++;
+        }
+        keys.push_back(d->first);
+    }
+    keys.insert(keys.end(), k, rows.keys.end());
+
+    // rows
+    vector<int> offsets;
+    vector<int> entries;
+    offsets.reserve(keys.size() + 1);
+    entries.reserve(rows.entries.size() + rows.pending);
+    offsets.push_back(0);
+    vector<int> r;
+    for (vector<int>::const_iterator key = keys.begin(); key != keys.end(); ++key) {
+        this->row(rows, movie, *key, r);
+        entries.insert(entries.end(), r.begin(), r.end());
+        offsets.push_back(entries.size());
+    }
+
+    // swap
+    rows.keys.swap(keys);
+    rows.offsets.swap(offsets);
+    rows.entries.swap(entries);
+    rows.delta.clear();
+    rows.pending = 0;
+}
+
+/**
+ * Row order on the records.
+ */
+Index::Order Index::order(bool movie) const {
+    Order o;
+    o.records = &records;
+    o.movie = movie;
+    return o;
+}
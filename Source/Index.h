@@ -0,0 +1,158 @@
+//
+//  Index.h
+//  Solyaris
+//
+//  Created by CNPP on 19.10.2026.
+//  Copyright 2026 Beat Raess. All rights reserved.
+//
+//  This file is part of Solyaris.
+//
+//  Solyaris is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  Solyaris is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with Solyaris.  If not, see www.gnu.org/licenses/.
+
+
+#pragma once
+#include "Credits.h"
+#include <boost/unordered_map.hpp>
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include <map>
+
+
+// namespace
+using namespace std;
+
+// constants
+const size_t indexCompact = 4096;
+
+
+/**
+ * Strings.
+ * Interns strings to dense ids, 0 is the empty string.
+ */
+class Strings {
+
+    // public
+    public:
+
+    // Strings
+    Strings();
+
+    // Business
+    int intern(const string &s);
+    const string& get(int sid) const;
+    void clear();
+    size_t size() const;
+
+
+    // private
+    private:
+
+    // Strings
+    vector<string> values;
+    boost::unordered_map<string,int> ids;
+
+};
+
+
+/**
+ * Index Credit.
+ * Movie2Person with interned strings.
+ */
+struct IndexCredit {
+    int mid;
+    int pid;
+    int type;
+    int character;
+    int job;
+    int order;
+    int year;
+};
+
+/**
+ * Index Rows.
+ * Compressed sparse rows of credit indices plus the rows appended since
+ * the last compaction.
+ */
+struct IndexRows {
+    vector<int> keys;
+    vector<int> offsets;
+    vector<int> entries;
+    map< int, vector<int> > delta;
+    size_t pending;
+};
+
+
+/**
+ * Credits Index.
+ * Both directions of the credits as compressed sparse rows, movie rows in
+ * billing order and person rows latest first. New credits are appended to
+ * sorted delta rows that are merged on lookup and folded into the CSR
+ * arrays once enough of them piled up.
+ */
+class Index {
+
+    // public
+    public:
+
+    // Index
+    Index();
+
+    // Business
+    void append(const string &type, int id, const vector<Credit> &credits);
+    int credits(const string &type, int id, vector<Credit> &credits) const;
+    int lookup(const string &type, int id, vector<IndexCredit> &credits) const;
+    bool contains(const string &type, int id) const;
+    void compact();
+    void clear();
+
+    // Accessors
+    const string& name(const string &type, int id) const;
+    const string& text(int sid) const;
+    size_t size() const;
+    size_t bytes() const;
+
+
+    // private
+    private:
+
+    // Order
+    struct Order {
+        const vector<IndexCredit> *records;
+        bool movie;
+        bool operator()(int a, int b) const;
+    };
+
+    // Helpers
+    void insert(IndexRows &rows, bool movie, int key, int entry);
+    void sort(IndexRows &rows, bool movie, int key);
+    void row(const IndexRows &rows, bool movie, int key, vector<int> &entries) const;
+    void build(IndexRows &rows, bool movie);
+    Order order(bool movie) const;
+
+    // Credits
+    Strings strings;
+    vector<IndexCredit> records;
+    boost::unordered_map<uint64_t,int> pairs;
+    boost::unordered_map<int,int> titles;
+    boost::unordered_map<int,int> names;
+
+    // Rows
+    IndexRows movies;
+    IndexRows persons;
+
+    // Scratch
+    mutable vector<int> scratch;
+
+};
@@ -0,0 +1,517 @@
+//
+//  Json.cpp
+//  Solyaris
+//
+//  Created by CNPP on 19.10.2026.
+//  Copyright 2026 Beat Raess. All rights reserved.
+//
+//  This file is part of Solyaris.
+//
+//  Solyaris is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  Solyaris is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with Solyaris.  If not, see www.gnu.org/licenses/.
+
+#include "Json.h"
+#include <cstdio>
+#include <cstdlib>
+
+
+#pragma mark -
+#pragma mark Object
+
+/**
+ * Creates a parser reporting to the handler.
+ */
+Json::Json(JsonHandler *h) {
+    handler = h;
+    this->reset();
+}
+
+
+#pragma mark -
+#pragma mark Business
+
+/**
+ * Feeds the next chunk of the document.
+ */
+bool Json::feed(const char *data, size_t length) {
+
+    // failed
+    if (state == stateError) {
+        return false;
+    }
+
+    // characters
+    for (size_t i = 0; i < length; i++) {
+
+        // plain run of a string in one go
+        if (lex == lexString && ! surrogate) {
+            size_t j = i;
+            while (j < length && data[j] != '"' && data[j] != '\\' && (unsigned char)data[j] >= 0x20) {
+                j++;
+            }
+            token.append(data + i, j - i);
+            position += j - i;
+            i = j;
+            if (i == length) {
+                break;
+            }
+        }
+
+        // character
+        if (! this->character(data[i])) {
+            return false;
+        }
+        position++;
+    }
+    return true;
+}
+
+/**
+ * Ends the document, flushes a trailing number.
+ */
+bool Json::finish() {
+
+    // failed
+    if (state == stateError) {
+        return false;
+    }
+
+    // pending
+    if (lex == lexNumber && ! this->emitNumber()) {
+        return false;
+    }
+    if (lex == lexLiteral && ! this->emitLiteral()) {
+        return false;
+    }
+    if (lex != lexNone) {
+        return this->fail("unterminated string");
+    }
+
+    // complete
+    if (state != stateDone) {
+        return this->fail("unexpected end");
+    }
+    return true;
+}
+
+/**
+ * Resets the parser for the next document.
+ */
+void Json::reset() {
+    state = stateValue;
+    lex = lexNone;
+    keyed = false;
+    stack.clear();
+    token.clear();
+    hex = 0;
+    nhex = 0;
+    surrogate = 0;
+    position = 0;
+    err.clear();
+}
+
+
+#pragma mark -
+#pragma mark Accessors
+
+/**
+ * Parse failed.
+ */
+bool Json::failed() const {
+    return state == stateError;
+}
+
+/**
+ * Error message.
+ */
+const string& Json::error() const {
+    return err;
+}
+
+/**
+ * Bytes consumed.
+ */
+size_t Json::offset() const {
+    return position;
+}
+
+
+#pragma mark -
+#pragma mark Helpers
+
+/**
+ * Consumes a character, tokens first.
+ */
+bool Json::character(char c) {
+
+    // lexeme
+    switch (lex) {
+
+        // string
+        case lexString:
+            if (c == '"') {
+                this->lone();
+                lex = lexNone;
+                this->emitString();
+                return true;
+            }
+            if (c == '\\') {
+                lex = lexEscape;
+                return true;
+            }
+            if ((unsigned char)c < 0x20) {
+                return this->fail("control character in string");
+            }
+            this->lone();
+            token += c;
+            return true;
+
+        // escape
+        case lexEscape:
+            return this->escape(c);
+
+        // unicode
+        case lexUnicode:
+            return this->unicode(c);
+
+        // number
+        case lexNumber:
+            if ((c >= '0' && c <= '9') || c == '.' || c == 'e' || c == 'E' || c == '+' || c == '-') {
+                token += c;
+                return true;
+            }
+            if (! this->emitNumber()) {
+                return false;
+            }
+            break;
+
+        // literal
+        case lexLiteral:
+            if (c >= 'a' && c <= 'z') {
+                token += c;
+                return true;
+            }
+            if (! this->emitLiteral()) {
+                return false;
+            }
+            break;
+
+        // none
+        default:
+            break;
+    }
+
+    // structure
+    return this->structural(c);
+}
+
+/**
+ * Consumes a structural character.
+ */
+bool Json::structural(char c) {
+
+    // whitespace
+    if (c == ' ' || c == '\t' || c == '\n' || c == '\r') {
+        return true;
+    }
+
+    // state
+    switch (state) {
+
+        // colon
+        case stateColon:
+            if (c == ':') {
+                state = stateValue;
+                return true;
+            }
+            return this->fail("expected ':'");
+
+        // comma or end
+        case stateCommaOrEnd:
+            if (c == ',') {
+                state = (stack.back() == '{') ? stateKey : stateValue;
+                return true;
+            }
+            if (c == '}' && stack.back() == '{') {
+                stack.pop_back();
+                handler->objectEnd();
+                this->value();
+                return true;
+            }
+            if (c == ']' && stack.back() == '[') {
+                stack.pop_back();
+                handler->arrayEnd();
+                this->value();
+                return true;
+            }
+            return this->fail("expected ',' or end of container");
+
+        // key or end
+        case stateKeyOrEnd:
+            if (c == '}') {
+                stack.pop_back();
+                handler->objectEnd();
+                this->value();
+                return true;
+            }
+            // fall through
+
+        // key
+        case stateKey:
+            if (c == '"') {
+                lex = lexString;
+                keyed = true;
+                token.clear();
+                return true;
+            }
+            return this->fail("expected key");
+
+        // value or end
+        case stateValueOrEnd:
+            if (c == ']') {
+                stack.pop_back();
+                handler->arrayEnd();
+                this->value();
+                return true;
+            }
+            // fall through
+
+        // value
+        case stateValue:
+            if (c == '{' || c == '[') {
+                if ((int)stack.size() >= jsonDepth) {
+                    return this->fail("nesting too deep");
+                }
+                stack.push_back(c);
+                if (c == '{') {
+                    handler->objectStart();
+                    state = stateKeyOrEnd;
+                }
+                else {
+                    handler->arrayStart();
+                    state = stateValueOrEnd;
+                }
+                return true;
+            }
+            if (c == '"') {
+                lex = lexString;
+                keyed = false;
+                token.clear();
+                return true;
+            }
+            if (c == '-' || (c >= '0' && c <= '9')) {
+                lex = lexNumber;
+                token.assign(1, c);
+                return true;
+            }
+            if (c >= 'a' && c <= 'z') {
+                lex = lexLiteral;
+                token.assign(1, c);
+                return true;
+            }
+            return this->fail("unexpected character");
+
+        // done
+        case stateDone:
+            return this->fail("trailing data");
+
+        // error
+        default:
+            return false;
+    }
+}
+
+/**
+ * Decodes an escape sequence.
+ */
+bool Json::escape(char c) {
+
+    // unicode
+    if (c == 'u') {
+        lex = lexUnicode;
+        hex = 0;
+        nhex = 0;
+        return true;
+    }
+
+    // simple
+    char e;
+    switch (c) {
+        case '"': e = '"'; break;
+        case '\\': e = '\\'; break;
+        case '/': e = '/'; break;
+        case 'b': e = '\b'; break;
+        case 'f': e = '\f'; break;
+        case 'n': e = '\n'; break;
+        case 'r': e = '\r'; break;
+        case 't': e = '\t'; break;
+        default: return this->fail("invalid escape");
+    }
+    this->lone();
+    token += e;
+    lex = lexString;
+    return true;
+}
+
+/**
+ * Collects a \u code unit and joins surrogate pairs.
+ */
+bool Json::unicode(char c) {
+
+    // digit
+    unsigned int d;
+    if (c >= '0' && c <= '9') {
+        d = c - '0';
+    }
+    else if (c >= 'a' && c <= 'f') {
+        d = c - 'a' + 10;
+    }
+    else if (c >= 'A' && c <= 'F') {
+        d = c - 'A' + 10;
+    }
+    else {
+        return this->fail("invalid unicode escape");
+    }
+    hex = (hex << 4) | d;
+    if (++nhex < 4) {
+        return true;
+    }
+    lex = lexString;
+
+    // high surrogate
+    if (hex >= 0xD800 && hex <= 0xDBFF) {
+        this->lone();
+        surrogate = hex;
+    }
+    // low surrogate
+    else if (hex >= 0xDC00 && hex <= 0xDFFF) {
+        if (surrogate) {
+            this->utf8(0x10000 + ((surrogate - 0xD800) << 10) + (hex - 0xDC00));
+            surrogate = 0;
+        }
+        else {
+            this->utf8(0xFFFD);
+        }
+    }
+    // plain
+    else {
+        this->lone();
+        this->utf8(hex);
+    }
+    return true;
+}
+
+/**
+ * Reports the number token.
+ */
+bool Json::emitNumber() {
+    lex = lexNone;
+
+    // parse
+    char *end;
+    double n = strtod(token.c_str(), &end);
+    if (end != token.c_str() + token.size()) {
+        return this->fail("invalid number");
+    }
+
+    // emit
+    handler->number(n);
+    this->value();
+    return true;
+}
+
+/**
+ * Reports the literal token.
+ */
+bool Json::emitLiteral() {
+    lex = lexNone;
+
+    // literal
+    if (token == "true" || token == "false") {
+        handler->boolean(token == "true");
+    }
+    else if (token == "null") {
+        handler->null();
+    }
+    else {
+        return this->fail("invalid literal");
+    }
+    this->value();
+    return true;
+}
+
+/**
+ * Reports the string token as key or value.
+ */
+void Json::emitString() {
+    if (keyed) {
+        handler->key(token);
+        state = stateColon;
+    }
+    else {
+        handler->text(token);
+        this->value();
+    }
+}
+
+/**
+ * A value is complete.
+ */
+void Json::value() {
+    state = stack.empty() ? stateDone : stateCommaOrEnd;
+}
+
+/**
+ * Replaces an unpaired high surrogate.
+ */
+void Json::lone() {
+    if (surrogate) {
+        this->utf8(0xFFFD);
+        surrogate = 0;
+    }
+}
+
+/**
+ * Appends a code point as UTF-8.
+ */
+void Json::utf8(unsigned int cp) {
+    if (cp < 0x80) {
+        token += (char)cp;
+    }
+    else if (cp < 0x800) {
+        token += (char)(0xC0 | (cp >> 6));
+        token += (char)(0x80 | (cp & 0x3F));
+    }
+    else if (cp < 0x10000) {
+        token += (char)(0xE0 | (cp >> 12));
+        token += (char)(0x80 | ((cp >> 6) & 0x3F));
+        token += (char)(0x80 | (cp & 0x3F));
+    }
+    else {
+        token += (char)(0xF0 | (cp >> 18));
+        token += (char)(0x80 | ((cp >> 12) & 0x3F));
+        token += (char)(0x80 | ((cp >> 6) & 0x3F));
+        token += (char)(0x80 | (cp & 0x3F));
+    }
+}
+
+/**
+ * Stops parsing with an error.
+ */
+bool Json::fail(const string &msg) {
+    char at[32];
+    snprintf(at, sizeof(at), " at %lu", (unsigned long)position);
+    err = msg + at;
+    state = stateError;
+    return false;
+}
@@ -0,0 +1,138 @@
+//
+//  Json.h
+//  Solyaris
+//
+//  Created by CNPP on 19.10.2026.
+//  Copyright 2026 Beat Raess. All rights reserved.
+//
+//  This file is part of Solyaris.
+//
+//  Solyaris is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  Solyaris is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with Solyaris.  If not, see www.gnu.org/licenses/.
+
+#pragma once
+#include <cstddef>
+#include <string>
+#include <vector>
+
+
+// namespace
+using namespace std;
+
+
+// constants
+const int jsonDepth = 64;
+
+
+/**
+ * Json Handler.
+ * Receives the events of the streaming parser, the defaults ignore them.
+ */
+class JsonHandler {
+
+    // public
+    public:
+
+    // JsonHandler
+    virtual ~JsonHandler() {}
+
+    // Events
+    virtual void objectStart() {}
+    virtual void objectEnd() {}
+    virtual void arrayStart() {}
+    virtual void arrayEnd() {}
+    virtual void key(const string &) {}
+    virtual void text(const string &) {}
+    virtual void number(double) {}
+    virtual void boolean(bool) {}
+    virtual void null() {}
+
+};
+
+
+/**
+ * Json.
+ * Push parser (SAX), data may be fed in arbitrary chunks as it arrives and
+ * no document is built. Escapes and \u surrogate pairs are decoded to UTF-8.
+ */
+class Json {
+
+    // public
+    public:
+
+    // Json
+    Json(JsonHandler *h);
+
+    // Business
+    bool feed(const char *data, size_t length);
+    bool finish();
+    void reset();
+
+    // Accessors
+    bool failed() const;
+    const string& error() const;
+    size_t offset() const;
+
+
+    // private
+    private:
+
+    // States
+    enum State {
+        stateValue,
+        stateValueOrEnd,
+        stateKey,
+        stateKeyOrEnd,
+        stateColon,
+        stateCommaOrEnd,
+        stateDone,
+        stateError
+    };
+    enum Lexeme {
+        lexNone,
+        lexString,
+        lexEscape,
+        lexUnicode,
+        lexNumber,
+        lexLiteral
+    };
+
+    // Helpers
+    bool character(char c);
+    bool structural(char c);
+    bool escape(char c);
+    bool unicode(char c);
+    bool emitNumber();
+    bool emitLiteral();
+    void emitString();
+    void value();
+    void lone();
+    void utf8(unsigned int cp);
+    bool fail(const string &msg);
+
+    // Handler
+    JsonHandler *handler;
+
+    // State
+    State state;
+    Lexeme lex;
+    bool keyed;
+    vector<char> stack;
+    string token;
+    unsigned int hex;
+    int nhex;
+    unsigned int surrogate;
+    size_t position;
+    string err;
+
+};
@@ -0,0 +1,114 @@
+//
+//  Layout.h
+//  Solyaris
+//
+//  Created by CNPP on 19.10.2026.
+//  Copyright 2026 Beat Raess. All rights reserved.
+//
+//  This file is part of Solyaris.
+//
+//  Solyaris is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  Solyaris is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with Solyaris.  If not, see www.gnu.org/licenses/.
+
+
+#pragma once
+#include "cinder/Vector.h"
+#include <cmath>
+#include <algorithm>
+
+
+// namespace
+using namespace ci;
+
+
+// scalar (screen pixels only need float, LAYOUT_DOUBLE for reference runs)
+#ifdef LAYOUT_DOUBLE
+typedef double Scalar;
+#else
+typedef float Scalar;
+#endif
+typedef Vec2<Scalar> Vec2s;
+
+
+/**
+ * Layout kernels, templated on the scalar type.
+ */
+template <typename T>
+struct Layout {
+    
+    /**
+     * Force of the node attraction / distraction at distance d within range.
+     */
+    static inline T attraction(T d, T range, T ramp, T strength) {
+        T s = std::pow(d / range, 1 / ramp);
+        return s * 9 * strength * (1 / (s + 1) + ((s - 3) / 4)) / d;
+    }
+    
+    /**
+     * Mass of a node of radius r.
+     */
+    static inline T mass(T r) {
+        return r * r * (T)0.0001 + (T)0.01;
+    }
+    
+    /**
+     * Weight of a body of mass m and radius r, a cluster carries the mass
+     * of its members.
+     */
+    static inline T weight(T m, T r) {
+        return m / mass(r);
+    }
+    
+    /**
+     * Spring force pulling b towards length from a.
+     */
+    static inline Vec2<T> spring(const Vec2<T> &a, const Vec2<T> &b, T length) {
+        Vec2<T> diff = b - a;
+        diff.safeNormalize();
+        return (a + diff * length) - b;
+    }
+    
+    /**
+     * Edge force on b, shared between both ends of the edge.
+     */
+    static inline Vec2<T> tension(const Vec2<T> &a, const Vec2<T> &b, T length, T stiffness, T damping) {
+        return spring(a, b, length) * ((T)0.5 * stiffness * (1 - damping));
+    }
+    
+    /**
+     * Repulsion of displacement d with weight w (Fruchterman-Reingold).
+     */
+    static inline Vec2<T> repulsion(const Vec2<T> &d, T k2, T w) {
+        T l2 = std::max(d.lengthSquared(), (T)0.01);
+        return d * (k2 * w / l2);
+    }
+    
+    /**
+     * Semi-implicit euler over t: the force moves the velocity, the velocity
+     * the target position and the position eases after it. The velocity
+     * limit is the stability clamp, a long step never moves further than
+     * vmax*t, so a node off screen integrates its skipped ticks in one step.
+     */
+    static inline void integrate(Vec2<T> &pos, Vec2<T> &mpos, Vec2<T> &velocity, const Vec2<T> &force, T t, T damping, T easing, T vmax, T vthresh) {
+        velocity += force * t;
+        velocity.limit(vmax);
+        if (std::abs(velocity.x) < vthresh && std::abs(velocity.y) < vthresh) {
+            velocity.set(0, 0);
+        }
+        velocity *= std::exp(-damping * t);
+        mpos += velocity * t;
+        pos += (mpos - pos) * (1 - std::exp(-easing * t));
+    }
+    
+};
+typedef Layout<Scalar> Kernel;
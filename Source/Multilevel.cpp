@@ -0,0 +1,300 @@
+//
+//  Multilevel.cpp
+//  Solyaris
+//
+//  Created by CNPP on 19.10.2026.
+//  Copyright 2026 Beat Raess. All rights reserved.
+//
+//  This file is part of Solyaris.
+//
+//  Solyaris is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  Solyaris is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with Solyaris.  If not, see www.gnu.org/licenses/.
+
+#include "Multilevel.h"
+
+
+#pragma mark -
+#pragma mark Object
+
+/**
+ * Creates a multilevel layout.
+ */
+template <typename T>
+MultilevelT<T>::MultilevelT() {
+}
+
+
+#pragma mark -
+#pragma mark Business
+
+/**
+ * Lays out the graph. Positions are taken as the starting layout and
+ * replaced by the result.
+ */
+template <typename T>
+void MultilevelT<T>::layout(vector< Vec2<T> > &positions, const vector< pair<int,int> > &links, T length) {
+    GLog();
+
+    // finest level
+    levels.clear();
+    levels.push_back(Level());
+    Level &finest = levels.back();
+    finest.n = positions.size();
+    finest.weights.assign(finest.n, (T)1);
+    finest.links = links;
+    finest.lweights.assign(links.size(), (T)1);
+    finest.positions = positions;
+    if (finest.n < 2) {
+        return;
+    }
+
+    // coarsen
+    while (levels.back().n > multilevelCoarsest) {
+        Level coarse;
+        if (! this->coarsen(levels.back(), coarse)) {
+            break;
+        }
+        levels.push_back(coarse);
+    }
+
+    // natural spring length per level
+    int nbl = levels.size();
+    vector<T> ks(nbl);
+    ks[0] = length;
+    for (int l = 1; l < nbl; l++) {
+        ks[l] = ks[l-1] * (T)sqrt(7.0/4.0);
+    }
+
+    // coarsest
+    this->relax(levels[nbl-1], ks[nbl-1], multilevelIterations);
+
+    // interpolate & refine
+    for (int l = nbl-2; l >= 0; l--) {
+        this->interpolate(levels[l+1], levels[l], ks[l]);
+        this->relax(levels[l], ks[l], multilevelRefinements);
+    }
+
+    // result
+    positions = levels[0].positions;
+}
+
+/**
+ * Number of levels of the last layout.
+ */
+template <typename T>
+int MultilevelT<T>::depth() {
+    return levels.size();
+}
+
+
+#pragma mark -
+#pragma mark Helpers
+
+/**
+ * Coarsens a level by heavy edge matching. The coarse positions are the
+ * weighted barycentres of their members so the current layout survives.
+ */
+template <typename T>
+bool MultilevelT<T>::coarsen(Level &fine, Level &coarse) {
+
+    // adjacency
+    vector< vector< pair<int,T> > > adjacency(fine.n);
+    for (int e = 0; e < (int)fine.links.size(); e++) {
+        int a = fine.links[e].first;
+        int b = fine.links[e].second;
+        adjacency[a].push_back(make_pair(b, fine.lweights[e]));
+        adjacency[b].push_back(make_pair(a, fine.lweights[e]));
+    }
+
+    // random visit order
+    order.resize(fine.n);
+    for (int v = 0; v < fine.n; v++) {
+        order[v] = v;
+    }
+    for (int v = fine.n-1; v > 0; v--) {
+        swap(order[v], order[Rand::randInt(v+1)]);
+    }
+
+    // match
+    fine.coarse.assign(fine.n, -1);
+    int nc = 0;
+    for (int o = 0; o < fine.n; o++) {
+        int u = order[o];
+        if (fine.coarse[u] >= 0) {
+            continue;
+        }
+
+        // heaviest unmatched neighbour, light nodes first
+        int best = -1;
+        T bw = 0;
+        for (int a = 0; a < (int)adjacency[u].size(); a++) {
+            int v = adjacency[u][a].first;
+            if (v != u && fine.coarse[v] < 0) {
+                T w = adjacency[u][a].second / (fine.weights[u] * fine.weights[v]);
+                if (w > bw) {
+                    bw = w;
+                    best = v;
+                }
+            }
+        }
+
+        // merge
+        fine.coarse[u] = nc;
+        if (best >= 0) {
+            fine.coarse[best] = nc;
+        }
+        nc++;
+    }
+
+    // no progress
+    if (nc > fine.n * multilevelReduction) {
+        return false;
+    }
+
+    // coarse nodes
+    coarse.n = nc;
+    coarse.weights.assign(nc, (T)0);
+    coarse.positions.assign(nc, Vec2<T>(0,0));
+    for (int v = 0; v < fine.n; v++) {
+        int c = fine.coarse[v];
+        coarse.weights[c] += fine.weights[v];
+        coarse.positions[c] += fine.positions[v] * fine.weights[v];
+    }
+    for (int c = 0; c < nc; c++) {
+        coarse.positions[c] /= coarse.weights[c];
+    }
+
+    // coarse links
+    map< pair<int,int>, T > merged;
+    for (int e = 0; e < (int)fine.links.size(); e++) {
+        int a = fine.coarse[fine.links[e].first];
+        int b = fine.coarse[fine.links[e].second];
+        if (a != b) {
+            merged[make_pair(min(a,b), max(a,b))] += fine.lweights[e];
+        }
+    }
+    coarse.links.clear();
+    coarse.lweights.clear();
+    for (typename map< pair<int,int>, T >::iterator it = merged.begin(); it != merged.end(); ++it) {
+        coarse.links.push_back(it->first);
+        coarse.lweights.push_back(it->second);
+    }
+    return true;
+}
+
+/**
+ * Places the fine nodes around their coarse representative.
+ */
+template <typename T>
+void MultilevelT<T>::interpolate(Level &coarse, Level &fine, T k) {
+
+    // members
+    for (int v = 0; v < fine.n; v++) {
+        Vec2<T> cp = coarse.positions[fine.coarse[v]];
+        T a = Rand::randFloat(0, 2 * M_PI);
+        fine.positions[v] = cp + Vec2<T>(cos(a), sin(a)) * (k * (T)0.25);
+    }
+}
+
+/**
+ * Force directed refinement (Fruchterman-Reingold). Repulsion uses a grid
+ * of 2k cells on larger levels, so a refinement pass is O(n + m).
+ */
+template <typename T>
+void MultilevelT<T>::relax(Level &level, T k, int iterations) {
+
+    // prepare
+    int n = level.n;
+    T k2 = k * k;
+    T t = k;
+    T cooling = pow(0.05, 1.0 / max(1, iterations));
+    bool gridded = n >= multilevelGridMin;
+    T cell = 2 * k;
+
+    // iterate
+    for (int i = 0; i < iterations; i++) {
+        disp.assign(n, Vec2<T>(0,0));
+
+        // repulsion
+        if (gridded) {
+
+            // grid
+            grid.clear();
+            for (int v = 0; v < n; v++) {
+                grid[make_pair((int)floor(level.positions[v].x / cell), (int)floor(level.positions[v].y / cell))].push_back(v);
+            }
+
+            // neighbouring cells
+            for (map< pair<int,int>, vector<int> >::iterator it = grid.begin(); it != grid.end(); ++it) {
+                for (int gx = -1; gx <= 1; gx++) {
+                    for (int gy = -1; gy <= 1; gy++) {
+                        map< pair<int,int>, vector<int> >::iterator nb = grid.find(make_pair(it->first.first+gx, it->first.second+gy));
+                        if (nb == grid.end()) {
+                            continue;
+                        }
+                        for (int a = 0; a < (int)it->second.size(); a++) {
+                            for (int b = 0; b < (int)nb->second.size(); b++) {
+                                int u = it->second[a];
+                                int v = nb->second[b];
+                                if (u != v) {
+                                    Vec2<T> d = level.positions[u] - level.positions[v];
+                                    if (d.lengthSquared() < cell * cell) {
+                                        disp[u] += Layout<T>::repulsion(d, k2, level.weights[v]);
+                                    }
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+        }
+        else {
+
+            // all pairs
+            for (int u = 0; u < n; u++) {
+                for (int v = 0; v < n; v++) {
+                    if (u != v) {
+                        Vec2<T> d = level.positions[u] - level.positions[v];
+                        disp[u] += Layout<T>::repulsion(d, k2, level.weights[v]);
+                    }
+                }
+            }
+        }
+
+        // attraction
+        for (int e = 0; e < (int)level.links.size(); e++) {
+            int u = level.links[e].first;
+            int v = level.links[e].second;
+            Vec2<T> d = level.positions[u] - level.positions[v];
+            Vec2<T> f = d * (d.length() / k) * level.lweights[e];
+            disp[u] -= f / level.weights[u];
+            disp[v] += f / level.weights[v];
+        }
+
+        // move
+        for (int v = 0; v < n; v++) {
+            T l = disp[v].length();
+            if (l > 0) {
+                level.positions[v] += disp[v] * (min(l, t) / l);
+            }
+        }
+
+        // cool
+        t *= cooling;
+    }
+}
+
+
+// instances
+template class MultilevelT<float>;
+template class MultilevelT<double>;
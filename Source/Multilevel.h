@@ -0,0 +1,92 @@
+//
+//  Multilevel.h
+//  Solyaris
+//
+//  Created by CNPP on 19.10.2026.
+//  Copyright 2026 Beat Raess. All rights reserved.
+//
+//  This file is part of Solyaris.
+//
+//  Solyaris is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  Solyaris is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with Solyaris.  If not, see www.gnu.org/licenses/.
+
+#pragma once
+#include "cinder/Vector.h"
+#include "cinder/Rand.h"
+#include "Layout.h"
+#include <vector>
+#include <map>
+#include <algorithm>
+
+
+// namespace
+using namespace std;
+using namespace ci;
+
+
+// constants
+const int multilevelCoarsest = 8;
+const double multilevelReduction = 0.8;
+const int multilevelIterations = 80;
+const int multilevelRefinements = 24;
+const int multilevelGridMin = 48;
+
+
+/**
+ * Multilevel Layout.
+ * Coarsens the graph by heavy edge matching, lays out the coarsest level
+ * and interpolates / refines it level by level (FM³, Walshaw).
+ * Templated on the scalar type, instantiated for float and double.
+ */
+template <typename T>
+class MultilevelT {
+
+    // public
+    public:
+
+    // Multilevel
+    MultilevelT();
+
+    // Business
+    void layout(vector< Vec2<T> > &positions, const vector< pair<int,int> > &links, T length);
+    int depth();
+
+
+    // private
+    private:
+
+    // Level
+    struct Level {
+        int n;
+        vector<T> weights;
+        vector< pair<int,int> > links;
+        vector<T> lweights;
+        vector<int> coarse;
+        vector< Vec2<T> > positions;
+    };
+
+    // Helpers
+    bool coarsen(Level &fine, Level &coarse);
+    void interpolate(Level &coarse, Level &fine, T k);
+    void relax(Level &level, T k, int iterations);
+
+    // Levels
+    vector<Level> levels;
+
+    // Scratch
+    vector< Vec2<T> > disp;
+    vector<int> order;
+    map< pair<int,int>, vector<int> > grid;
+
+};
+typedef MultilevelT<Scalar> Multilevel;
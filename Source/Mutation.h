@@ -0,0 +1,75 @@
+//
+//  Mutation.h
+//  Solyaris
+//
+//  Created by CNPP on 19.10.2026.
+//  Copyright 2026 Beat Raess. All rights reserved.
+//
+//  This file is part of Solyaris.
+//
+//  Solyaris is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  Solyaris is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with Solyaris.  If not, see www.gnu.org/licenses/.
+
+
+#pragma once
+#include <string>
+#include <vector>
+
+
+// namespace
+using namespace std;
+
+
+/**
+ * Mutation.
+ * A child node and the edge connecting it to the parent of its batch.
+ * The edge label is a TMDb job to translate if job is set, excluded crew
+ * gets no node of its own.
+ */
+struct Mutation {
+    string cid;
+    string ctype;
+    string csubtype;
+    string clabel;
+    string cmeta;
+    string eid;
+    string etype;
+    string elabel;
+    bool job;
+    bool excluded;
+};
+
+
+/**
+ * Mutation Batch.
+ * Graph changes for a loaded node, the mutations are in display order.
+ * Empty label, meta, category or subtype leave the node as it is.
+ */
+struct MutationBatch {
+    string nid;
+    string type;
+    string subtype;
+    string label;
+    string meta;
+    string category;
+    vector<Mutation> mutations;
+    void swap(MutationBatch &b) {
+        nid.swap(b.nid);
+        type.swap(b.type);
+        subtype.swap(b.subtype);
+        label.swap(b.label);
+        meta.swap(b.meta);
+        category.swap(b.category);
+        mutations.swap(b.mutations);
+    }
+};
@@ -30,95 +30,82 @@
  * Creates a Node.
  */
 Node::Node() {
-    Node("nid",0,0);
+    Node(NodePoolPtr(new NodePool()),"nid",0,0);
 }
-Node::Node(string idn, double x, double y) {
+Node::Node(const NodePoolPtr &p, const string &idn, double x, double y) {
     GLog();
     
     // node
     nid = idn;
     parent = NodeWeakPtr();
-    label = "";
-    meta = "";
     type = "Node";
-    category = "";
-    action = "";
+    info = NodeInfoPtr(new NodeInfo());
+    
+    // body
+    pool = p;
+    slot = pool->acquire();
+    body = &pool->body(slot);
+    body->node = this;
+    body->live = true;
+    body->cluster = false;
     
     // fields
-    perimeter = 420;
-    zone = perimeter / 9.0;
-    dist = 480;
-    damping = 0.5;
-    strength = -1;
-    stiffness = 0.05;
-    distraction = 0.3;
-    ramp = 1.2;
-    mvelocity = 15;
-    speed = 30;
-    initial = 12;
-    fcount = 0;
-    redux = false;
-    dpr = 1.0;
+    ftime = 0;
     
     // position
-    pos.set(x,y);
-    ppos.set(x,y);
-    mpos.set(x,y);
+    body->pos.set(x,y);
+    body->ppos.set(x,y);
+    body->mpos.set(x,y);
     
     // state
-    selected = false;
-    active = false;
-    closed = false;
+    body->selected = false;
+    body->active = false;
+    body->closed = false;
     grow = false;
     shrink = false;
-    loading = false;
-    visible = false;
+    body->loading = false;
+    body->visible = false;
+    body->clustered = false;
+    relabel = false;
+    body->mutated = false;
+    body->relax = 0;
+    body->lod = 1;
+    body->due = true;
+    body->skipped = 0;
     
     // radius / mass
-    core = 9;
-    radius = 9;
-    maxr = 90;
-    minr = 60;
-    mass = calcmass();
-    
-    // inc
-    rincg = 1.8;
-    rincs = 2.4;
-    
-    // velocity
-    velocity.set(0,0);
-    
-    // color
-    ctxt = Color(0.3,0.3,0.3);
-    ctxta = Color(0.2,0.2,0.2);
-    ctxts = Color(0.15,0.15,0.15);
-    
-    // alpha
-    anode = 0.8;
-    asnode = 0.9;
-    acore = 0.8;
-    ascore = 0.9;
-    aglow = 0.3;
-    asglow = 0.39;
-    
-    // textures
-    textureNode = gl::Texture(1,1);
-    textureCore = gl::Texture(1,1);
-    textureGlow = gl::Texture(1,1);
-    
-    // font
-    font = Font("Helvetica",13);
-    textureLabel = gl::Texture(1,1);
-    loff.set(0,5);
+    const NodeParams &params = Params::node();
+    body->core = 9 * params.dpr;
+    body->radius = 9 * params.dpr;
+    body->mass = nodeMass(body->radius);
+    
+    // velocity / force
+    body->velocity.set(0,0);
+    body->force.set(0,0);
+    
+    // style
+    style = styleNodeDefault;
+    skin = Style::skin(type, "");
+    relabel = true;
+    loff = 0;
 
 }
 
+/**
+ * Returns the body to the pool.
+ */
+Node::~Node() {
+    if (pool) {
+        pool->release(slot);
+    }
+}
+
 /**
  * Node movie.
  */
 NodeMovie::NodeMovie(): Node::Node()  {    
 }
-NodeMovie::NodeMovie(string idn, double x, double y): Node::Node(idn, x, y) {
+NodeMovie::NodeMovie(const NodePoolPtr &p, const string &idn, double x, double y): Node::Node(p, idn, x, y) {
     
     // type
     this->updateType(nodeMovie);
@@ -130,7 +117,7 @@ NodeMovie::NodeMovie(string idn, double x, double y): Node::Node(idn, x, y) {
  */
 NodePerson::NodePerson(): Node::Node()  {    
 }
-NodePerson::NodePerson(string idn, double x, double y): Node::Node(idn, x, y) {
+NodePerson::NodePerson(const NodePoolPtr &p, const string &idn, double x, double y): Node::Node(p, idn, x, y) {
     
     // type
     this->updateType(nodePerson);
@@ -138,150 +125,39 @@ NodePerson::NodePerson(string idn, double x, double y): Node::Node(idn, x, y) {
 
 
 
-#pragma mark -
-#pragma mark Cinder
-
-/**
- * Applies the configuration.
- */
-void Node::config(Configuration c) {
-    
-    // device
-    redux = false;
-    Config confDeviceRedux = c.getConfiguration(cDeviceRedux);
-    if (confDeviceRedux.isSet()) {
-        redux = confDeviceRedux.boolVal();
-    }
-    
-    // resolution
-    Config confDisplayResolution = c.getConfiguration(cDisplayResolution);
-    dpr = confDisplayResolution.floatVal();
-    
-    // init redux
-    if (redux) {
-        minr *= 0.8;
-        maxr *= 0.8;
-    }
-    
-    // params
-    core *= dpr;
-    radius *= dpr;
-    maxr *= dpr;
-    minr *= dpr;
-    
-    // inc
-    rincg *= dpr;
-    rincs *= dpr;
-    
-    // offset
-    loff *= dpr;
-    
-    // font
-    font = Font("Helvetica",redux ? (12 * dpr) : (13 * dpr));
-}
-
-
-/**
- * Applies the defaults.
- */
-void Node::defaults(Defaults d) {
-    
-    // children
-    initial = redux ? 5 : 7;
-    Default graphNodeInitial = d.getDefault(dGraphNodeInitial);
-    if (graphNodeInitial.isSet()) {
-        initial = (int) graphNodeInitial.doubleVal();
-    }
-    
-    
-    // distance
-    double length = redux ? 320 : 480;
-    Default graphEdgeLength = d.getDefault(dGraphEdgeLength);
-    if (graphEdgeLength.isSet()) {
-        length = graphEdgeLength.doubleVal();
-    }
-    
-    // props
-    dist = length*1.11;
-    perimeter = length*0.9;
-    zone = length / 9.0;
-    
-    // scale retina
-    dist *= dpr;
-    perimeter *= dpr;
-    zone *= dpr;
-
-}
-
-
 #pragma mark -
 #pragma mark Sketch
 
 /**
 * Updates the node.
+* Semi-implicit euler: the force updates the velocity first, the new
+* velocity then moves the position. All rates are per second. A node on a
+* slow level of detail integrates the force of its due tick over the
+* skipped ticks in one step.
 */
-void Node::update() {
-    
-    // count
-    fcount++;
-    
+void Node::update(double dt) {
     
-    // limit
-    velocity.limit(mvelocity);
-    
-    // threshold
-    float thresh = 0.1;
-    if (abs(velocity.x) < thresh && abs(velocity.y) < thresh) {
-        velocity.x = 0;
-        velocity.y = 0;
-    }
-
-    // damping
-    float damp = active ? damping : (damping * 1.75);
-    velocity *= (1 - damp);
+    // parameters
+    const NodeParams &params = Params::node();
+    double damp = body->active ? params.damping : (params.damping * 3.0);
     
-    // add vel to moving position
-    mpos += velocity;
+    // step
+    Scalar t = dt * (body->skipped + 1);
+    body->skipped = 0;
+    body->ppos = body->pos;
+    ftime += t;
     
-    // update position
-    Vec2d dm = mpos - pos;
-    ppos = pos;
-    pos += dm/speed;
+    // integrate
+    Kernel::integrate(body->pos, body->mpos, body->velocity, body->force, t, (Scalar)damp, (Scalar)params.easing, (Scalar)params.mvelocity, (Scalar)params.vthresh);
+    body->force.set(0,0);
 
-    // grow
-    if (grow) {
-        
-        // radius
-        radius += rincg;
-        
-        // mass
-        mass = calcmass();
-        
-        // grown
-        if (radius >= growr) {
-            this->grown();
-        }
-        
-    }
-    
-    // shrink
-    if (shrink) {
-        
-        // radius
-        radius -= rincs;
-        
-        // mass
-        mass = calcmass();
-        
-        // shrunk
-        if (radius <= shrinkr) {
-            this->shrinked();
-        }
-        
-        
-    }
+}
 
-    
+/**
+* Skips a step, the next update covers it.
+*/
+void Node::skip() {
+    body->skipped++;
 }
 
 
@@ -296,43 +172,51 @@ void Node::draw() {
     // blend
     gl::enableAlphaBlending();
     
+    // style
+    const NodeStyle &ns = Style::node(style);
+    
     // node expanded
-    if (active || loading) {
+    if (body->active || body->loading) {
         
         // core
-        float ca = selected ? ascore : acore;
+        float ca = body->selected ? ns.ascore : ns.acore;
         gl::color( ColorA(1.0f, 1.0f, 1.0f, ca) ); // alpha channel
-        gl::draw(textureCore, Rectf(pos.x-core,pos.y-core,pos.x+core,pos.y+core));
+        gl::draw(skin->textureCore, Rectf(body->pos.x-body->core,body->pos.y-body->core,body->pos.x+body->core,body->pos.y+body->core));
         
         // glow
-        float ga = selected ? asglow : aglow;
-        if (loading && ! grow) {
-            ga *= (1.15+sin((fcount*1.15*M_PI)/180));
+        float ga = body->selected ? ns.asglow : ns.aglow;
+        if (body->loading && ! grow) {
+            ga *= (1.15+sin((ftime*nodeFrameRate*1.15*M_PI)/180));
             ga = fmin(0.79,ga);
         }
         gl::color( ColorA(1.0f, 1.0f, 1.0f, ga) ); // alpha channel
-        gl::draw(textureGlow, Rectf(pos.x-radius,pos.y-radius,pos.x+radius,pos.y+radius));
+        gl::draw(skin->textureGlow, Rectf(body->pos.x-body->radius,body->pos.y-body->radius,body->pos.x+body->radius,body->pos.y+body->radius));
         
     }
     else {
         
         // node
-        float na = selected ? asnode : anode;
+        float na = body->selected ? ns.asnode : ns.anode;
         gl::color( ColorA(1.0f, 1.0f, 1.0f, na) ); // alpha channel
-        gl::draw(textureNode, Rectf(pos.x-core,pos.y-core,pos.x+core,pos.y+core));
+        gl::draw(skin->textureNode, Rectf(body->pos.x-body->core,body->pos.y-body->core,body->pos.x+body->core,body->pos.y+body->core));
         
     }
     
     
     // label
-    if (active || ! closed) {
+    if (body->active || ! body->closed) {
+        
+        // deferred
+        if (relabel) {
+            this->renderLabel(info->label);
+        }
         
         // unblend
         gl::enableAlphaBlending(true);
         
         // drawy thingy
-        selected ? gl::color(ctxts) : (active ? gl::color(ctxta) : gl::color(ctxt));
-        gl::draw(textureLabel, Vec2d(pos.x+loff.x, pos.y+core+loff.y));
+        body->selected ? gl::color(ns.ctxts) : (body->active ? gl::color(ns.ctxta) : gl::color(ns.ctxt));
+        gl::draw(textureLabel, Vec2d(body->pos.x+loff, body->pos.y+body->core+ns.loff));
     }
 
     
@@ -347,45 +231,23 @@ void Node::draw() {
 #pragma mark -
 #pragma mark Business
 
-/**
-* Node attraction.
-*/
-void Node::attract(NodePtr node) {
-    
-
-    // distance
-    double d = pos.distance((*node).pos);
-    if (d > 0 && d < perimeter) {
-        
-        // force
-        double s = pow(d / perimeter, 1 / ramp);
-        double m = selected ? mass*2 : mass;
-        double force = s * 9 * strength * (1 / (s + 1) + ((s - 3) / 4)) / d;
-        Vec2d df = (pos - (*node).pos) * (force/m);
-        
-        // velocity
-        (*node).velocity += df;
-    }
-
-}
-
 /**
  * Node distraction.
  */
-void Node::distract(NodePtr node) {
+void Node::distract(const NodePtr &node) {
     
     
     // distance
-    double d = pos.distance((*node).pos);
-    if (d > 0 && d < zone) {
+    const NodeParams &params = Params::node();
+    double d = body->pos.distance((*node).body->pos);
+    if (d > 0 && d < params.zone) {
         
         // force
-        double s = pow(d / zone, 1 / ramp);
-        double force = s * 9 * strength * (1 / (s + 1) + ((s - 3) / 4)) / d;
-        Vec2d df = (pos - (*node).pos) * (force/mass) * distraction;
+        Scalar force = Kernel::attraction(d, params.zone, params.ramp, params.strength);
+        Vec2s df = (body->pos - (*node).body->pos) * (force/body->mass) * params.distraction;
         
-        // velocity
-        (*node).velocity += df;
+        // force
+        (*node).body->force += df;
     }
     
 }
@@ -393,24 +255,24 @@ void Node::distract(NodePtr node) {
 /**
  * Node repulsion.
  */
-void Node::repulse(Vec2d p, float dist, float dir) {
+void Node::repulse(Vec2s p, Scalar dist, Scalar dir) {
     
     // distance vector
-    Vec2d diff = p - this->pos;
+    Vec2s diff = p - this->body->pos;
     
     // normalize / length
     diff.safeNormalize();
     diff *= dist;
     
     // target
-    Vec2d target = p + diff;
+    Vec2s target = p + diff;
     
     // force
-    Vec2d force = this->pos - target;
-    force *= stiffness;
+    Vec2s force = this->body->pos - target;
+    force *= Params::node().stiffness;
 
-    // update velocity
-    this->velocity += force*dir;
+    // update force
+    this->body->force += force*dir;
 }
 
 
@@ -418,33 +280,33 @@ void Node::repulse(Vec2d p, float dist, float dir) {
  * Move.
  */
 void Node::move(double dx, double dy) {
-    mpos.x += dx;
-    mpos.y += dy;
+    body->mpos.x += dx;
+    body->mpos.y += dy;
 }
-void Node::move(Vec2d d) {
-    mpos += d;
+void Node::move(Vec2s d) {
+    body->mpos += d;
 }
 void Node::moveTo(double x, double y) {
-    mpos.x = x;
-    mpos.y = y;
+    body->mpos.x = x;
+    body->mpos.y = y;
 }
-void Node::moveTo(Vec2d p) {
-    mpos.set(p);
+void Node::moveTo(Vec2s p) {
+    body->mpos.set(p);
 }
 
 /**
  * Translate.
  */
-void Node::translate(Vec2d d) {
-    pos += d;
-    mpos += d;
+void Node::translate(Vec2s d) {
+    body->pos += d;
+    body->mpos += d;
 }
 
 
 /**
 * Adds a child.
 */
-void Node::addChild(NodePtr child) {
+void Node::addChild(const NodePtr &child) {
     GLog();
     
     // push
@@ -458,14 +320,14 @@ void Node::grown() {
     FLog();
     
     // state
-    loading = false;
+    body->loading = false;
     grow = false;
 
     // mass
-    mass = calcmass();
+    body->mass = nodeMass(body->radius);
     
     // state
-    if (! active) {
+    if (! body->active) {
         
         // born
         this->born();
@@ -489,11 +351,16 @@ void Node::shrinked() {
     shrink = false;
     
     // mass
-    mass = calcmass();
+    body->mass = nodeMass(body->radius);
     
     // fold
     this->fold();
     
+    // aggregate
+    if (body->closed) {
+        this->cluster();
+    }
+    
 }
 
 
@@ -504,12 +371,12 @@ void Node::born() {
     FLog();
     
     // state
-    active = true;
-    closed = false;
+    body->active = true;
+    body->closed = false;
     
     // children
-    int nb = initial;
-    NodeVectorPtr cnodes;
+    int nb = Params::node().initial;
+    ArenaNodes cnodes;
     for (NodeIt child = children.begin(); child != children.end(); ++child) {
         
         // filter existing
@@ -518,8 +385,12 @@ void Node::born() {
             // parent
             if ((*child)->parent.lock()) {
                 
-                // unhide
-                (*child)->show(true);
+                // unhide between both neighbours
+                bool hidden = ! (*child)->isVisible();
+                (*child)->show(false);
+                if (hidden) {
+                    (*child)->attach(sref.lock());
+                }
                 
             }
             
@@ -569,7 +440,7 @@ void Node::unfold() {
     FLog();
     
     // children
-    NodeVectorPtr cnodes;
+    ArenaNodes cnodes;
     for (NodeIt child = children.begin(); child != children.end(); ++child) {
         
         // open child
@@ -594,7 +465,7 @@ void Node::fold() {
     FLog();
     
     // children
-    NodeVectorPtr cnodes;
+    ArenaNodes cnodes;
     for (NodeIt child = children.begin(); child != children.end(); ++child) {
         
         // move it
@@ -620,20 +491,18 @@ void Node::load() {
     FLog();
     
     // state
-    visible = true;
-    loading = true;
+    body->visible = true;
+    body->loading = true;
+    body->mutated = true;
     
     // radius
-    core = 15 * dpr;
-    radius = 36 * dpr;
-    
-    // color
-    ctxt = Color(0.6,0.6,0.6);
+    const NodeParams &params = Params::node();
+    body->core = 15 * params.dpr;
+    body->radius = 36 * params.dpr;
     
-    // font
-    font = Font("Helvetica-Bold", 15 * dpr);
-    loff.y = 6 * dpr;
-    this->renderLabel(label);
+    // style
+    style = styleNodeLoading;
+    this->renderLabel(info->label);
     this->renderNode();
     
 }
@@ -641,27 +510,24 @@ void Node::unload() {
     FLog();
     
     // state
-    visible = true;
-    loading = false;
+    body->visible = true;
+    body->loading = false;
     
     // radius
-    core = 9 * dpr;
-    radius = 9 * dpr;
-    
-    // color
-    ctxt = Color(0.75,0.75,0.75);
+    const NodeParams &params = Params::node();
+    body->core = 9 * params.dpr;
+    body->radius = 9 * params.dpr;
     
-    // font
-    font = Font("Helvetica",redux ? (12 * dpr) : (13 * dpr));
-    loff.y = 5 * dpr;
-    this->renderLabel(label);
+    // style
+    style = styleNodeUnloaded;
+    this->renderLabel(info->label);
     
     // parent
     NodePtr pp = this->parent.lock();
     if (pp) {
         
         // radius & position
-        Vec2d back = pp->pos + ((this->pos - pp->pos) / 2.0);
+        Vec2s back = pp->body->pos + ((this->body->pos - pp->body->pos) / 2.0);
         this->moveTo(back);
     }
     
@@ -671,8 +537,10 @@ void Node::loaded() {
     FLog();
 
     // state
-    growr = ((int)children.size()) > 1 ? min(minr+(int)children.size(),maxr) : minr * 0.75;
-    grow = true;
+    const NodeParams &params = Params::node();
+    growr = ((int)children.size()) > 1 ? min(params.minr+(int)children.size(),params.maxr) : params.minr * 0.75;
+    this->animate(growr, params.rincg, true);
+    body->mutated = true;
   
 }
 
@@ -683,14 +551,15 @@ void Node::close() {
     GLog();
     
     // state
-    closed = true;
+    body->closed = true;
+    body->mutated = true;
     
     // active
-    if (active) {
+    if (body->active) {
         
         // shrink
-        shrinkr = minr * 0.5;
-        shrink = true;
+        shrinkr = Params::node().minr * 0.5;
+        this->animate(shrinkr, Params::node().rincs, false);
         
         // children
         for (NodeIt child = children.begin(); child != children.end(); ++child) {
@@ -713,14 +582,19 @@ void Node::open() {
     GLog();
     
     // state
-    closed = false;
+    body->closed = false;
+    body->mutated = true;
     
     // active
-    if (active) {
+    if (body->active) {
+        
+        // members
+        this->expand();
         
         // state
-        growr = ((int)children.size()) > 1 ? min(minr+(int)children.size(),maxr) : minr * 0.75;
-        grow = true;
+        const NodeParams &params = Params::node();
+        growr = ((int)children.size()) > 1 ? min(params.minr+(int)children.size(),params.maxr) : params.minr * 0.75;
+        this->animate(growr, params.rincg, true);
         
     }
     
@@ -733,30 +607,33 @@ void Node::open() {
 void Node::show(bool position) {
     GLog();
     
+    // leave cluster (the cluster skips it when expanding)
+    body->clustered = false;
+    
     // show it
-    if (! visible) {
+    if (! body->visible) {
         
         // parent
         NodePtr pp = this->parent.lock();
         if (pp) {
             
             // base position
-            this->pos.set(pp->pos);
-            this->mpos.set(pp->pos);
+            this->body->pos.set(pp->body->pos);
+            this->body->mpos.set(pp->body->pos);
             
             // position
             if (position) {
                 
                 // radius & position
-                float rx = Rand::randFloat(pp->radius * nodeUnfoldMin,pp->radius * nodeUnfoldMax) + 0.1;
+                float rx = Rand::randFloat(pp->body->radius * nodeUnfoldMin,pp->body->radius * nodeUnfoldMax) + 0.1;
                 rx *= (Rand::randFloat(1) > 0.5) ? 1.0 : -1.0;
-                float ry = Rand::randFloat(pp->radius * nodeUnfoldMin,pp->radius * nodeUnfoldMax) + 0.1;
+                float ry = Rand::randFloat(pp->body->radius * nodeUnfoldMin,pp->body->radius * nodeUnfoldMax) + 0.1;
                 ry *= (Rand::randFloat(1) > 0.5) ? 1.0 : -1.0;
-                Vec2d p = Vec2d(pp->pos.x+rx,pp->pos.y+ry);
+                Vec2s p = Vec2s(pp->body->pos.x+rx,pp->body->pos.y+ry);
                 
                 // set
-                this->pos.set(p);
-                this->mpos.set(p);
+                this->body->pos.set(p);
+                this->body->mpos.set(p);
             }
             
 
@@ -765,69 +642,226 @@ void Node::show(bool position) {
     }
     
     // state
-    visible = true;
+    body->visible = true;
     
 }
 void Node::hide() {
     GLog();
     
     // state
-    visible = false;
+    body->visible = false;
+    
+    // label, rendered again when shown
+    textureLabel = gl::Texture();
+    relabel = true;
     
 }
 
 
 /**
  * Positions the children.
+ * Children are spread over angular slots in the gaps between the directions
+ * that are already taken by the parent and by connected nodes.
  */
-void Node::cposition(NodeVectorPtr cnodes) {
+void Node::cposition(const ArenaNodes &cnodes) {
     GLog();
     
+    // state
+    body->mutated = true;
+    
     // randomize
     Rand::randomize();
     
     // number
-    float cnb = cnodes.size();
+    int cnb = cnodes.size();
+    if (cnb == 0) {
+        return;
+    }
     
     // radius
-    float rmin = closed ? radius * 0.25 : radius * nodeUnfoldMin * 0.75;
-    float rmax = radius * nodeUnfoldMax * 0.75;
+    float rmin = body->closed ? body->radius * 0.25 : body->radius * nodeUnfoldMin * 0.75;
+    float rmax = body->radius * nodeUnfoldMax * 0.75;
     
-    // angle
-    float a = 360.0/cnb; 
-    float ca = Rand::randFloat(-130.0,-110.0);
+    // occupied directions
+    ArenaFloats occupied;
+    NodePtr pp = this->parent.lock();
+    if (pp && pp->body->pos.distance(body->pos) > 1) {
+        occupied.push_back(atan2(pp->body->pos.y - body->pos.y, pp->body->pos.x - body->pos.x));
+    }
+    for (NodeIt child = children.begin(); child != children.end(); ++child) {
+        
+        // connected
+        bool connected = (*child)->isActive() || (*child)->isLoading();
+        if (! connected && (*child)->isVisible()) {
+            NodePtr cp = (*child)->parent.lock();
+            connected = cp && cp->nid != this->nid;
+        }
+        if (connected && (*child)->body->pos.distance(body->pos) > 1) {
+            occupied.push_back(atan2((*child)->body->pos.y - body->pos.y, (*child)->body->pos.x - body->pos.x));
+        }
+    }
+    
+    // slots
+    ArenaFloats slots;
+    if (occupied.empty()) {
+        
+        // evenly
+        float a = 2 * M_PI / cnb;
+        float ca = Rand::randFloat(-130.0,-110.0) * M_PI / 180.0;
+        for (int c = 0; c < cnb; c++) {
+            slots.push_back(ca + c * a);
+        }
+    }
+    else {
+        
+        // gaps
+        sort(occupied.begin(), occupied.end());
+        int nbo = occupied.size();
+        ArenaFloats gaps(nbo);
+        ArenaInts shares(nbo, 0);
+        for (int o = 0; o < nbo; o++) {
+            float next = (o+1 < nbo) ? occupied[o+1] : occupied[0] + 2 * M_PI;
+            gaps[o] = next - occupied[o];
+        }
+        
+        // largest gap per child first
+        for (int c = 0; c < cnb; c++) {
+            int g = 0;
+            for (int o = 1; o < nbo; o++) {
+                if (gaps[o] / (shares[o]+1) > gaps[g] / (shares[g]+1)) {
+                    g = o;
+                }
+            }
+            shares[g]++;
+        }
+        
+        // spread within the gaps
+        for (int o = 0; o < nbo; o++) {
+            for (int k = 0; k < shares[o]; k++) {
+                slots.push_back(occupied[o] + gaps[o] * (k+1) / (shares[o]+1));
+            }
+        }
+    }
     
     // child nodes
-    for (NodeIt cnode = cnodes.begin(); cnode != cnodes.end(); ++cnode) {
+    int c = 0;
+    for (ArenaNodes::const_iterator cnode = cnodes.begin(); cnode != cnodes.end(); ++cnode) {
         
-        // randomize radius / angle
+        // randomize radius
         float rr = Rand::randFloat(rmin,rmax) + 0.1;
-        float ra = Rand::randFloat(ca-a/2.0,ca+a/2.0);
+        float ra = slots[c++];
         
         // position
-        Vec2d p = Vec2d(pos.x+(rr * cos(ra * M_PI / 180.0)),pos.y+(rr * sin(ra * M_PI / 180.0)));
+        Vec2s p = Vec2s(body->pos.x+(rr * cos(ra)),body->pos.y+(rr * sin(ra)));
         
         // move
         (*cnode)->moveTo(p);
+    }
+    
+}
+
+/**
+ * Attaches a node that already has a parent to another node: it is placed
+ * on its parent's orbit, facing the barycentre of both neighbours.
+ */
+void Node::attach(const NodePtr &n) {
+    GLog();
+    
+    // parent
+    NodePtr pp = this->parent.lock();
+    if (pp && n) {
         
-        // angle
-        ca += a;
+        // barycentre
+        Vec2s bc = (pp->body->pos + n->body->pos) / 2.0;
+        Vec2s dir = bc - pp->body->pos;
+        dir.safeNormalize();
+        
+        // orbit
+        float r = pp->body->radius * (nodeUnfoldMin + nodeUnfoldMax) / 2.0;
+        Vec2s p = pp->body->pos + dir * r;
+        
+        // set
+        this->body->pos.set(p);
+        this->body->mpos.set(p);
     }
+}
+
+
+/**
+ * Aggregates the folded children into this node: they leave the simulation
+ * and rendering, the node carries their mass and keeps their offsets.
+ * Closing again adds the newly folded children, the mass is summed over
+ * all members still in the cluster.
+ */
+void Node::cluster() {
+    GLog();
     
+    // members still in the cluster
+    int k = 0;
+    for (int i = 0; i < (int)members.size(); i++) {
+        NodePtr member = members[i].first.lock();
+        if (member && member->body->clustered) {
+            members[k++] = members[i];
+        }
+    }
+    members.resize(k);
+    
+    // new members
+    for (NodeIt child = children.begin(); child != children.end(); ++child) {
+        if (this->isNodeChild(*child)) {
+            members.push_back(make_pair(NodeWeakPtr(*child), (*child)->body->mpos - body->mpos));
+            (*child)->body->clustered = true;
+        }
+    }
+    
+    // summary
+    float m = nodeMass(body->radius);
+    for (int i = 0; i < (int)members.size(); i++) {
+        NodePtr member = members[i].first.lock();
+        if (member) {
+            m += member->body->mass;
+        }
+    }
+    body->mass = m;
+    body->cluster = ! members.empty();
+    FLog("cluster of %d", (int)members.size());
+}
+
+/**
+ * Restores the members of the cluster at their offsets.
+ */
+void Node::expand() {
+    GLog();
+    
+    // members
+    for (int i = 0; i < (int)members.size(); i++) {
+        NodePtr member = members[i].first.lock();
+        if (member && member->body->clustered) {
+            member->body->clustered = false;
+            member->body->pos = body->pos + members[i].second;
+            member->body->ppos = member->body->pos;
+            member->body->mpos = member->body->pos;
+            member->body->velocity.set(0,0);
+        }
+    }
+    members.clear();
+    body->cluster = false;
+    
+    // mass
+    body->mass = nodeMass(body->radius);
 }
 
 
 /**
  * Child.
+ * Compares the parent by ownership, no locking or id comparison.
+ * Clustered children are not available.
  */
-bool Node::isNodeChild(NodePtr n) {
-    
-    // parent
-    NodePtr cp = n->parent.lock();
+bool Node::isNodeChild(const NodePtr &n) {
     
     // active
-    bool available = ! (n->isActive() || n->isLoading()) && n->isVisible();
-    return available && cp->nid == this->nid;
+    bool available = ! (n->isActive() || n->isLoading()) && n->isVisible() && ! n->body->clustered;
+    return available && ! (n->parent < sref) && ! (sref < n->parent);
 }
 
 
@@ -838,14 +872,14 @@ void Node::touched() {
     GLog();
     
     // state
-    selected = true;
+    body->selected = true;
     
 }
 void Node::untouched() {
     GLog();
     
     // state
-    selected = false;
+    body->selected = false;
     
 }
 
@@ -857,29 +891,30 @@ void Node::tapped() {
     FLog();
     
     // state
-    selected = false;
+    body->selected = false;
     
     // show
-    if (! visible) {
+    if (! body->visible) {
         this->show(true);
     }
     
     // reposition
-    if (! active && ! loading) {
+    if (! body->active && ! body->loading) {
         
         // parent
         NodePtr pp = this->parent.lock();
         if (pp) {
             
             // distance to parent
-            Vec2d pdist =  pos - pp->pos;
+            Vec2s pdist =  body->pos - pp->body->pos;
+            double dist = Params::node().dist;
             if (pdist.length() < dist) {
                 
                 // unity vector
                 pdist.safeNormalize();
                 
                 // move
-                this->moveTo(pp->pos+pdist*dist);
+                this->moveTo(pp->body->pos+pdist*dist);
             }
         }
     
@@ -890,30 +925,31 @@ void Node::tapped() {
 /**
  * Connect.
  */
-void Node::connect(NodePtr n) {
+void Node::connect(const NodePtr &n) {
     FLog();
     
     // reposition
-    if (! n->active && ! n->loading) {
+    if (! n->body->active && ! n->body->loading) {
         
         // randomize position
-        float rx = Rand::randFloat(this->radius * nodeUnfoldMin,this->radius * nodeUnfoldMax) + 0.1;
+        float rx = Rand::randFloat(this->body->radius * nodeUnfoldMin,this->body->radius * nodeUnfoldMax) + 0.1;
         rx *= (Rand::randFloat(1) > 0.5) ? 1.0 : -1.0;
-        float ry = Rand::randFloat(this->radius * nodeUnfoldMin,this->radius * nodeUnfoldMax) + 0.1;
+        float ry = Rand::randFloat(this->body->radius * nodeUnfoldMin,this->body->radius * nodeUnfoldMax) + 0.1;
         ry *= (Rand::randFloat(1) > 0.5) ? 1.0 : -1.0;
         
         // set
-        n->pos.set(Vec2d(this->pos.x+rx,this->pos.y+ry));
+        n->body->pos.set(Vec2s(this->body->pos.x+rx,this->body->pos.y+ry));
         
         // distance
-        Vec2d cdist =  n->pos - this->pos;
+        Vec2s cdist =  n->body->pos - this->body->pos;
+        double dist = Params::node().dist;
         if (cdist.length() < dist) {
             
             // unity vector
             cdist.safeNormalize();
             
             // move
-            n->moveTo(this->pos+cdist*dist*0.75);
+            n->moveTo(this->body->pos+cdist*dist*0.75);
         }
         
     }
@@ -925,19 +961,33 @@ void Node::connect(NodePtr n) {
  * States.
  */
 bool Node::isActive() {
-    return active;
+    return body->active;
 }
 bool Node::isClosed() {
-    return closed;
+    return body->closed;
 }
 bool Node::isVisible() {
-    return visible;
+    return body->visible;
 }
 bool Node::isSelected() {
-    return selected;
+    return body->selected;
 }
 bool Node::isLoading() {
-    return loading;
+    return body->loading;
+}
+bool Node::isClustered() {
+    return body->clustered;
+}
+int Node::clusterSize() {
+    return members.size();
+}
+
+/**
+ * Weight in the layout: a cluster stands for its members, plain nodes
+ * weigh one.
+ */
+float Node::weight() {
+    return members.empty() ? 1.0f : Layout<float>::weight(body->mass, body->radius);
 }
 
 
@@ -945,76 +995,51 @@ bool Node::isLoading() {
 /**
  * Renders the label.
  */
-void Node::renderLabel(string lbl) {
+void Node::renderLabel(const string &lbl) {
     GLog();
     
     // field
-    label = (lbl == "") ? " " : lbl;
+    info->label = (lbl == "") ? " " : lbl;
+    relabel = false;
     
     // text
+    const NodeStyle &ns = Style::node(style);
     TextLayout tlLabel;
     tlLabel.clear(ColorA(0, 0, 0, 0));
-    tlLabel.setFont(font);
-    tlLabel.setColor(ctxt);
-    tlLabel.addCenteredLine(label);
+    tlLabel.setFont(ns.font);
+    tlLabel.setColor(ns.ctxt);
+    tlLabel.addCenteredLine(info->label);
     Surface8u rendered = tlLabel.render(true, true);
     textureLabel = gl::Texture(rendered);
     
     // offset
-    loff.x = - textureLabel.getWidth() / 2.0;
+    loff = - textureLabel.getWidth() / 2.0;
 
 }
 
+/**
+ * Sets the label, it is rendered when first drawn.
+ */
+void Node::deferLabel(const string &lbl) {
+    info->label = (lbl == "") ? " " : lbl;
+    relabel = true;
+}
+
 /*
  * Renders the node.
+ * Textures are shared per kind and looked up in the style tables.
  */
 void Node::renderNode() {
     GLog();
     
-    // suffix
-    string sfx = Configuration::sfx(dpr);
-    
-    // movie
-    if (type == nodeMovie) {
-        
-        // category
-        string cat = (category.length()) > 0 ? ("_" + category) : "";
-        
-        // texture
-        textureNode = gl::Texture(loadImage(loadResource("node_movie"+sfx)));
-        if (active || loading) {
-            textureCore = gl::Texture(loadImage(loadResource("node_movie_core"+cat+sfx)));
-            textureGlow = gl::Texture(loadImage(loadResource("node_movie_glow"+cat+sfx)));
-        }
-        
-    }
-    // director / crew
-    else if (type == nodePersonDirector || type == nodePersonCrew) {
-        
-        // texture
-        textureNode = gl::Texture(loadImage(loadResource("node_crew"+sfx)));
-        if  (active || loading) {
-            textureCore = gl::Texture(loadImage(loadResource("node_crew_core"+sfx)));
-            textureGlow = gl::Texture(loadImage(loadResource("node_crew_glow"+sfx)));
-        }
-        
-    }
-    // person
-    else {
-        
-        // texture
-        textureNode = gl::Texture(loadImage(loadResource("node_person"+sfx)));
-        if (active || loading) {
-            textureCore = gl::Texture(loadImage(loadResource("node_person_core"+sfx)));
-            textureGlow = gl::Texture(loadImage(loadResource("node_person_glow"+sfx)));
-        }
-    }
+    // skin
+    skin = Style::skin(type, info->category);
 }
 
 /**
  * Updates the type.
  */
-void Node::updateType(string t) {
+void Node::updateType(const string &t) {
     
     // type
     type = t;
@@ -1026,10 +1051,10 @@ void Node::updateType(string t) {
 /**
  * Updates the category.
  */
-void Node::updateCategory(string c) {
+void Node::updateCategory(const string &c) {
     
     // category
-    category = c;
+    info->category = c;
     
     // render
     this->renderNode();
@@ -1039,24 +1064,95 @@ void Node::updateCategory(string c) {
 /**
  * Updates the meta.
  */
-void Node::updateMeta(string m) {
-    meta = m;
+void Node::updateMeta(const string &m) {
+    info->meta = m;
 }
 
 /**
  * Sets the action.
  */
-void Node::setAction(string a) {
-    action = a;
+void Node::setAction(const string &a) {
+    info->action = a;
 }
 
 /*
- * Calculates the mass.
+ * Animates the radius and mass towards r at rate px/s, replacing a running
+ * grow or shrink.
+ */
+void Node::animate(float r, double rate, bool growing) {
+    
+    // replace
+    tradius.cancel();
+    tmass.cancel();
+    grow = growing;
+    shrink = ! growing;
+    
+    // duration
+    double d = abs(r - body->radius) / rate;
+    
+    // tweens
+    NodePtr self = sref.lock();
+    TimelineCallback done = boost::bind(growing ? &Node::grown : &Node::shrinked, this);
+    if (self) {
+        tradius = Timeline::tween(self, &body->radius, r, d, easeLinear, done);
+        tmass = Timeline::tween(self, &body->mass, nodeMass(r), d, easeLinear, TimelineCallback());
+    }
+    else {
+        tradius = Timeline::tween(&body->radius, r, d, easeLinear, done);
+        tmass = Timeline::tween(&body->mass, nodeMass(r), d, easeLinear, TimelineCallback());
+    }
+}
+
+
+#pragma mark -
+#pragma mark Pool
+
+/**
+ * Creates a pool.
  */
-float Node::calcmass() {
-    return radius * radius * 0.0001f + 0.01f;
+NodePool::NodePool() {
+}
+NodePool::~NodePool() {
+    for (int b = 0; b < (int)blocks.size(); b++) {
+        delete [] blocks[b];
+    }
 }
 
+/**
+ * Takes a free slot, a new block when all are taken.
+ */
+int NodePool::acquire() {
+    if (free.empty()) {
+        int base = blocks.size() * nodePoolBlock;
+        blocks.push_back(new NodeBody[nodePoolBlock]);
+        for (int s = nodePoolBlock - 1; s >= 0; s--) {
+            blocks.back()[s].live = false;
+            free.push_back(base + s);
+        }
+    }
+    int slot = free.back();
+    free.pop_back();
+    return slot;
+}
 
+/**
+ * Frees a slot.
+ */
+void NodePool::release(int slot) {
+    this->body(slot).live = false;
+    free.push_back(slot);
+}
 
+/**
+ * Body in a slot.
+ */
+NodeBody& NodePool::body(int slot) {
+    return blocks[slot / nodePoolBlock][slot % nodePoolBlock];
+}
 
+/**
+ * Slots in all blocks.
+ */
+int NodePool::capacity() {
+    return blocks.size() * nodePoolBlock;
+}
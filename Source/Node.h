@@ -34,8 +34,15 @@
 #include <boost/ptr_container/ptr_vector.hpp>
 #include <boost/shared_ptr.hpp>
 #include <boost/weak_ptr.hpp>
+#include <vector>
+#include <algorithm>
 #include "Configuration.h"
 #include "Defaults.h"
+#include "Style.h"
+#include "Params.h"
+#include "Layout.h"
+#include "Arena.h"
+#include "Timeline.h"
 
 
 
@@ -47,12 +54,17 @@ using namespace ci::app;
 
 // declarations
 class Node;
+class NodePool;
+struct NodeInfo;
 
 // typedef
 typedef boost::shared_ptr<Node> NodePtr;
+typedef boost::shared_ptr<NodePool> NodePoolPtr;
+typedef boost::shared_ptr<NodeInfo> NodeInfoPtr;
 typedef boost::weak_ptr<Node> NodeWeakPtr;
 typedef std::vector<NodePtr> NodeVectorPtr;
 typedef NodeVectorPtr::iterator NodeIt;
+typedef std::vector<NodePtr, ArenaAllocator<NodePtr> > ArenaNodes;
 
 
 // constants
@@ -68,6 +80,93 @@ const float nodeUnfoldMax = 1.53f;
 const float nodeFoldMin = 0.3f;
 const float nodeFoldMax = 0.9f;
 
+// reference rate the legacy frame constants were tuned at
+const double nodeFrameRate = 60.0;
+
+// bodies per pool block
+const int nodePoolBlock = 256;
+
+
+/**
+ * Mass of a node of radius r.
+ */
+inline float nodeMass(float r) {
+    return Layout<float>::mass(r);
+}
+
+
+/**
+ * Node body.
+ * Hot simulation and draw state of a node, a plain record in the pool of
+ * the graph. The layout loops read the bodies, not the nodes.
+ */
+struct NodeBody {
+    Node *node;
+    Vec2s pos;
+    Vec2s ppos;
+    Vec2s mpos;
+    Vec2s velocity;
+    Vec2s force;
+    float core;
+    float radius;
+    float mass;
+    int relax;
+    int lod;
+    int skipped;
+    bool due;
+    bool mutated;
+    bool selected;
+    bool active;
+    bool closed;
+    bool visible;
+    bool loading;
+    bool clustered;
+    bool cluster;
+    bool live;
+};
+
+/**
+ * Node pool.
+ * The bodies of all nodes in fixed blocks: a body keeps its address while
+ * the pool grows, freed slots are taken first.
+ */
+class NodePool {
+    
+    // public
+    public:
+    
+    // NodePool
+    NodePool();
+    ~NodePool();
+    
+    // Business
+    int acquire();
+    void release(int slot);
+    NodeBody& body(int slot);
+    int capacity();
+    
+    
+    // private
+    private:
+    
+    // Blocks
+    vector<NodeBody*> blocks;
+    vector<int> free;
+    
+};
+
+
+/**
+ * Node info.
+ * Labels and metadata, only read by the interface.
+ */
+struct NodeInfo {
+    string label;
+    string meta;
+    string category;
+    string action;
+};
+
 
 /**
  * Graph Node.
@@ -80,27 +179,24 @@ class Node {
     
     // Node
     Node();
-    Node(string idn, double x, double y); 
-    
-    // Cinder
-    void config(Configuration c);
-    void defaults(Defaults d);
+    Node(const NodePoolPtr &p, const string &idn, double x, double y); 
+    ~Node();
     
     // Sketch
-    void update();
+    void update(double dt);
+    void skip();
     void draw();
     
     
     // Business
-    void attract(NodePtr node);
-    void distract(NodePtr node);
-    void repulse(Vec2d p, float dist, float dir);
+    void distract(const NodePtr &node);
+    void repulse(Vec2s p, Scalar dist, Scalar dir);
     void moveTo(double x, double y);
-    void moveTo(Vec2d p);
+    void moveTo(Vec2s p);
     void move(double dx, double dy);
-    void move(Vec2d d);
-    void translate(Vec2d d);
-    void addChild(NodePtr child);
+    void move(Vec2s d);
+    void translate(Vec2s d);
+    void addChild(const NodePtr &child);
     void grown();
     void shrinked();
     void load();
@@ -112,96 +208,74 @@ class Node {
     void fold();
     void unfold();
     void born();
-    bool isNodeChild(NodePtr p);
+    bool isNodeChild(const NodePtr &p);
     void show(bool animate);
-    void cposition(NodeVectorPtr cnodes);
+    void cposition(const ArenaNodes &cnodes);
+    void attach(const NodePtr &n);
+    void cluster();
+    void expand();
     void touched();
     void untouched();
     void tapped();
-    void connect(NodePtr n);
-    void renderLabel(string lbl);
+    void connect(const NodePtr &n);
+    void renderLabel(const string &lbl);
+    void deferLabel(const string &lbl);
     void renderNode();
-    void updateType(string t);
-    void updateMeta(string m);
-    void updateCategory(string c);
-    void setAction(string a);
+    void updateType(const string &t);
+    void updateMeta(const string &m);
+    void updateCategory(const string &c);
+    void setAction(const string &a);
     bool isActive();
     bool isClosed();
     bool isInactive();
     bool isVisible();
     bool isSelected();
     bool isLoading();
+    bool isClustered();
+    int clusterSize();
+    float weight();
     
     
     // Public Fields
     string nid;
-    string label;
-    string meta;
     string type;
-    string category;
-    string action;
+    NodeInfoPtr info;
     NodeWeakPtr sref;
     NodeWeakPtr parent;
     NodeVectorPtr children;
-    Vec2d pos;
-    Vec2d ppos;
-    Vec2d mpos;
-    float core;
-    float radius,growr,shrinkr;
-    float mass;
-	Vec2d velocity;
+    NodeBody *body;
+    int slot;
+    float growr,shrinkr;
 
     
     // private
     private:
     
+    // Pool
+    NodePoolPtr pool;
+    
     // States
-    bool selected;
-    bool active;
-    bool closed;
-    bool visible;
     bool grow,shrink;
-    bool loading;
+    bool relabel;
+    
+    // Cluster
+    vector< pair<NodeWeakPtr,Vec2s> > members;
     
     // Helpers
-    float calcmass();
+    void animate(float r, double rate, bool growing);
+    
+    // Animation
+    TimelineHandle tradius;
+    TimelineHandle tmass;
 
     
     // Parameters
-    double perimeter;
-    double zone;
-    double dist;
-    double damping;
-    double strength;
-    float stiffness;
-    float distraction;
-    double ramp;
-    double mvelocity;
-    double speed;
-    int initial;
-    int fcount;
-    int minr,maxr;
-    double rincg,rincs;
-    bool redux;
-    float dpr;
-    
-    // Textures
-    gl::Texture textureNode;
-    gl::Texture textureCore;
-    gl::Texture textureGlow;
-    
-    
-    // Color
-    Color ctxt;
-    Color ctxta;
-    Color ctxts;
-    float anode,asnode;
-    float acore,ascore;
-    float aglow,asglow;
-    
-    // Font
-    Font font;
-    Vec2d loff;
+    double ftime;
+    
+    // Style
+    int style;
+    const NodeSkin *skin;
+    float loff;
     gl::Texture	textureLabel;
 
 };
@@ -212,7 +286,7 @@ class NodeMovie: public Node {
     
     // Node
     NodeMovie();
-    NodeMovie(string idn, double x, double y);
+    NodeMovie(const NodePoolPtr &p, const string &idn, double x, double y);
 };
 class NodePerson: public Node {
     
@@ -221,7 +295,7 @@ class NodePerson: public Node {
     
     // Node
     NodePerson();
-    NodePerson(string idn, double x, double y);
+    NodePerson(const NodePoolPtr &p, const string &idn, double x, double y);
 };
 
 
@@ -0,0 +1,200 @@
+//
+//  Params.cpp
+//  Solyaris
+//
+//  Created by CNPP on 19.10.2026.
+//  Copyright 2026 Beat Raess. All rights reserved.
+//
+//  This file is part of Solyaris.
+//
+//  Solyaris is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  Solyaris is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with Solyaris.  If not, see www.gnu.org/licenses/.
+
+
+#include "Params.h"
+#include "Edge.h"
+#include "Connection.h"
+
+
+// blocks
+bool Params::redux = false;
+float Params::dpr = 1.0;
+Defaults Params::dflts;
+boost::mutex Params::mutex;
+int Params::cversion = 0;
+NodeParamsPtr Params::nblock;
+EdgeParamsPtr Params::eblock;
+ConnectionParamsPtr Params::cblock;
+int Params::pversion = 0;
+NodeParamsPtr Params::nparams;
+EdgeParamsPtr Params::eparams;
+ConnectionParamsPtr Params::cparams;
+
+
+#pragma mark -
+#pragma mark Cinder
+
+/**
+ * Applies the configuration.
+ */
+void Params::config(const Configuration &c) {
+    
+    // device
+    redux = false;
+    Config confDeviceRedux = c.getConfiguration(cDeviceRedux);
+    if (confDeviceRedux.isSet()) {
+        redux = confDeviceRedux.boolVal();
+    }
+    
+    // resolution
+    Config confDisplayResolution = c.getConfiguration(cDisplayResolution);
+    dpr = confDisplayResolution.floatVal();
+    
+    // rebuild
+    build();
+}
+
+/**
+ * Applies the defaults.
+ */
+void Params::defaults(const Defaults &d) {
+    
+    // reference
+    dflts = d;
+    
+    // rebuild
+    build();
+}
+
+
+#pragma mark -
+#pragma mark Business
+
+/**
+ * Pins the latest blocks for the frame.
+ */
+void Params::pin() {
+    
+    // built
+    if (cversion == 0) {
+        build();
+    }
+    
+    // swap in
+    boost::mutex::scoped_lock lock(mutex);
+    if (pversion != cversion) {
+        nparams = nblock;
+        eparams = eblock;
+        cparams = cblock;
+        pversion = cversion;
+    }
+}
+
+/**
+ * Pinned blocks.
+ */
+const NodeParams& Params::node() {
+    if (pversion == 0) {
+        pin();
+    }
+    return *nparams;
+}
+const EdgeParams& Params::edge() {
+    if (pversion == 0) {
+        pin();
+    }
+    return *eparams;
+}
+const ConnectionParams& Params::connection() {
+    if (pversion == 0) {
+        pin();
+    }
+    return *cparams;
+}
+
+/**
+ * Version of the pinned blocks.
+ */
+int Params::version() {
+    return pversion;
+}
+
+
+#pragma mark -
+#pragma mark Helpers
+
+/**
+ * Builds a new version of the blocks, pinned at the next frame.
+ */
+void Params::build() {
+    boost::mutex::scoped_lock lock(mutex);
+    cversion++;
+    GLog("version %d", cversion);
+    
+    // length
+    Default graphEdgeLength = dflts.getDefault(dGraphEdgeLength);
+    
+    // node
+    NodeParams *np = new NodeParams();
+    np->version = cversion;
+    np->damping = 41.59;        // 1/s (halves the velocity each frame at 60Hz)
+    np->strength = -3600;       // px/s²
+    np->stiffness = 30;         // 1/s²
+    np->distraction = 0.05;
+    np->ramp = 1.2;
+    np->mvelocity = 900;        // px/s
+    np->vthresh = 6;            // px/s
+    np->easing = 2.034;         // 1/s
+    np->redux = redux;
+    np->dpr = dpr;
+    
+    // children
+    np->initial = redux ? 5 : 7;
+    Default graphNodeInitial = dflts.getDefault(dGraphNodeInitial);
+    if (graphNodeInitial.isSet()) {
+        np->initial = (int) graphNodeInitial.doubleVal();
+    }
+    
+    // distance
+    double nlength = graphEdgeLength.isSet() ? graphEdgeLength.doubleVal() : (redux ? 320 : 480);
+    np->dist = nlength * 1.11 * dpr;
+    np->perimeter = nlength * 0.9 * dpr;
+    np->zone = nlength / 9.0 * dpr;
+    
+    // radius
+    np->minr = (redux ? 60 * 0.8 : 60) * dpr;
+    np->maxr = (redux ? 90 * 0.8 : 90) * dpr;
+    
+    // inc (px/s)
+    np->rincg = 108 * dpr;
+    np->rincs = 144 * dpr;
+    
+    // edge
+    EdgeParams *ep = new EdgeParams();
+    ep->version = cversion;
+    ep->length = (graphEdgeLength.isSet() ? graphEdgeLength.doubleVal() : (redux ? 300 : 480)) * dpr;
+    ep->stiffness = 2160;       // 1/s²
+    ep->damping = 0.9;
+    ep->dpr = dpr;
+    
+    // connection
+    ConnectionParams *cp = new ConnectionParams();
+    cp->version = cversion;
+    cp->s = 1.0 * dpr;
+    cp->d = 4.0 * dpr;
+    
+    // blocks
+    nblock = NodeParamsPtr(np);
+    eblock = EdgeParamsPtr(ep);
+    cblock = ConnectionParamsPtr(cp);
+}
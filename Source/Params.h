@@ -0,0 +1,133 @@
+//
+//  Params.h
+//  Solyaris
+//
+//  Created by CNPP on 19.10.2026.
+//  Copyright 2026 Beat Raess. All rights reserved.
+//
+//  This file is part of Solyaris.
+//
+//  Solyaris is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  Solyaris is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with Solyaris.  If not, see www.gnu.org/licenses/.
+
+
+#pragma once
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/mutex.hpp>
+#include <map>
+#include "Configuration.h"
+#include "Defaults.h"
+
+
+// namespace
+using namespace std;
+
+
+/**
+ * Node parameters.
+ */
+struct NodeParams {
+    int version;
+    double perimeter;
+    double zone;
+    double dist;
+    double damping;
+    double strength;
+    float stiffness;
+    float distraction;
+    double ramp;
+    double mvelocity;
+    double vthresh;
+    double easing;
+    int initial;
+    int minr,maxr;
+    double rincg,rincs;
+    bool redux;
+    float dpr;
+};
+
+/**
+ * Edge parameters.
+ */
+struct EdgeParams {
+    int version;
+    double length;
+    double stiffness;
+    double damping;
+    float dpr;
+};
+
+/**
+ * Connection parameters.
+ */
+struct ConnectionParams {
+    int version;
+    float s;
+    float d;
+};
+
+// typedef
+typedef boost::shared_ptr<const NodeParams> NodeParamsPtr;
+typedef boost::shared_ptr<const EdgeParams> EdgeParamsPtr;
+typedef boost::shared_ptr<const ConnectionParams> ConnectionParamsPtr;
+
+
+/**
+ * Graph Parameters.
+ * Immutable parameter blocks, one per element type and shared by all its
+ * elements. Settings build a new version of the blocks under the lock,
+ * the graph pins it at the start of a frame, so a block read during a
+ * frame stays valid until the next pin.
+ */
+class Params {
+    
+    // public
+    public:
+    
+    // Cinder
+    static void config(const Configuration &c);
+    static void defaults(const Defaults &d);
+    
+    // Business
+    static void pin();
+    static const NodeParams& node();
+    static const EdgeParams& edge();
+    static const ConnectionParams& connection();
+    static int version();
+    
+    
+    // private
+    private:
+    
+    // config
+    static bool redux;
+    static float dpr;
+    static Defaults dflts;
+    
+    // built blocks
+    static boost::mutex mutex;
+    static int cversion;
+    static NodeParamsPtr nblock;
+    static EdgeParamsPtr eblock;
+    static ConnectionParamsPtr cblock;
+    
+    // pinned blocks
+    static int pversion;
+    static NodeParamsPtr nparams;
+    static EdgeParamsPtr eparams;
+    static ConnectionParamsPtr cparams;
+    
+    // Helpers
+    static void build();
+    
+};
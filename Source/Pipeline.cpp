@@ -0,0 +1,498 @@
+//
+//  Pipeline.cpp
+//  Solyaris
+//
+//  Created by CNPP on 19.10.2026.
+//  Copyright 2026 Beat Raess. All rights reserved.
+//
+//  This file is part of Solyaris.
+//
+//  Solyaris is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  Solyaris is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with Solyaris.  If not, see www.gnu.org/licenses/.
+
+
+#include "Pipeline.h"
+#include <boost/bind.hpp>
+#include <cstring>
+
+
+#pragma mark -
+#pragma mark PipelineToken
+
+/**
+ * Creates a live token.
+ */
+PipelineToken::PipelineToken() {
+    flag = 0;
+}
+
+/**
+ * Cancels the load, from any thread.
+ */
+void PipelineToken::cancel() {
+    __sync_lock_test_and_set(&flag, 1);
+}
+
+/**
+ * Load was cancelled.
+ */
+bool PipelineToken::cancelled() const {
+    return flag != 0;
+}
+
+
+#pragma mark -
+#pragma mark Object
+
+/**
+ * Creates a pipeline fetching through the scheduler. The request maps a
+ * node to its credits request, mutate receives the graph batch.
+ */
+Pipeline::Pipeline(Fetch *f, const PipelineRequest &r, const PipelineMutate &m) {
+    fetch = f;
+    request = r;
+    mutate = m;
+    persistence = NULL;
+    crews = true;
+    sequence = 0;
+    memset(&info, 0, sizeof(info));
+    running = false;
+    handle = HandlePtr(new Handle());
+    handle->pipeline = this;
+}
+
+/**
+ * Stops the executor, fetches coming back later find the handle empty.
+ */
+Pipeline::~Pipeline() {
+    this->stop();
+    boost::recursive_mutex::scoped_lock lock(handle->mutex);
+    handle->pipeline = NULL;
+}
+
+
+#pragma mark -
+#pragma mark Business
+
+/**
+ * Starts the executor.
+ */
+void Pipeline::start(int n) {
+    boost::mutex::scoped_lock lock(mutex);
+    if (running) {
+        return;
+    }
+    running = true;
+    for (int w = 0; w < max(1, n); w++) {
+        workers.create_thread(boost::bind(&Pipeline::worker, this));
+    }
+}
+
+/**
+ * Stops the executor after the current steps and cancels all loads.
+ */
+void Pipeline::stop() {
+    {
+        boost::mutex::scoped_lock lock(mutex);
+        running = false;
+        signal.notify_all();
+    }
+    workers.join_all();
+    this->cancel();
+}
+
+/**
+ * Loads the credits of a node. A pending load of the node is raised to the
+ * priority instead; when full, the load takes the place of the lowest one
+ * below it, queued or fetching, or is rejected.
+ */
+PipelineTokenPtr Pipeline::load(const string &type, int id, PipelinePriority priority) {
+    string nid = CreditsIngest::node(type, id);
+    TaskPtr t;
+    TaskPtr victim;
+    bool promote = false;
+    {
+        boost::mutex::scoped_lock lock(mutex);
+        info.submitted++;
+
+        // pending
+        std::map<string,TaskPtr>::iterator pending = tasks.find(nid);
+        if (pending != tasks.end()) {
+            t = pending->second;
+            if (priority > t->priority) {
+                if (t->queued) {
+                    ready.erase(t);
+                    t->priority = priority;
+                    ready.insert(t);
+                }
+                else {
+                    t->priority = priority;
+                }
+                promote = t->fetching && priority == pipelineTap;
+                info.promoted++;
+            }
+        }
+
+        // backpressure
+        else {
+            if (tasks.size() >= pipelineCapacity) {
+                TaskOrder order;
+                for (std::map<string,TaskPtr>::const_iterator pending = tasks.begin(); pending != tasks.end(); ++pending) {
+                    if (pending->second->priority < priority && (! victim || order(victim, pending->second))) {
+                        victim = pending->second;
+                    }
+                }
+                if (! victim) {
+                    info.rejected++;
+                }
+            }
+
+            // task
+            t = TaskPtr(new Task());
+            t->nid = nid;
+            t->type = type;
+            t->id = id;
+            t->priority = priority;
+            t->sequence = sequence++;
+            t->stage = pipelineFetch;
+            t->token = PipelineTokenPtr(new PipelineToken());
+            t->queued = false;
+            t->fetching = false;
+            t->finished = false;
+            if (tasks.size() < pipelineCapacity || victim) {
+                tasks[nid] = t;
+                t->queued = true;
+                ready.insert(t);
+                signal.notify_one();
+            }
+            else {
+                t->token->cancel();
+                t->finished = true;
+            }
+        }
+    }
+
+    // rejected
+    if (t->finished) {
+        if (completion) {
+            completion(nid, pipelineRejected);
+        }
+        return t->token;
+    }
+
+    // make room
+    if (victim) {
+        this->abort(victim, pipelineRejected);
+    }
+
+    // raise the fetch in flight
+    if (promote) {
+        fetch->request(request(type, id), FetchCallback());
+    }
+    return t->token;
+}
+
+/**
+ * Cancels the load of a node and its fetch, e.g. when it is closed or
+ * unloaded.
+ */
+void Pipeline::cancel(const string &nid) {
+    TaskPtr t;
+    {
+        boost::mutex::scoped_lock lock(mutex);
+        std::map<string,TaskPtr>::iterator pending = tasks.find(nid);
+        if (pending == tasks.end()) {
+            return;
+        }
+        t = pending->second;
+    }
+    this->abort(t, pipelineCancelled);
+}
+
+/**
+ * Cancels all loads.
+ */
+void Pipeline::cancel() {
+    vector<TaskPtr> pending;
+    {
+        boost::mutex::scoped_lock lock(mutex);
+        for (std::map<string,TaskPtr>::iterator t = tasks.begin(); t != tasks.end(); ++t) {
+            pending.push_back(t->second);
+        }
+    }
+    for (vector<TaskPtr>::iterator t = pending.begin(); t != pending.end(); ++t) {
+        this->abort(*t, pipelineCancelled);
+    }
+}
+
+
+#pragma mark -
+#pragma mark Settings
+
+/**
+ * Persists the credits in the store, writes are serialized.
+ */
+void Pipeline::store(Store *s) {
+    boost::mutex::scoped_lock lock(smutex);
+    persistence = s;
+}
+
+/**
+ * Crew gets nodes of its own.
+ */
+void Pipeline::crew(bool enabled) {
+    boost::mutex::scoped_lock lock(mutex);
+    crews = enabled;
+}
+
+/**
+ * Called with the outcome of every load.
+ */
+void Pipeline::done(const PipelineDone &callback) {
+    boost::mutex::scoped_lock lock(mutex);
+    completion = callback;
+}
+
+
+#pragma mark -
+#pragma mark Accessors
+
+/**
+ * Loads not finished yet.
+ */
+size_t Pipeline::pending() {
+    boost::mutex::scoped_lock lock(mutex);
+    return tasks.size();
+}
+
+/**
+ * Counters since creation.
+ */
+PipelineStats Pipeline::stats() {
+    boost::mutex::scoped_lock lock(mutex);
+    return info;
+}
+
+
+#pragma mark -
+#pragma mark Helpers
+
+/**
+ * Steps the most urgent task until stopped.
+ */
+void Pipeline::worker() {
+    boost::mutex::scoped_lock lock(mutex);
+    while (running) {
+
+        // idle
+        if (ready.empty()) {
+            signal.wait(lock);
+            continue;
+        }
+
+        // next
+        TaskPtr t = *ready.begin();
+        ready.erase(ready.begin());
+        t->queued = false;
+
+        // step
+        lock.unlock();
+        this->step(t);
+        lock.lock();
+    }
+}
+
+/**
+ * Runs the current stage of a task and queues the next one.
+ */
+void Pipeline::step(const TaskPtr &t) {
+
+    // cancelled
+    if (t->token->cancelled()) {
+        this->finish(t, pipelineCancelled);
+        return;
+    }
+
+    // stage
+    switch (t->stage) {
+
+        // fetch, resumed by the callback; taps go first, the rest as prefetch
+        case pipelineFetch: {
+            PipelinePriority priority;
+            {
+                boost::mutex::scoped_lock lock(mutex);
+                if (t->finished) {
+                    return;
+                }
+                t->fetching = true;
+                priority = t->priority;
+            }
+            FetchCallback callback = boost::bind(&Pipeline::arrived, handle, t, _1);
+            if (priority == pipelineTap) {
+                fetch->request(request(t->type, t->id), callback);
+            }
+            else {
+                fetch->prefetch(request(t->type, t->id), callback);
+            }
+            break;
+        }
+
+        // parse
+        case pipelineParse: {
+            CreditsIngest ingest(t->type);
+            if (! ingest.feed(t->body.data(), t->body.size()) || ! ingest.finish()) {
+                this->finish(t, pipelineFailed);
+                return;
+            }
+            t->credits = ingest.credits();
+            string().swap(t->body);
+            this->resume(t, pipelinePersist);
+            break;
+        }
+
+        // persist
+        case pipelinePersist: {
+            boost::mutex::scoped_lock lock(smutex);
+            if (persistence && ! persistence->putCredits(t->id, t->type, t->credits)) {
+                lock.unlock();
+                this->finish(t, pipelineFailed);
+                return;
+            }
+            lock.unlock();
+            this->resume(t, pipelineMutate);
+            break;
+        }
+
+        // mutate
+        case pipelineMutate: {
+            MutationBatch batch;
+            bool crew;
+            {
+                boost::mutex::scoped_lock lock(mutex);
+                crew = crews;
+            }
+            CreditsIngest::batch(t->type, t->id, t->credits, crew, batch);
+            if (mutate) {
+                mutate(batch);
+            }
+            this->finish(t, pipelineDone);
+            break;
+        }
+    }
+}
+
+/**
+ * The fetch came back, parse next.
+ */
+void Pipeline::fetched(const TaskPtr &t, const FetchResult &result) {
+    {
+        boost::mutex::scoped_lock lock(mutex);
+        t->fetching = false;
+    }
+
+    // failed
+    if (result.status != fetchOk) {
+        this->finish(t, (result.status == fetchCancelled) ? pipelineCancelled : pipelineFailed);
+        return;
+    }
+
+    // parse
+    t->body = result.body;
+    this->resume(t, pipelineParse);
+}
+
+/**
+ * Ends a task early and drops its fetch.
+ */
+void Pipeline::abort(const TaskPtr &t, PipelineStatus status) {
+    t->token->cancel();
+    this->finish(t, status);
+
+    // fetch
+    bool fetching;
+    {
+        boost::mutex::scoped_lock lock(mutex);
+        fetching = t->fetching;
+    }
+    if (fetching) {
+        fetch->cancel(request(t->type, t->id).url);
+    }
+}
+
+/**
+ * A fetch came back, passed on while the pipeline lives.
+ */
+void Pipeline::arrived(HandlePtr h, TaskPtr t, const FetchResult &result) {
+    boost::recursive_mutex::scoped_lock lock(h->mutex);
+    if (h->pipeline) {
+        h->pipeline->fetched(t, result);
+    }
+}
+
+/**
+ * Queues a task for its next stage.
+ */
+void Pipeline::resume(const TaskPtr &t, PipelineStage stage) {
+    boost::mutex::scoped_lock lock(mutex);
+    if (t->finished) {
+        return;
+    }
+    t->stage = stage;
+    t->queued = true;
+    ready.insert(t);
+    signal.notify_one();
+}
+
+/**
+ * Ends a task once and reports it.
+ */
+void Pipeline::finish(const TaskPtr &t, PipelineStatus status) {
+    PipelineDone callback;
+    {
+        boost::mutex::scoped_lock lock(mutex);
+        if (t->finished) {
+            return;
+        }
+        t->finished = true;
+        if (t->queued) {
+            ready.erase(t);
+            t->queued = false;
+        }
+        std::map<string,TaskPtr>::iterator pending = tasks.find(t->nid);
+        if (pending != tasks.end() && pending->second == t) {
+            tasks.erase(pending);
+        }
+
+        // stats
+        switch (status) {
+            case pipelineDone:
+                info.done++;
+                break;
+            case pipelineFailed:
+                info.failed++;
+                break;
+            case pipelineCancelled:
+                info.cancelled++;
+                break;
+            case pipelineRejected:
+                info.rejected++;
+                break;
+        }
+        callback = completion;
+    }
+
+    // report
+    if (callback) {
+        callback(t->nid, status);
+    }
+}
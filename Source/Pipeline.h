@@ -0,0 +1,216 @@
+//
+//  Pipeline.h
+//  Solyaris
+//
+//  Created by CNPP on 19.10.2026.
+//  Copyright 2026 Beat Raess. All rights reserved.
+//
+//  This file is part of Solyaris.
+//
+//  Solyaris is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  Solyaris is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with Solyaris.  If not, see www.gnu.org/licenses/.
+
+
+#pragma once
+#include "Fetch.h"
+#include "Credits.h"
+#include "Store.h"
+#include "Mutation.h"
+#include <boost/function.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/thread.hpp>
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include <map>
+#include <set>
+
+
+// namespace
+using namespace std;
+
+// constants
+const int pipelineWorkers = 2;
+const size_t pipelineCapacity = 32;
+
+// priorities, highest last
+enum PipelinePriority {
+    pipelineHistory,
+    pipelinePrefetch,
+    pipelineTap
+};
+
+// stages
+enum PipelineStage {
+    pipelineFetch,
+    pipelineParse,
+    pipelinePersist,
+    pipelineMutate
+};
+
+// status
+enum PipelineStatus {
+    pipelineDone,
+    pipelineFailed,
+    pipelineCancelled,
+    pipelineRejected
+};
+
+// typedef
+typedef boost::function<FetchRequest(const string&, int)> PipelineRequest;
+typedef boost::function<void(MutationBatch&)> PipelineMutate;
+typedef boost::function<void(const string&, PipelineStatus)> PipelineDone;
+
+
+/**
+ * Pipeline Token.
+ * Cancellation flag of a load, checked between stages.
+ */
+class PipelineToken {
+
+    // public
+    public:
+
+    // PipelineToken
+    PipelineToken();
+
+    // Business
+    void cancel();
+    bool cancelled() const;
+
+
+    // private
+    private:
+
+    // Flag
+    volatile int flag;
+
+};
+typedef boost::shared_ptr<PipelineToken> PipelineTokenPtr;
+
+/**
+ * Pipeline Stats.
+ */
+struct PipelineStats {
+    size_t submitted;
+    size_t done;
+    size_t failed;
+    size_t cancelled;
+    size_t rejected;
+    size_t promoted;
+};
+
+
+/**
+ * Load Pipeline.
+ * Loads a node as fetch, parse, persist and mutate. Each stage runs as a
+ * step of the task on a small executor and the task is queued again by
+ * priority between stages, the fetch resumes it from its callback. A tap
+ * beats a prefetch, which beats history; loads are keyed by node so a
+ * second load for a node only raises its priority. Cancelling a node drops
+ * its fetch and its work at the next step. Beyond the capacity, lower
+ * priority loads are rejected or make room for higher ones. Fetch
+ * callbacks hold a handle instead of the pipeline, so they may outlive it.
+ */
+class Pipeline {
+
+    // public
+    public:
+
+    // Pipeline
+    Pipeline(Fetch *f, const PipelineRequest &r, const PipelineMutate &m);
+    ~Pipeline();
+
+    // Business
+    void start(int workers = pipelineWorkers);
+    void stop();
+    PipelineTokenPtr load(const string &type, int id, PipelinePriority priority);
+    void cancel(const string &nid);
+    void cancel();
+
+    // Settings
+    void store(Store *s);
+    void crew(bool enabled);
+    void done(const PipelineDone &callback);
+
+    // Accessors
+    size_t pending();
+    PipelineStats stats();
+
+
+    // private
+    private:
+
+    // Task
+    struct Task {
+        string nid;
+        string type;
+        int id;
+        PipelinePriority priority;
+        uint64_t sequence;
+        PipelineStage stage;
+        PipelineTokenPtr token;
+        bool queued;
+        bool fetching;
+        bool finished;
+        string body;
+        vector<Credit> credits;
+    };
+    typedef boost::shared_ptr<Task> TaskPtr;
+
+    // Handle
+    struct Handle {
+        boost::recursive_mutex mutex;
+        Pipeline *pipeline;
+    };
+    typedef boost::shared_ptr<Handle> HandlePtr;
+
+    // Order
+    struct TaskOrder {
+        bool operator()(const TaskPtr &a, const TaskPtr &b) const {
+            return (a->priority != b->priority) ? a->priority > b->priority : a->sequence < b->sequence;
+        }
+    };
+
+    // Helpers
+    void worker();
+    void step(const TaskPtr &t);
+    void fetched(const TaskPtr &t, const FetchResult &result);
+    void abort(const TaskPtr &t, PipelineStatus status);
+    static void arrived(HandlePtr h, TaskPtr t, const FetchResult &result);
+    void resume(const TaskPtr &t, PipelineStage stage);
+    void finish(const TaskPtr &t, PipelineStatus status);
+
+    // Stages
+    Fetch *fetch;
+    PipelineRequest request;
+    PipelineMutate mutate;
+    PipelineDone completion;
+    Store *persistence;
+    bool crews;
+
+    // Tasks
+    std::map<string,TaskPtr> tasks;
+    set<TaskPtr,TaskOrder> ready;
+    uint64_t sequence;
+    PipelineStats info;
+
+    // Executor
+    boost::mutex mutex;
+    boost::mutex smutex;
+    boost::condition_variable signal;
+    boost::thread_group workers;
+    bool running;
+    HandlePtr handle;
+
+};
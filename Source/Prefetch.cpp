@@ -0,0 +1,253 @@
+//
+//  Prefetch.cpp
+//  Solyaris
+//
+//  Created by CNPP on 19.10.2026.
+//  Copyright 2026 Beat Raess. All rights reserved.
+//
+//  This file is part of Solyaris.
+//
+//  Solyaris is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  Solyaris is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with Solyaris.  If not, see www.gnu.org/licenses/.
+
+
+#include "Prefetch.h"
+#include <boost/bind.hpp>
+#include <algorithm>
+#include <set>
+#include <cstring>
+
+
+// sort
+struct PrefetchByScore {
+    bool operator()(const PrefetchCandidate &a, const PrefetchCandidate &b) const {
+        return a.score > b.score;
+    }
+};
+
+
+#pragma mark -
+#pragma mark Object
+
+/**
+ * Creates a prefetcher on the scheduler, the request maps a node id to
+ * the request of its credits.
+ */
+Prefetch::Prefetch(Fetch *f, const PrefetchRequest &r) {
+    fetch = f;
+    request = r;
+    memset(&info, 0, sizeof(info));
+}
+
+/**
+ * Drops pending prefetches.
+ */
+Prefetch::~Prefetch() {
+    this->cancel();
+}
+
+
+#pragma mark -
+#pragma mark Business
+
+/**
+ * Prefetches the best ranked candidates not yet fetched, bounded by the
+ * limit and the number in flight.
+ */
+void Prefetch::prefetch(vector<PrefetchCandidate> candidates, int limit) {
+    Prefetch::rank(candidates);
+
+    // select
+    vector<string> selected;
+    {
+        boost::mutex::scoped_lock lock(mutex);
+        this->evict(candidates);
+        int pending = 0;
+        for (std::map<string,Entry>::const_iterator e = entries.begin(); e != entries.end(); ++e) {
+            if (! e->second.done) {
+                pending++;
+            }
+        }
+        for (vector<PrefetchCandidate>::const_iterator c = candidates.begin(); c != candidates.end(); ++c) {
+            if ((int)selected.size() >= limit || pending >= prefetchPending) {
+                break;
+            }
+            if (entries.find(c->nid) == entries.end()) {
+                Entry &entry = entries[c->nid];
+                entry.issued = boost::get_system_time();
+                entry.latency = 0;
+                entry.done = false;
+                selected.push_back(c->nid);
+                info.issued++;
+                pending++;
+            }
+        }
+    }
+
+    // fetch
+    for (vector<string>::const_iterator nid = selected.begin(); nid != selected.end(); ++nid) {
+        fetch->prefetch(request(*nid), boost::bind(&Prefetch::fetched, this, *nid, _1));
+    }
+}
+
+/**
+ * The user expanded a node, counts a hit if it was prefetched.
+ */
+void Prefetch::expanded(const string &nid) {
+    boost::mutex::scoped_lock lock(mutex);
+
+    // miss
+    std::map<string,Entry>::iterator e = entries.find(nid);
+    if (e == entries.end()) {
+        info.misses++;
+    }
+    // hit
+    else if (e->second.done) {
+        info.hits++;
+        info.saved += e->second.latency;
+        entries.erase(e);
+    }
+    // in flight
+    else {
+        info.partial++;
+        info.saved += (boost::get_system_time() - e->second.issued).total_microseconds() / 1000000.0;
+        entries.erase(e);
+    }
+}
+
+/**
+ * The user navigated away, drops what is not fetched yet.
+ */
+void Prefetch::cancel() {
+    fetch->cancelPrefetch();
+
+    // pending
+    boost::mutex::scoped_lock lock(mutex);
+    for (std::map<string,Entry>::iterator e = entries.begin(); e != entries.end();) {
+        if (e->second.done) {
+            ++e;
+        }
+        else {
+            info.cancelled++;
+            entries.erase(e++);
+        }
+    }
+}
+
+/**
+ * Sorts the candidates by score, best first, one per node.
+ */
+void Prefetch::rank(vector<PrefetchCandidate> &candidates) {
+
+    // score
+    for (vector<PrefetchCandidate>::iterator c = candidates.begin(); c != candidates.end(); ++c) {
+        c->score = Prefetch::score(*c);
+    }
+    stable_sort(candidates.begin(), candidates.end(), PrefetchByScore());
+
+    // unique
+    vector<PrefetchCandidate> unique;
+    set<string> seen;
+    for (vector<PrefetchCandidate>::const_iterator c = candidates.begin(); c != candidates.end(); ++c) {
+        if (seen.insert(c->nid).second) {
+            unique.push_back(*c);
+        }
+    }
+    candidates.swap(unique);
+}
+
+/**
+ * Likelihood of an expansion: decays with the billing order, directors
+ * get a bonus and proximity to the touch adds up to one.
+ */
+double Prefetch::score(const PrefetchCandidate &c) {
+    double s = 1.0 / (1.0 + max(c.order, 0) * prefetchOrderDecay);
+    if (c.type == creditDirector) {
+        s += prefetchDirector;
+    }
+    s += prefetchProximity / (1.0 + max(c.distance, 0.0) / prefetchDistance);
+    return s;
+}
+
+
+#pragma mark -
+#pragma mark Accessors
+
+/**
+ * Counters since creation.
+ */
+PrefetchStats Prefetch::stats() {
+    boost::mutex::scoped_lock lock(mutex);
+    PrefetchStats s = info;
+    size_t expansions = s.hits + s.partial + s.misses;
+    s.hitrate = expansions ? (s.hits + s.partial) / (double)expansions : 0;
+    return s;
+}
+
+/**
+ * Entries held, in flight or fetched.
+ */
+size_t Prefetch::size() {
+    boost::mutex::scoped_lock lock(mutex);
+    return entries.size();
+}
+
+
+#pragma mark -
+#pragma mark Helpers
+
+/**
+ * A prefetch came back, the cache holds it now.
+ */
+void Prefetch::fetched(const string &nid, const FetchResult &result) {
+    boost::mutex::scoped_lock lock(mutex);
+    std::map<string,Entry>::iterator e = entries.find(nid);
+    if (e == entries.end() || e->second.done) {
+        return;
+    }
+
+    // failed
+    if (result.status != fetchOk) {
+        if (result.status == fetchCancelled) {
+            info.cancelled++;
+        }
+        entries.erase(e);
+        return;
+    }
+
+    // done
+    e->second.done = true;
+    e->second.completed = boost::get_system_time();
+    e->second.latency = result.cached ? 0 : (e->second.completed - e->second.issued).total_microseconds() / 1000000.0;
+    info.completed++;
+}
+
+/**
+ * Drops fetched entries that are no candidates anymore or older than the
+ * expiry, the cache still holds them.
+ */
+void Prefetch::evict(const vector<PrefetchCandidate> &candidates) {
+    set<string> current;
+    for (vector<PrefetchCandidate>::const_iterator c = candidates.begin(); c != candidates.end(); ++c) {
+        current.insert(c->nid);
+    }
+    boost::system_time now = boost::get_system_time();
+    for (std::map<string,Entry>::iterator e = entries.begin(); e != entries.end();) {
+        if (e->second.done && (current.find(e->first) == current.end() || (now - e->second.completed).total_seconds() > prefetchExpiry)) {
+            entries.erase(e++);
+        }
+        else {
+            ++e;
+        }
+    }
+}
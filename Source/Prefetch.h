@@ -0,0 +1,132 @@
+//
+//  Prefetch.h
+//  Solyaris
+//
+//  Created by CNPP on 19.10.2026.
+//  Copyright 2026 Beat Raess. All rights reserved.
+//
+//  This file is part of Solyaris.
+//
+//  Solyaris is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  Solyaris is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with Solyaris.  If not, see www.gnu.org/licenses/.
+
+
+#pragma once
+#include "Fetch.h"
+#include "Credits.h"
+#include <boost/function.hpp>
+#include <boost/thread.hpp>
+#include <string>
+#include <vector>
+#include <map>
+
+
+// namespace
+using namespace std;
+
+// typedef
+typedef boost::function<FetchRequest(const string&)> PrefetchRequest;
+
+// constants
+const int prefetchLimit = 6;
+const int prefetchPending = 12;
+const double prefetchOrderDecay = 0.25;
+const double prefetchDirector = 1.0;
+const double prefetchProximity = 1.0;
+const double prefetchDistance = 240.0;
+const double prefetchExpiry = 300.0;
+
+
+/**
+ * Prefetch Candidate.
+ * A visible child that is not loaded yet, order is its billing position
+ * and distance the one to the touch point.
+ */
+struct PrefetchCandidate {
+    string nid;
+    string type;
+    int order;
+    double distance;
+    double score;
+};
+
+/**
+ * Prefetch Stats.
+ * Hits were fetched before the expansion, partial ones were in flight;
+ * saved is the latency taken off expansions in seconds.
+ */
+struct PrefetchStats {
+    size_t issued;
+    size_t completed;
+    size_t cancelled;
+    size_t hits;
+    size_t partial;
+    size_t misses;
+    double hitrate;
+    double saved;
+};
+
+
+/**
+ * Prefetcher.
+ * Warms the cache with the credits of the children most likely expanded
+ * next: prominent billing, directors and nodes near the touch come first.
+ * Prefetches go out at low priority and are dropped on navigation,
+ * fetched entries expire or leave with the candidates.
+ */
+class Prefetch {
+
+    // public
+    public:
+
+    // Prefetch
+    Prefetch(Fetch *f, const PrefetchRequest &r);
+    ~Prefetch();
+
+    // Business
+    void prefetch(vector<PrefetchCandidate> candidates, int limit = prefetchLimit);
+    void expanded(const string &nid);
+    void cancel();
+    static void rank(vector<PrefetchCandidate> &candidates);
+    static double score(const PrefetchCandidate &c);
+
+    // Accessors
+    PrefetchStats stats();
+    size_t size();
+
+
+    // private
+    private:
+
+    // Entry
+    struct Entry {
+        boost::system_time issued;
+        boost::system_time completed;
+        double latency;
+        bool done;
+    };
+
+    // Helpers
+    void fetched(const string &nid, const FetchResult &result);
+    void evict(const vector<PrefetchCandidate> &candidates);
+
+    // Fetch
+    Fetch *fetch;
+    PrefetchRequest request;
+
+    // Entries
+    std::map<string,Entry> entries;
+    PrefetchStats info;
+    boost::mutex mutex;
+
+};
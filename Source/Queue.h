@@ -0,0 +1,113 @@
+//
+//  Queue.h
+//  Solyaris
+//
+//  Created by CNPP on 19.10.2026.
+//  Copyright 2026 Beat Raess. All rights reserved.
+//
+//  This file is part of Solyaris.
+//
+//  Solyaris is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  Solyaris is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with Solyaris.  If not, see www.gnu.org/licenses/.
+
+
+#pragma once
+#include <cstddef>
+
+
+/**
+ * Queue.
+ * Lock-free multi-producer single-consumer queue (Vyukov). Producers swap
+ * their cell in as head and never wait, the consumer pops behind a stub
+ * cell so head and tail do not contend. A push becomes visible to the
+ * consumer once it linked its cell. Values move in and out by swap.
+ */
+template <typename T>
+class Queue {
+
+    // public
+    public:
+
+    /**
+     * Creates an empty queue.
+     */
+    Queue() {
+        head = new Cell();
+        tail = head;
+    }
+
+    /**
+     * Drops what was not popped.
+     */
+    ~Queue() {
+        while (tail) {
+            Cell *next = tail->next;
+            delete tail;
+            tail = next;
+        }
+    }
+
+    /**
+     * Appends a value, from any thread. The value is swapped in and left
+     * empty, a batch is not copied on its way to the consumer.
+     */
+    void push(T &value) {
+        Cell *cell = new Cell();
+        cell->value.swap(value);
+        __sync_synchronize();
+        Cell *prev = __sync_lock_test_and_set(&head, cell);
+        prev->next = cell;
+    }
+
+    /**
+     * Takes the oldest value, from the consumer only.
+     */
+    bool pop(T &value) {
+        Cell *next = tail->next;
+        if (! next) {
+            return false;
+        }
+        __sync_synchronize();
+        value.swap(next->value);
+        delete tail;
+        tail = next;
+        return true;
+    }
+
+    /**
+     * Nothing to pop, from the consumer only.
+     */
+    bool empty() const {
+        return tail->next == NULL;
+    }
+
+
+    // private
+    private:
+
+    // Cell
+    struct Cell {
+        Cell() : next(NULL) {}
+        Cell * volatile next;
+        T value;
+    };
+
+    // Ends
+    Cell * volatile head;
+    Cell *tail;
+
+    // not copyable
+    Queue(const Queue &q);
+    Queue& operator=(const Queue &q);
+
+};
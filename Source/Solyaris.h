@@ -26,6 +26,10 @@
 #include "cinder/app/AppNative.h"
 #include "cinder/System.h"
 #include "Graph.h"
+#include "Dump.h"
+#include "Fetch.h"
+#include "Prefetch.h"
+#include "Pipeline.h"
 #include "SolyarisViewController.h"
 
 
@@ -35,6 +39,14 @@ using namespace ci;
 using namespace ci::app;
 
 
+// expansion
+enum SolyarisExpand {
+    solyarisMissed,
+    solyarisLoading,
+    solyarisDump,
+    solyarisCached
+};
+
 
 /**
  * Solyaris App.
@@ -68,17 +80,26 @@ class Solyaris : public AppCocoaTouch {
     
     
     // Business
-    NodePtr createNode(string nid, string type);
-    NodePtr createNode(string nid, string type, double x, double y);
-    NodePtr getNode(string nid);
-    EdgePtr createEdge(string eid, string type, NodePtr n1, NodePtr n2);
-    EdgePtr getEdge(string nid1, string nid2);
-    ConnectionPtr createConnection(string cid, string type, NodePtr n1, NodePtr n2);
-    ConnectionPtr getConnection(string nid1, string nid2);
-    void load(NodePtr n);
-    void unload(NodePtr n);
+    NodePtr createNode(const string &nid, const string &type);
+    NodePtr createNode(const string &nid, const string &type, double x, double y);
+    NodePtr getNode(const string &nid);
+    EdgePtr createEdge(const string &eid, const string &type, const NodePtr &n1, const NodePtr &n2);
+    EdgePtr getEdge(const string &nid1, const string &nid2);
+    ConnectionPtr createConnection(const string &cid, const string &type, const NodePtr &n1, const NodePtr &n2);
+    ConnectionPtr getConnection(const string &nid1, const string &nid2);
+    NodePtr applyBatch(const MutationBatch &batch, const GraphTranslate &job);
+    void post(GraphCommand &c);
+    void load(const NodePtr &n);
+    void unload(const NodePtr &n);
+    SolyarisExpand expand(const NodePtr &n, bool crew, const GraphTranslate &job);
+    void close(const NodePtr &n);
+    void abort(const string &nid);
+    void prefetch(Vec2d tpos);
+    void mutated(MutationBatch &b);
+    void failed(const string &nid, PipelineStatus status);
+    string translate(const string &job);
     void graphShift(double mx, double my);
-    Vec3d nodeCoordinates(NodePtr n);
+    Vec3d nodeCoordinates(const NodePtr &n);
     
     
     // Fields
@@ -100,6 +121,15 @@ class Solyaris : public AppCocoaTouch {
     // graph
     Graph graph;
     
+    // data
+    Dump dump;
+    boost::shared_ptr<FetchHTTP> http;
+    boost::shared_ptr<Cache> cache;
+    boost::shared_ptr<Fetch> fetch;
+    boost::shared_ptr<Prefetch> prefetcher;
+    boost::shared_ptr<Pipeline> pipeline;
+    GraphTranslate translator;
+    
     // color
     Color bg;
     
@@ -22,6 +22,28 @@
 
 #include "Solyaris.h"
 #include "Device.h"
+#import "APIKeys.h"
+#include <boost/bind.hpp>
+
+
+/*
+ * Credits request of a node, the one the api issues on a load.
+ */
+static FetchRequest solyarisCredits(const string &nid) {
+    int id = atoi(nid.substr(nid.rfind('_') + 1).c_str());
+    NSString *url = (nid.compare(0, creditMovie.size(), creditMovie) == 0)
+        ? [NSString stringWithFormat:@"%@%i%@?api_key=%@",apiTMDbMovie,id,apiTMDbMovieCast,apiTMDbKey]
+        : [NSString stringWithFormat:@"%@%i%@?api_key=%@",apiTMDbPerson,id,apiTMDbPersonCredits,apiTMDbKey];
+    FetchRequest request;
+    request.url = [url UTF8String];
+    request.endpoint = "credits";
+    request.timeout = fetchTimeout;
+    return request;
+}
+static FetchRequest solyarisLoad(const string &type, int id) {
+    return solyarisCredits(CreditsIngest::node(type, id));
+}
+
 
 #pragma mark -
 #pragma mark Cinder
@@ -92,6 +114,32 @@ void Solyaris::setup() {
     tls.setTranslation(i18nTooltipCrew2, [NSLocalizedString(@"graph_tooltip_crew_2", @" of ") UTF8String]);
     graph.i18n(tls);
     
+    // dump, an imported one in the caches before the bundled one
+    NSString *dpath = [[NSSearchPathForDirectoriesInDomains(NSCachesDirectory, NSUserDomainMask, YES) lastObject] stringByAppendingPathComponent:@"graph.dump"];
+    if (! [[NSFileManager defaultManager] fileExistsAtPath:dpath]) {
+        dpath = [[NSBundle mainBundle] pathForResource:@"graph" ofType:@"dump"];
+    }
+    if (dpath && dump.open([dpath UTF8String])) {
+        FLog("graph dump %s", [dpath UTF8String]);
+    }
+    
+    // fetch, prefetched credits wait in the caches for the expansion
+    NSString *fpath = [[NSSearchPathForDirectoriesInDomains(NSCachesDirectory, NSUserDomainMask, YES) lastObject] stringByAppendingPathComponent:@"fetch"];
+    http = boost::shared_ptr<FetchHTTP>(new FetchHTTP());
+    fetch = boost::shared_ptr<Fetch>(new Fetch(http.get()));
+    cache = boost::shared_ptr<Cache>(new Cache([fpath UTF8String]));
+    if (cache->open()) {
+        fetch->cache(cache.get());
+    }
+    fetch->start();
+    prefetcher = boost::shared_ptr<Prefetch>(new Prefetch(fetch.get(), &solyarisCredits));
+    
+    // pipeline, loads what neither the dump nor the cache knows
+    pipeline = boost::shared_ptr<Pipeline>(new Pipeline(fetch.get(), &solyarisLoad, boost::bind(&Solyaris::mutated, this, _1)));
+    pipeline->done(boost::bind(&Solyaris::failed, this, _1, _2));
+    pipeline->start();
+    graph.abort(boost::bind(&Solyaris::abort, this, _1));
+    
     // Solyaris
     solyarisViewController = [[SolyarisViewController alloc] init];
     solyarisViewController.solyaris = this;
@@ -216,6 +264,10 @@ void Solyaris::reset() {
     // graph
     graph.reset();
     
+    // loads
+    prefetcher->cancel();
+    pipeline->cancel();
+    
 }
 
 
@@ -242,25 +294,28 @@ void Solyaris::touchesBegan( TouchEvent event ) {
             NodePtr node = graph.touchBegan(touch->getPos(),touch->getId());
             if (node != NULL) {
                 
+                // prefetch
+                this->prefetch(touch->getPos());
+                
                 // touch controller
                 NSString *nid = [NSString stringWithCString:node->nid.c_str() encoding:[NSString defaultCStringEncoding]];
                 
                 // info
-                if (node->action == actionInfo) {
+                if (node->info->action == actionInfo) {
                     FLog("action info");
                     
                     // info
                     [solyarisViewController nodeInfo:nid];
                 }
                 // related
-                else if (node->action == actionRelated) {
+                else if (node->info->action == actionRelated) {
                     FLog("action related");
                     
                     // related
                     [solyarisViewController nodeRelated:nid];
                 }
                 // close
-                else if (node->action == actionClose) {
+                else if (node->info->action == actionClose) {
                     FLog("action close");
                     
                     // related
@@ -378,13 +433,13 @@ void Solyaris::pinched(UIPinchGestureRecognizer* recognizer) {
 /*
  * Creates a node.
  */
-NodePtr Solyaris::createNode(string nid, string type) {
+NodePtr Solyaris::createNode(const string &nid, const string &type) {
     GLog();
     
     // graph
     return graph.createNode(nid,type);
 }
-NodePtr Solyaris::createNode(string nid, string type, double x, double y) {
+NodePtr Solyaris::createNode(const string &nid, const string &type, double x, double y) {
     GLog();
     
     // graph
@@ -394,7 +449,7 @@ NodePtr Solyaris::createNode(string nid, string type, double x, double y) {
 /*
  * Gets a node.
  */
-NodePtr Solyaris::getNode(string nid) {
+NodePtr Solyaris::getNode(const string &nid) {
     GLog();
     
     // graph
@@ -404,7 +459,7 @@ NodePtr Solyaris::getNode(string nid) {
 /*
  * Creates an edge.
  */
-EdgePtr Solyaris::createEdge(string eid, string type, NodePtr n1, NodePtr n2) {
+EdgePtr Solyaris::createEdge(const string &eid, const string &type, const NodePtr &n1, const NodePtr &n2) {
     GLog();
     
     // graph
@@ -414,7 +469,7 @@ EdgePtr Solyaris::createEdge(string eid, string type, NodePtr n1, NodePtr n2) {
 /*
  * Gets an edge.
  */
-EdgePtr Solyaris::getEdge(string nid1, string nid2) {
+EdgePtr Solyaris::getEdge(const string &nid1, const string &nid2) {
     GLog();
     
     // graph
@@ -424,7 +479,7 @@ EdgePtr Solyaris::getEdge(string nid1, string nid2) {
 /*
  * Creates a connection.
  */
-ConnectionPtr Solyaris::createConnection(string cid, string type, NodePtr n1, NodePtr n2) {
+ConnectionPtr Solyaris::createConnection(const string &cid, const string &type, const NodePtr &n1, const NodePtr &n2) {
     GLog();
     
     // graph
@@ -434,18 +489,38 @@ ConnectionPtr Solyaris::createConnection(string cid, string type, NodePtr n1, No
 /*
  * Gets a connection.
  */
-ConnectionPtr Solyaris::getConnection(string nid1, string nid2) {
+ConnectionPtr Solyaris::getConnection(const string &nid1, const string &nid2) {
     GLog();
     
     // graph
     return graph.getConnection(nid1,nid2);
 }
 
+/*
+ * Applies a mutation batch.
+ */
+NodePtr Solyaris::applyBatch(const MutationBatch &batch, const GraphTranslate &job) {
+    GLog();
+    
+    // graph
+    return graph.applyBatch(batch,job);
+}
+
+/*
+ * Posts a graph command, applied on the next frame; the command is taken.
+ */
+void Solyaris::post(GraphCommand &c) {
+    GLog();
+    
+    // graph
+    graph.post(c);
+}
+
 
 /*
  * Prepares solyaris for loading.
  */
-void Solyaris::load(NodePtr n) {
+void Solyaris::load(const NodePtr &n) {
     GLog();
     
     // graph
@@ -455,13 +530,133 @@ void Solyaris::load(NodePtr n) {
 /**
  * Unloads a node.
  */
-void Solyaris::unload(NodePtr n) {
+void Solyaris::unload(const NodePtr &n) {
     GLog();
     
     // graph
     graph.unload(n);
 }
 
+/**
+ * Expands a node from the graph dump or from prefetched credits; the pipeline
+ * loads the others. Missed only if neither can, the api loads it then.
+ */
+SolyarisExpand Solyaris::expand(const NodePtr &n, bool crew, const GraphTranslate &job) {
+    GLog();
+    
+    // prefetch
+    prefetcher->expanded(n->nid);
+    
+    // dump
+    string type = (n->type == creditMovie) ? creditMovie : creditPerson;
+    int id = atoi(n->nid.substr(n->nid.rfind('_') + 1).c_str());
+    GraphCommand command;
+    command.action = graphBatch;
+    command.job = job;
+    vector<Credit> credits;
+    SolyarisExpand expansion = solyarisCached;
+    if (dump.contains(type, id)) {
+        dump.credits(type, id, credits);
+        expansion = solyarisDump;
+    }
+    // cache
+    else {
+        string body;
+        if (cache->get(solyarisCredits(n->nid).url, body) == cacheMiss) {
+            translator = job;
+            pipeline->crew(crew);
+            pipeline->load(type, id, pipelineTap);
+            return solyarisLoading;
+        }
+        CreditsIngest ingest(type);
+        if (! ingest.feed(body.data(), body.size()) || ! ingest.finish()) {
+            return solyarisMissed;
+        }
+        credits = ingest.credits();
+    }
+    
+    // post, the dump knows the label and meta as well
+    CreditsIngest::batch(type, id, credits, crew, command.batch);
+    if (expansion == solyarisDump) {
+        command.batch.label = dump.name(type, id);
+        if (type == creditMovie) {
+            command.batch.meta = dump.meta(type, id);
+        }
+        else {
+            command.batch.subtype = dump.meta(type, id);
+        }
+    }
+    graph.post(command);
+    return expansion;
+}
+
+/**
+ * Prefetches the credits of the children most likely expanded next.
+ */
+void Solyaris::prefetch(Vec2d tpos) {
+    GLog();
+    
+    // candidates
+    vector<PrefetchCandidate> candidates;
+    graph.candidates(tpos, candidates);
+    prefetcher->prefetch(candidates);
+}
+
+/**
+ * Closes a node, its children will not be expanded soon.
+ */
+void Solyaris::close(const NodePtr &n) {
+    GLog();
+    
+    // node
+    n->close();
+    
+    // loads
+    prefetcher->cancel();
+    this->abort(n->nid);
+}
+
+/**
+ * Drops the pending load of a node with its fetch.
+ */
+void Solyaris::abort(const string &nid) {
+    GLog();
+    
+    // pipeline
+    pipeline->cancel(nid);
+}
+
+/**
+ * A pipeline load is through, applied on the next frame. From a pipeline
+ * worker, the jobs are translated on the main thread.
+ */
+void Solyaris::mutated(MutationBatch &b) {
+    GraphCommand command;
+    command.action = graphBatch;
+    command.batch.swap(b);
+    command.job = boost::bind(&Solyaris::translate, this, _1);
+    graph.post(command);
+}
+
+/**
+ * A pipeline load gave up, the node stops loading on the next frame.
+ */
+void Solyaris::failed(const string &nid, PipelineStatus status) {
+    if (status == pipelineFailed || status == pipelineRejected) {
+        GraphCommand command;
+        command.action = graphUnload;
+        command.nid = nid;
+        graph.post(command);
+    }
+}
+
+/**
+ * Translates a job with the translation of the last expansion.
+ */
+string Solyaris::translate(const string &job) {
+    return translator ? translator(job) : job;
+}
+
 /**
  * Shifts the graph.
  */
@@ -475,11 +670,11 @@ void Solyaris::graphShift(double mx, double my) {
 /**
  * Calculates a node's real world coordinates.
  */
-Vec3d Solyaris::nodeCoordinates(NodePtr n) {
+Vec3d Solyaris::nodeCoordinates(const NodePtr &n) {
     GLog();
     
     // calculate real world position
-    return graph.coordinates(n->pos.x, n->pos.y, n->radius);
+    return graph.coordinates(n->body->pos.x, n->body->pos.y, n->body->radius);
 }
 
 
@@ -113,6 +113,12 @@
 #define kAlphaModalRelated              0.06f
 #define kAlphaModalSearch               0.03f
 
+// helpers
+static string solyarisJob(const string &job) {
+    NSString *translated = [SolyarisLocalization translateTMDbJob:[NSString stringWithUTF8String:job.c_str()]];
+    return translated ? [translated UTF8String] : job;
+}
+
 
 #pragma mark -
 #pragma mark Properties
@@ -587,6 +593,9 @@
 - (void)loadedMovie:(Movie*)movie {
     DLog();
     
+    // allocations
+    long acount = Alloc::count();
+    
     // node
     NodePtr node;
     NSString *nid = [self makeNodeId:movie.mid type:typeMovie];
@@ -604,81 +613,66 @@
             [yearFormatter setDateFormat:@"yyyy"];
         }
         
-        // properties
-        node->renderLabel([movie.title UTF8String]);
-        node->updateCategory([movie.category UTF8String]);
-        if (movie.released) {
-            node->updateMeta([[yearFormatter stringFromDate:movie.released] UTF8String]);
+        // actors, none once expanded
+        NSArray *persons = [NSArray array];
+        if (! node->isActive()) {
+            NSSortDescriptor *psorter = [[NSSortDescriptor alloc] initWithKey:@"order" ascending:YES];
+            persons = [[movie.persons allObjects] sortedArrayUsingDescriptors:[NSArray arrayWithObject:psorter]];
+            [psorter release];
         }
         
-        
-        // actors
-        NSSortDescriptor *psorter = [[NSSortDescriptor alloc] initWithKey:@"order" ascending:YES];
-        NSArray *persons = [[movie.persons allObjects] sortedArrayUsingDescriptors:[NSArray arrayWithObject:psorter]];
-        [psorter release];
-        
         // enablers
         bool crew_enabled = [(SolyarisAppDelegate*)[[UIApplication sharedApplication] delegate] getUserDefaultBool:udGraphCrewEnabled];
         
-        // create nodes
+        // batch, built in the command
+        GraphCommand command;
+        command.action = graphBatch;
+        command.job = solyarisJob;
+        MutationBatch &batch = command.batch;
+        batch.nid = [nid UTF8String];
+        batch.type = [typeMovie UTF8String];
+        batch.label = [movie.title UTF8String];
+        batch.category = [movie.category UTF8String];
+        if (movie.released) {
+            batch.meta = [[yearFormatter stringFromDate:movie.released] UTF8String];
+        }
+        
+        // expanded, only the details
+        if (node->isActive()) {
+            command.action = graphDescribe;
+        }
+        batch.mutations.reserve([persons count]);
+        
+        // credits
         for (Movie2Person *m2p in persons) {
-            
-            // exclude crew
-            bool exclude_crew = NO;
-            if (! crew_enabled && [m2p.type isEqualToString:typePersonCrew]) {
-                exclude_crew = YES;
-            }
+            Mutation m;
             
             // child
-            NSString *cid = [self makeNodeId:m2p.person.pid type:typePerson];
-            NodePtr child = solyaris->getNode([cid UTF8String]);
-            bool existing = true;
-            if (child == NULL) {
-                existing = false;
-                 
-                // new child
-                if (! exclude_crew) {
-                    child = solyaris->createNode([cid UTF8String],[typePerson UTF8String], node->pos.x, node->pos.y);
-                    child->updateType([m2p.type UTF8String]);
-                    child->renderLabel([m2p.person.name UTF8String]);
-                }
-            }
+            m.ctype = [typePerson UTF8String];
+            m.cid = [[self makeNodeId:m2p.person.pid type:typePerson] UTF8String];
+            m.csubtype = [m2p.type UTF8String];
+            m.clabel = [m2p.person.name UTF8String];
             
-            // add to node
-            if (! exclude_crew) {
-                node->addChild(child);
-            }
-            
-            // create edge
-            EdgePtr edge = solyaris->getEdge([nid UTF8String], [cid UTF8String]);
-            if (edge == NULL) {
-                
-                // this is the edge
-                NSString *eid = [self makeEdgeId:nid to:cid];
-                edge = solyaris->createEdge([eid UTF8String],[typePerson UTF8String],node,child);
-                
-                // type
-                edge->updateType([m2p.type UTF8String]);
-                
-                // label
-                NSString *clabel = m2p.character;
-                if ([m2p.type isEqualToString:typePersonDirector] || [m2p.type isEqualToString:typePersonCrew]) {
-                    clabel = [SolyarisLocalization translateTMDbJob:m2p.job];
-                }
-                
-                // render
-                edge->renderLabel([clabel UTF8String]);
-            }
-            if (existing) {
-                edge->show();
-            }
+            // edge
+            m.eid = batch.nid + "_edge_" + m.cid;
+            m.etype = m.csubtype;
+            m.job = [m2p.type isEqualToString:typePersonDirector] || [m2p.type isEqualToString:typePersonCrew];
+            m.elabel = m.job ? [m2p.job UTF8String] : [m2p.character UTF8String];
             
+            // exclude crew
+            m.excluded = ! crew_enabled && [m2p.type isEqualToString:typePersonCrew];
+            batch.mutations.push_back(m);
         }
         
-        // loaded
-        node->loaded();
+        // post, applied on the next frame
+        solyaris->post(command);
         
     }
+    
+    // allocations
+    if (Alloc::count() > acount) {
+        FLog("%ld allocations", Alloc::count() - acount);
+    }
 
 }
 
@@ -688,6 +682,9 @@
 - (void)loadedPerson:(Person*)person {
     DLog();
     
+    // allocations
+    long acount = Alloc::count();
+    
     
     // node
     NodePtr node;
@@ -706,68 +703,84 @@
             [yearFormatter setDateFormat:@"yyyy"];
         }
         
-        // properties
-        node->renderLabel([person.name UTF8String]);
-        node->updateType([person.type UTF8String]);
-        
-        // movies
-        NSSortDescriptor *msorter = [[NSSortDescriptor alloc] initWithKey:@"year" ascending:NO];
-        NSArray *movies = [[person.movies allObjects] sortedArrayUsingDescriptors:[NSArray arrayWithObject:msorter]];
-        [msorter release];
+        // movies, none once expanded
+        NSArray *movies = [NSArray array];
+        if (! node->isActive()) {
+            NSSortDescriptor *msorter = [[NSSortDescriptor alloc] initWithKey:@"year" ascending:NO];
+            movies = [[person.movies allObjects] sortedArrayUsingDescriptors:[NSArray arrayWithObject:msorter]];
+            [msorter release];
+        }
         
+        // batch, built in the command
+        GraphCommand command;
+        command.action = graphBatch;
+        command.job = solyarisJob;
+        MutationBatch &batch = command.batch;
+        batch.nid = [nid UTF8String];
+        batch.type = [typePerson UTF8String];
+        batch.subtype = [person.type UTF8String];
+        batch.label = [person.name UTF8String];
+        
+        // expanded, only the details
+        if (node->isActive()) {
+            command.action = graphDescribe;
+        }
+        batch.mutations.reserve([movies count]);
         
-        // create nodes
+        // credits
         for (Movie2Person *m2p in movies) {
+            Mutation m;
             
             // child
-            NSString *cid = [self makeNodeId:m2p.movie.mid type:typeMovie];
-            NodePtr child = solyaris->getNode([cid UTF8String]);
-            bool existing = true;
-            if (child == NULL) {
-                existing = false;
-                
-                // new child
-                child = solyaris->createNode([cid UTF8String],[typeMovie UTF8String], node->pos.x, node->pos.y);
-                child->renderLabel([m2p.movie.title UTF8String]);
-                if (m2p.year) {
-                    child->updateMeta([[yearFormatter stringFromDate:m2p.year] UTF8String]);
-                }
-            }
-            
-            // add to node
-            node->addChild(child);
-            
-            // create edge
-            EdgePtr edge = solyaris->getEdge([nid UTF8String], [cid UTF8String]);
-            if (edge == NULL) {
-                
-                // on the edge
-                NSString *eid = [self makeEdgeId:nid to:cid];
-                edge = solyaris->createEdge([eid UTF8String],[typeMovie UTF8String],node,child);
-                
-                // type
-                edge->updateType([m2p.type UTF8String]);
-                
-                // label
-                NSString *clabel = m2p.character;
-                if ([m2p.type isEqualToString:typePersonDirector] || [m2p.type isEqualToString:typePersonCrew]) {
-                    clabel = [SolyarisLocalization translateTMDbJob:m2p.job];
-                }
-                
-                // render
-                edge->renderLabel([clabel UTF8String]);
-            }
-            if (existing) {
-                edge->show();
+            m.ctype = [typeMovie UTF8String];
+            m.cid = [[self makeNodeId:m2p.movie.mid type:typeMovie] UTF8String];
+            m.clabel = [m2p.movie.title UTF8String];
+            if (m2p.year) {
+                m.cmeta = [[yearFormatter stringFromDate:m2p.year] UTF8String];
             }
             
+            // edge
+            m.eid = batch.nid + "_edge_" + m.cid;
+            m.etype = [m2p.type UTF8String];
+            m.job = [m2p.type isEqualToString:typePersonDirector] || [m2p.type isEqualToString:typePersonCrew];
+            m.elabel = m.job ? [m2p.job UTF8String] : [m2p.character UTF8String];
+            m.excluded = false;
+            batch.mutations.push_back(m);
         }
         
-        // loaded
-        node->loaded();
+        // post, applied on the next frame
+        solyaris->post(command);
         
     }
     
+    // allocations
+    if (Alloc::count() > acount) {
+        FLog("%ld allocations", Alloc::count() - acount);
+    }
+
+}
+
+/*
+ * Loaded movie info, the details a dump expansion lacks.
+ */
+- (void)loadedMovieInfo:(Movie*)movie {
+    DLog();
+    
+    // node
+    NodePtr node;
+    NSString *nid = [self makeNodeId:movie.mid type:typeMovie];
+    if (movie != NULL) {
+        node = solyaris->getNode([nid UTF8String]);
+    }
+    
+    // describe
+    if (movie != NULL && node != NULL) {
+        GraphCommand command;
+        command.action = graphDescribe;
+        command.batch.nid = [nid UTF8String];
+        command.batch.category = [movie.category UTF8String];
+        solyaris->post(command);
+    }
 }
 
 /*
@@ -949,6 +962,10 @@
         // solyaris
         solyaris->load(node);
         
+        // expand, from the dump, the caches or the pipeline
+        bool crew_enabled = [(SolyarisAppDelegate*)[[UIApplication sharedApplication] delegate] getUserDefaultBool:udGraphCrewEnabled];
+        SolyarisExpand expansion = solyaris->expand(node, crew_enabled, solyarisJob);
+        
         // node
         NSNumber *dbid = [self toDBId:nid];
         
@@ -962,13 +979,22 @@
         [Tracker trackEvent:TEventLoad action:@"Graph" label:type];
         
         
-        // movie
-        if ([type isEqualToString:typeMovie]) {
-            [tmdb performSelector:@selector(movie:) withObject:dbid afterDelay:kDelayTimeNodeLoad];
+        // dump, the api only adds the category
+        if (expansion == solyarisDump && [type isEqualToString:typeMovie]) {
+            [tmdb performSelector:@selector(movieInfo:) withObject:dbid afterDelay:kDelayTimeNodeLoad];
         }
-        // person
-        else {
-            [tmdb performSelector:@selector(person:) withObject:dbid afterDelay:kDelayTimeNodeLoad];
+        
+        // api, only if nothing expands it
+        if (expansion == solyarisMissed) {
+            
+            // movie
+            if ([type isEqualToString:typeMovie]) {
+                [tmdb performSelector:@selector(movie:) withObject:dbid afterDelay:kDelayTimeNodeLoad];
+            }
+            // person
+            else {
+                [tmdb performSelector:@selector(person:) withObject:dbid afterDelay:kDelayTimeNodeLoad];
+            }
         }
         
     }
@@ -1026,8 +1052,8 @@
             // properties node
             NSNumber *nid = [self toDBId:[NSString stringWithCString:(*child)->nid.c_str() encoding:NSUTF8StringEncoding]];
             NSString *type = [NSString stringWithCString:(*child)->type.c_str() encoding:NSUTF8StringEncoding];
-            NSString *label = [NSString stringWithCString:(*child)->label.c_str() encoding:NSUTF8StringEncoding];
-            NSString *meta = [NSString stringWithCString:(*child)->meta.c_str() encoding:NSUTF8StringEncoding];
+            NSString *label = [NSString stringWithCString:(*child)->info->label.c_str() encoding:NSUTF8StringEncoding];
+            NSString *meta = [NSString stringWithCString:(*child)->info->meta.c_str() encoding:NSUTF8StringEncoding];
             NSString *thumb = [type isEqualToString:typeMovie] ? [tmdb movieThumb:nid] : [tmdb personThumb:nid];
             bool visible = (*child)->isVisible();
             bool loaded = ( (*child)->isActive() || (*child)->isLoading() );
@@ -1109,7 +1135,7 @@
     
     // close
     if (node->isActive()) {
-        node->close();
+        solyaris->close(node);
     }
 }
 
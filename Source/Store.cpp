@@ -0,0 +1,521 @@
+//
+//  Store.cpp
+//  Solyaris
+//
+//  Created by CNPP on 19.10.2026.
+//  Copyright 2026 Beat Raess. All rights reserved.
+//
+//  This file is part of Solyaris.
+//
+//  Solyaris is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  Solyaris is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with Solyaris.  If not, see www.gnu.org/licenses/.
+
+#include "Store.h"
+
+
+// schema
+static const char *storeTables =
+    "CREATE TABLE IF NOT EXISTS movies (mid INTEGER PRIMARY KEY, title TEXT, category TEXT, released TEXT, imdb TEXT, overview TEXT, homepage TEXT, tagline TEXT, runtime INTEGER, loaded INTEGER DEFAULT 0, details INTEGER DEFAULT 0, related INTEGER DEFAULT 0, timestamp INTEGER);"
+    "CREATE TABLE IF NOT EXISTS persons (pid INTEGER PRIMARY KEY, name TEXT, type TEXT, birthday TEXT, deathday TEXT, birthplace TEXT, biography TEXT, casts INTEGER, loaded INTEGER DEFAULT 0, timestamp INTEGER);"
+    "CREATE TABLE IF NOT EXISTS credits (mid INTEGER NOT NULL, pid INTEGER NOT NULL, type TEXT, character TEXT, department TEXT, job TEXT, ord INTEGER, year TEXT, PRIMARY KEY (mid, pid));"
+    "CREATE INDEX IF NOT EXISTS credits_pid ON credits (pid);"
+    "CREATE TABLE IF NOT EXISTS favorites (type TEXT NOT NULL, dbid INTEGER NOT NULL, title TEXT, meta TEXT, link TEXT, sort INTEGER, created INTEGER, PRIMARY KEY (type, dbid));";
+
+// statements
+static const char *storeStatements[] = {
+    "SELECT mid, title, category, released, imdb, overview, homepage, tagline, runtime, loaded, details, related, timestamp FROM movies WHERE mid = ?",
+    "INSERT OR REPLACE INTO movies (mid, title, category, released, imdb, overview, homepage, tagline, runtime, loaded, details, related, timestamp) VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?)",
+    "SELECT pid, name, type, birthday, deathday, birthplace, biography, casts, loaded, timestamp FROM persons WHERE pid = ?",
+    "INSERT OR REPLACE INTO persons (pid, name, type, birthday, deathday, birthplace, biography, casts, loaded, timestamp) VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?)",
+    "SELECT c.mid, c.pid, p.name, c.type, c.character, c.department, c.job, c.year, c.ord FROM credits c JOIN persons p ON p.pid = c.pid WHERE c.mid = ? ORDER BY c.ord",
+    "SELECT c.mid, c.pid, m.title, c.type, c.character, c.department, c.job, c.year, c.ord FROM credits c JOIN movies m ON m.mid = c.mid WHERE c.pid = ? ORDER BY c.year DESC",
+    "INSERT OR REPLACE INTO credits (mid, pid, type, character, department, job, ord, year) VALUES (?, ?, ?, ?, ?, ?, ?, ?)",
+    "INSERT OR IGNORE INTO movies (mid, title, released) VALUES (?, ?, ?)",
+    "INSERT OR IGNORE INTO persons (pid, name, type) VALUES (?, ?, ?)",
+    "SELECT dbid, type, title, meta, link, sort, created FROM favorites WHERE type = ? ORDER BY sort",
+    "INSERT OR REPLACE INTO favorites (type, dbid, title, meta, link, sort, created) VALUES (?, ?, ?, ?, ?, ?, ?)",
+    "DELETE FROM favorites WHERE type = ? AND dbid = ?"
+};
+
+// binding
+static void bind(sqlite3_stmt *stmt, int i, const string &s) {
+    sqlite3_bind_text(stmt, i, s.data(), s.size(), SQLITE_STATIC);
+}
+static void bind(sqlite3_stmt *stmt, int i, int64_t n) {
+    sqlite3_bind_int64(stmt, i, n);
+}
+static string text(sqlite3_stmt *stmt, int i) {
+    const unsigned char *s = sqlite3_column_text(stmt, i);
+    return s ? string((const char*)s, sqlite3_column_bytes(stmt, i)) : string();
+}
+
+
+#pragma mark -
+#pragma mark Object
+
+/**
+ * Creates a closed store.
+ */
+Store::Store() {
+    db = NULL;
+    for (int s = 0; s < stmtCount; s++) {
+        statements[s] = NULL;
+    }
+    depth = 0;
+    aborted = false;
+}
+
+/**
+ * Closes the store.
+ */
+Store::~Store() {
+    this->close();
+}
+
+
+#pragma mark -
+#pragma mark Business
+
+/**
+ * Opens the database in WAL mode and creates the schema.
+ */
+bool Store::open(const string &path) {
+
+    // open
+    this->close();
+    if (sqlite3_open_v2(path.c_str(), &db, SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE | SQLITE_OPEN_NOMUTEX, NULL) != SQLITE_OK) {
+        this->fail();
+        this->close();
+        return false;
+    }
+    sqlite3_busy_timeout(db, storeBusy);
+
+    // mode
+    if (! this->exec("PRAGMA journal_mode = WAL; PRAGMA synchronous = NORMAL;")) {
+        this->close();
+        return false;
+    }
+
+    // schema
+    char version[64];
+    sqlite3_snprintf(sizeof(version), version, "PRAGMA user_version = %d;", storeSchema);
+    if (! this->exec(storeTables) || ! this->exec(version)) {
+        this->close();
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Finalizes the statements and closes the database.
+ */
+void Store::close() {
+    for (int s = 0; s < stmtCount; s++) {
+        if (statements[s]) {
+            sqlite3_finalize(statements[s]);
+            statements[s] = NULL;
+        }
+    }
+    if (db) {
+        sqlite3_close(db);
+        db = NULL;
+    }
+    depth = 0;
+    aborted = false;
+}
+
+/**
+ * Drops the cached movies, persons and credits, favorites are kept.
+ */
+void Store::clear() {
+    this->begin();
+    if (! this->exec("DELETE FROM credits; DELETE FROM movies; DELETE FROM persons;")) {
+        this->rollback();
+        return;
+    }
+    this->commit();
+}
+
+
+#pragma mark -
+#pragma mark Transactions
+
+/**
+ * Begins a transaction, nested calls join the outer one.
+ */
+bool Store::begin() {
+    if (depth++ > 0) {
+        return true;
+    }
+    aborted = false;
+    if (! this->exec("BEGIN IMMEDIATE")) {
+        depth = 0;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Commits the outermost transaction, rolls back if a nested one failed.
+ */
+bool Store::commit() {
+    if (depth == 0) {
+        return false;
+    }
+    if (--depth > 0) {
+        return ! aborted;
+    }
+    if (aborted) {
+        this->exec("ROLLBACK");
+        return false;
+    }
+    return this->exec("COMMIT");
+}
+
+/**
+ * Aborts the transaction.
+ */
+void Store::rollback() {
+    if (depth == 0) {
+        return;
+    }
+    aborted = true;
+    if (--depth == 0) {
+        this->exec("ROLLBACK");
+    }
+}
+
+
+#pragma mark -
+#pragma mark Movies
+
+/**
+ * Movie by id.
+ */
+bool Store::movie(int mid, MovieRecord &m) {
+    sqlite3_stmt *stmt = this->statement(stmtMovie);
+    if (! stmt) {
+        return false;
+    }
+    bind(stmt, 1, mid);
+    bool found = (sqlite3_step(stmt) == SQLITE_ROW);
+    if (found) {
+        m.mid = sqlite3_column_int(stmt, 0);
+        m.title = text(stmt, 1);
+        m.category = text(stmt, 2);
+        m.released = text(stmt, 3);
+        m.imdb = text(stmt, 4);
+        m.overview = text(stmt, 5);
+        m.homepage = text(stmt, 6);
+        m.tagline = text(stmt, 7);
+        m.runtime = sqlite3_column_int(stmt, 8);
+        m.loaded = sqlite3_column_int(stmt, 9) != 0;
+        m.details = sqlite3_column_int(stmt, 10) != 0;
+        m.related = sqlite3_column_int(stmt, 11) != 0;
+        m.timestamp = sqlite3_column_int64(stmt, 12);
+    }
+    sqlite3_reset(stmt);
+    return found;
+}
+
+/**
+ * Stores a movie.
+ */
+bool Store::putMovie(const MovieRecord &m) {
+    sqlite3_stmt *stmt = this->statement(stmtPutMovie);
+    if (! stmt) {
+        return false;
+    }
+    bind(stmt, 1, m.mid);
+    bind(stmt, 2, m.title);
+    bind(stmt, 3, m.category);
+    bind(stmt, 4, m.released);
+    bind(stmt, 5, m.imdb);
+    bind(stmt, 6, m.overview);
+    bind(stmt, 7, m.homepage);
+    bind(stmt, 8, m.tagline);
+    bind(stmt, 9, m.runtime);
+    bind(stmt, 10, m.loaded);
+    bind(stmt, 11, m.details);
+    bind(stmt, 12, m.related);
+    bind(stmt, 13, m.timestamp);
+    return this->step(stmt);
+}
+
+
+#pragma mark -
+#pragma mark Persons
+
+/**
+ * Person by id.
+ */
+bool Store::person(int pid, PersonRecord &p) {
+    sqlite3_stmt *stmt = this->statement(stmtPerson);
+    if (! stmt) {
+        return false;
+    }
+    bind(stmt, 1, pid);
+    bool found = (sqlite3_step(stmt) == SQLITE_ROW);
+    if (found) {
+        p.pid = sqlite3_column_int(stmt, 0);
+        p.name = text(stmt, 1);
+        p.type = text(stmt, 2);
+        p.birthday = text(stmt, 3);
+        p.deathday = text(stmt, 4);
+        p.birthplace = text(stmt, 5);
+        p.biography = text(stmt, 6);
+        p.casts = sqlite3_column_int(stmt, 7);
+        p.loaded = sqlite3_column_int(stmt, 8) != 0;
+        p.timestamp = sqlite3_column_int64(stmt, 9);
+    }
+    sqlite3_reset(stmt);
+    return found;
+}
+
+/**
+ * Stores a person.
+ */
+bool Store::putPerson(const PersonRecord &p) {
+    sqlite3_stmt *stmt = this->statement(stmtPutPerson);
+    if (! stmt) {
+        return false;
+    }
+    bind(stmt, 1, p.pid);
+    bind(stmt, 2, p.name);
+    bind(stmt, 3, p.type);
+    bind(stmt, 4, p.birthday);
+    bind(stmt, 5, p.deathday);
+    bind(stmt, 6, p.birthplace);
+    bind(stmt, 7, p.biography);
+    bind(stmt, 8, p.casts);
+    bind(stmt, 9, p.loaded);
+    bind(stmt, 10, p.timestamp);
+    return this->step(stmt);
+}
+
+
+#pragma mark -
+#pragma mark Credits
+
+/**
+ * Credits of a movie, by order.
+ */
+int Store::creditsByMovie(int mid, vector<CreditRecord> &credits) {
+    return this->credits(stmtCreditsByMovie, mid, credits);
+}
+
+/**
+ * Credits of a person, latest first.
+ */
+int Store::creditsByPerson(int pid, vector<CreditRecord> &credits) {
+    return this->credits(stmtCreditsByPerson, pid, credits);
+}
+
+/**
+ * Imports the credit list of a movie or person in one transaction. The
+ * other side is stubbed with its name unless already stored.
+ */
+bool Store::putCredits(int id, const string &type, const vector<Credit> &credits) {
+
+    // statements
+    bool movie = (type == creditMovie);
+    sqlite3_stmt *credit = this->statement(stmtPutCredit);
+    sqlite3_stmt *stub = this->statement(movie ? stmtStubPerson : stmtStubMovie);
+    if (! credit || ! stub || ! this->begin()) {
+        return false;
+    }
+
+    // batch
+    for (vector<Credit>::const_iterator c = credits.begin(); c != credits.end(); ++c) {
+
+        // stub
+        bind(stub, 1, c->id);
+        bind(stub, 2, c->name);
+        bind(stub, 3, movie ? c->type : c->year);
+        if (! this->step(stub)) {
+            this->rollback();
+            return false;
+        }
+
+        // credit
+        bind(credit, 1, movie ? id : c->id);
+        bind(credit, 2, movie ? c->id : id);
+        bind(credit, 3, c->type);
+        bind(credit, 4, c->character);
+        bind(credit, 5, c->department);
+        bind(credit, 6, c->job);
+        bind(credit, 7, c->order);
+        bind(credit, 8, c->year);
+        if (! this->step(credit)) {
+            this->rollback();
+            return false;
+        }
+    }
+    return this->commit();
+}
+
+
+#pragma mark -
+#pragma mark Favorites
+
+/**
+ * Favorites of a type, by sort.
+ */
+int Store::favorites(const string &type, vector<FavoriteRecord> &favorites) {
+    sqlite3_stmt *stmt = this->statement(stmtFavorites);
+    if (! stmt) {
+        return 0;
+    }
+    bind(stmt, 1, type);
+    int n = 0;
+    while (sqlite3_step(stmt) == SQLITE_ROW) {
+        favorites.push_back(FavoriteRecord());
+        FavoriteRecord &f = favorites.back();
+        f.dbid = sqlite3_column_int(stmt, 0);
+        f.type = text(stmt, 1);
+        f.title = text(stmt, 2);
+        f.meta = text(stmt, 3);
+        f.link = text(stmt, 4);
+        f.sort = sqlite3_column_int(stmt, 5);
+        f.created = sqlite3_column_int64(stmt, 6);
+        n++;
+    }
+    sqlite3_reset(stmt);
+    return n;
+}
+
+/**
+ * Stores a favorite.
+ */
+bool Store::putFavorite(const FavoriteRecord &f) {
+    sqlite3_stmt *stmt = this->statement(stmtPutFavorite);
+    if (! stmt) {
+        return false;
+    }
+    bind(stmt, 1, f.type);
+    bind(stmt, 2, f.dbid);
+    bind(stmt, 3, f.title);
+    bind(stmt, 4, f.meta);
+    bind(stmt, 5, f.link);
+    bind(stmt, 6, f.sort);
+    bind(stmt, 7, f.created);
+    return this->step(stmt);
+}
+
+/**
+ * Removes a favorite.
+ */
+bool Store::removeFavorite(const string &type, int dbid) {
+    sqlite3_stmt *stmt = this->statement(stmtRemoveFavorite);
+    if (! stmt) {
+        return false;
+    }
+    bind(stmt, 1, type);
+    bind(stmt, 2, dbid);
+    return this->step(stmt);
+}
+
+
+#pragma mark -
+#pragma mark Accessors
+
+/**
+ * Last error.
+ */
+const string& Store::error() const {
+    return err;
+}
+
+
+#pragma mark -
+#pragma mark Helpers
+
+/**
+ * Executes unprepared sql.
+ */
+bool Store::exec(const char *sql) {
+    if (! db || sqlite3_exec(db, sql, NULL, NULL, NULL) != SQLITE_OK) {
+        return this->fail();
+    }
+    return true;
+}
+
+/**
+ * Prepared statement, prepared on first use and reset for reuse.
+ */
+sqlite3_stmt* Store::statement(Statement s) {
+    if (! db) {
+        return NULL;
+    }
+    if (! statements[s]) {
+        if (sqlite3_prepare_v2(db, storeStatements[s], -1, &statements[s], NULL) != SQLITE_OK) {
+            this->fail();
+            statements[s] = NULL;
+            return NULL;
+        }
+    }
+    else {
+        sqlite3_reset(statements[s]);
+        sqlite3_clear_bindings(statements[s]);
+    }
+    return statements[s];
+}
+
+/**
+ * Runs a write statement.
+ */
+bool Store::step(sqlite3_stmt *stmt) {
+    int rc = sqlite3_step(stmt);
+    sqlite3_reset(stmt);
+    if (rc != SQLITE_DONE) {
+        return this->fail();
+    }
+    return true;
+}
+
+/**
+ * Reads credit rows in place of the given ones.
+ */
+int Store::credits(Statement s, int id, vector<CreditRecord> &credits) {
+    sqlite3_stmt *stmt = this->statement(s);
+    if (! stmt) {
+        return 0;
+    }
+    bind(stmt, 1, id);
+    credits.clear();
+    int n = 0;
+    while (sqlite3_step(stmt) == SQLITE_ROW) {
+        credits.push_back(CreditRecord());
+        CreditRecord &c = credits.back();
+        c.mid = sqlite3_column_int(stmt, 0);
+        c.pid = sqlite3_column_int(stmt, 1);
+        c.name = text(stmt, 2);
+        c.type = text(stmt, 3);
+        c.character = text(stmt, 4);
+        c.department = text(stmt, 5);
+        c.job = text(stmt, 6);
+        c.year = text(stmt, 7);
+        c.order = sqlite3_column_int(stmt, 8);
+        n++;
+    }
+    sqlite3_reset(stmt);
+    return n;
+}
+
+/**
+ * Keeps the error message.
+ */
+bool Store::fail() {
+    err = db ? sqlite3_errmsg(db) : "no database";
+    return false;
+}
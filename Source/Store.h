@@ -0,0 +1,186 @@
+//
+//  Store.h
+//  Solyaris
+//
+//  Created by CNPP on 19.10.2026.
+//  Copyright 2026 Beat Raess. All rights reserved.
+//
+//  This file is part of Solyaris.
+//
+//  Solyaris is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  Solyaris is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with Solyaris.  If not, see www.gnu.org/licenses/.
+
+
+#pragma once
+#include "Credits.h"
+#include <sqlite3.h>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+
+// namespace
+using namespace std;
+
+// constants
+const int storeSchema = 1;
+const int storeBusy = 2000;
+
+
+/**
+ * Movie Record.
+ */
+struct MovieRecord {
+    int mid;
+    string title;
+    string category;
+    string released;
+    string imdb;
+    string overview;
+    string homepage;
+    string tagline;
+    int runtime;
+    bool loaded;
+    bool details;
+    bool related;
+    int64_t timestamp;
+};
+
+/**
+ * Person Record.
+ */
+struct PersonRecord {
+    int pid;
+    string name;
+    string type;
+    string birthday;
+    string deathday;
+    string birthplace;
+    string biography;
+    int casts;
+    bool loaded;
+    int64_t timestamp;
+};
+
+/**
+ * Credit Record.
+ * Movie2Person row.
+ */
+struct CreditRecord {
+    int mid;
+    int pid;
+    string name;
+    string type;
+    string character;
+    string department;
+    string job;
+    string year;
+    int order;
+};
+
+/**
+ * Favorite Record.
+ */
+struct FavoriteRecord {
+    int dbid;
+    string type;
+    string title;
+    string meta;
+    string link;
+    int sort;
+    int64_t created;
+};
+
+
+/**
+ * Store.
+ * SQLite data layer in WAL mode. The hot queries are prepared once and
+ * reused, writes are grouped by nestable transactions so a loaded movie or
+ * a whole credit list is persisted with a single commit.
+ */
+class Store {
+
+    // public
+    public:
+
+    // Store
+    Store();
+    ~Store();
+
+    // Business
+    bool open(const string &path);
+    void close();
+    void clear();
+
+    // Transactions
+    bool begin();
+    bool commit();
+    void rollback();
+
+    // Movies
+    bool movie(int mid, MovieRecord &m);
+    bool putMovie(const MovieRecord &m);
+
+    // Persons
+    bool person(int pid, PersonRecord &p);
+    bool putPerson(const PersonRecord &p);
+
+    // Credits
+    int creditsByMovie(int mid, vector<CreditRecord> &credits);
+    int creditsByPerson(int pid, vector<CreditRecord> &credits);
+    bool putCredits(int id, const string &type, const vector<Credit> &credits);
+
+    // Favorites
+    int favorites(const string &type, vector<FavoriteRecord> &favorites);
+    bool putFavorite(const FavoriteRecord &f);
+    bool removeFavorite(const string &type, int dbid);
+
+    // Accessors
+    const string& error() const;
+
+
+    // private
+    private:
+
+    // Statements
+    enum Statement {
+        stmtMovie,
+        stmtPutMovie,
+        stmtPerson,
+        stmtPutPerson,
+        stmtCreditsByMovie,
+        stmtCreditsByPerson,
+        stmtPutCredit,
+        stmtStubMovie,
+        stmtStubPerson,
+        stmtFavorites,
+        stmtPutFavorite,
+        stmtRemoveFavorite,
+        stmtCount
+    };
+
+    // Helpers
+    bool exec(const char *sql);
+    sqlite3_stmt* statement(Statement s);
+    bool step(sqlite3_stmt *stmt);
+    int credits(Statement s, int id, vector<CreditRecord> &credits);
+    bool fail();
+
+    // Database
+    sqlite3 *db;
+    sqlite3_stmt *statements[stmtCount];
+    int depth;
+    bool aborted;
+    string err;
+
+};
@@ -0,0 +1,205 @@
+//
+//  Style.cpp
+//  Solyaris
+//
+//  Created by CNPP on 19.10.2026.
+//  Copyright 2026 Beat Raess. All rights reserved.
+//
+//  This file is part of Solyaris.
+//
+//  Solyaris is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  Solyaris is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with Solyaris.  If not, see www.gnu.org/licenses/.
+
+
+#include "Style.h"
+#include "Node.h"
+
+
+// tables
+bool Style::redux = false;
+float Style::dpr = 1.0;
+vector<NodeStyle> Style::nstyles;
+vector<EdgeStyle> Style::estyles;
+map<string,NodeSkin> Style::skins;
+map<string,gl::Texture> Style::textures;
+map<string,Font> Style::fonts;
+
+
+#pragma mark -
+#pragma mark Cinder
+
+/**
+ * Applies the configuration.
+ */
+void Style::config(const Configuration &c) {
+    
+    // device
+    redux = false;
+    Config confDeviceRedux = c.getConfiguration(cDeviceRedux);
+    if (confDeviceRedux.isSet()) {
+        redux = confDeviceRedux.boolVal();
+    }
+    
+    // resolution
+    Config confDisplayResolution = c.getConfiguration(cDisplayResolution);
+    dpr = confDisplayResolution.floatVal();
+    
+    // reset (skins are keyed by resolution and stay referenced)
+    nstyles.clear();
+    estyles.clear();
+}
+
+
+#pragma mark -
+#pragma mark Business
+
+/**
+ * Node style.
+ */
+const NodeStyle& Style::node(int s) {
+    if (nstyles.empty()) {
+        prepare();
+    }
+    return nstyles[s];
+}
+
+/**
+ * Edge style.
+ */
+const EdgeStyle& Style::edge(int s) {
+    if (estyles.empty()) {
+        prepare();
+    }
+    return estyles[s];
+}
+
+/**
+ * Node skin of a kind, loaded on first use.
+ */
+const NodeSkin* Style::skin(const string &type, const string &category) {
+    
+    // suffix
+    string sfx = Configuration::sfx(dpr);
+    
+    // resources
+    string rnode = "node_person";
+    string rcore = "node_person_core";
+    string rglow = "node_person_glow";
+    if (type == nodeMovie) {
+        string cat = (category.length()) > 0 ? ("_" + category) : "";
+        rnode = "node_movie";
+        rcore = "node_movie_core" + cat;
+        rglow = "node_movie_glow" + cat;
+    }
+    else if (type == nodePersonDirector || type == nodePersonCrew) {
+        rnode = "node_crew";
+        rcore = "node_crew_core";
+        rglow = "node_crew_glow";
+    }
+    
+    // cached
+    string key = rnode + "|" + rcore + "|" + rglow + sfx;
+    map<string,NodeSkin>::iterator it = skins.find(key);
+    if (it != skins.end()) {
+        return &it->second;
+    }
+    
+    // load
+    NodeSkin skin;
+    skin.textureNode = texture(rnode + sfx);
+    skin.textureCore = texture(rcore + sfx);
+    skin.textureGlow = texture(rglow + sfx);
+    return &skins.insert(make_pair(key, skin)).first->second;
+}
+
+/**
+ * Texture by resource name.
+ */
+gl::Texture Style::texture(const string &resource) {
+    
+    // cached
+    map<string,gl::Texture>::iterator it = textures.find(resource);
+    if (it != textures.end()) {
+        return it->second;
+    }
+    
+    // load
+    gl::Texture tex = gl::Texture(loadImage(loadResource(resource)));
+    textures.insert(make_pair(resource, tex));
+    return tex;
+}
+
+/**
+ * Font by name and size.
+ */
+Font Style::font(const string &name, float size) {
+    
+    // cached
+    string key = name + "|" + boost::lexical_cast<string>(size);
+    map<string,Font>::iterator it = fonts.find(key);
+    if (it != fonts.end()) {
+        return it->second;
+    }
+    
+    // create
+    Font f = Font(name, size);
+    fonts.insert(make_pair(key, f));
+    return f;
+}
+
+
+#pragma mark -
+#pragma mark Helpers
+
+/**
+ * Prepares the style tables.
+ */
+void Style::prepare() {
+    FLog();
+    
+    // node
+    NodeStyle ns;
+    ns.font = font("Helvetica", redux ? (12 * dpr) : (13 * dpr));
+    ns.ctxt = Color(0.3,0.3,0.3);
+    ns.ctxta = Color(0.2,0.2,0.2);
+    ns.ctxts = Color(0.15,0.15,0.15);
+    ns.anode = 0.8;
+    ns.asnode = 0.9;
+    ns.acore = 0.8;
+    ns.ascore = 0.9;
+    ns.aglow = 0.3;
+    ns.asglow = 0.39;
+    ns.loff = 5 * dpr;
+    
+    // node states
+    nstyles.assign(3, ns);
+    nstyles[styleNodeLoading].font = font("Helvetica-Bold", 15 * dpr);
+    nstyles[styleNodeLoading].ctxt = Color(0.6,0.6,0.6);
+    nstyles[styleNodeLoading].loff = 6 * dpr;
+    nstyles[styleNodeUnloaded].ctxt = Color(0.75,0.75,0.75);
+    
+    // edge
+    EdgeStyle es;
+    es.font = font("Helvetica", redux ? (12 * dpr) : (13 * dpr));
+    es.cstroke = Color(0.90,0.90,0.90);
+    es.cstrokea = Color(0.90,0.90,0.90);
+    es.cstrokes = Color(0.81,0.81,0.81);
+    es.ctxt = Color(0.5,0.5,0.5);
+    es.ctxta = Color(0.5,0.5,0.5);
+    es.ctxts = Color(0.15,0.15,0.15);
+    es.loff = Vec2d(0,-13) * dpr;
+    
+    // edge states
+    estyles.assign(2, es);
+    estyles[styleEdgeActive].font = font("Helvetica-Bold", redux ? (12 * dpr) : (13 * dpr));
+}
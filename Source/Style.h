@@ -0,0 +1,132 @@
+//
+//  Style.h
+//  Solyaris
+//
+//  Created by CNPP on 19.10.2026.
+//  Copyright 2026 Beat Raess. All rights reserved.
+//
+//  This file is part of Solyaris.
+//
+//  Solyaris is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  Solyaris is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with Solyaris.  If not, see www.gnu.org/licenses/.
+
+
+#pragma once
+#include "cinder/app/AppCocoaTouch.h"
+#include "cinder/gl/gl.h"
+#include "cinder/gl/Texture.h"
+#include "cinder/ImageIo.h"
+#include "cinder/Vector.h"
+#include "cinder/Color.h"
+#include "cinder/Font.h"
+#include <vector>
+#include <map>
+#include "Configuration.h"
+
+
+// namespace
+using namespace std;
+using namespace ci;
+using namespace ci::app;
+
+
+// node styles
+const int styleNodeDefault = 0;
+const int styleNodeLoading = 1;
+const int styleNodeUnloaded = 2;
+
+// edge styles
+const int styleEdgeDefault = 0;
+const int styleEdgeActive = 1;
+
+
+/**
+ * Node style, shared by all nodes in the same state.
+ */
+struct NodeStyle {
+    Font font;
+    Color ctxt;
+    Color ctxta;
+    Color ctxts;
+    float anode,asnode;
+    float acore,ascore;
+    float aglow,asglow;
+    float loff;
+};
+
+/**
+ * Node skin, shared by all nodes of the same kind.
+ */
+struct NodeSkin {
+    gl::Texture textureNode;
+    gl::Texture textureCore;
+    gl::Texture textureGlow;
+};
+
+/**
+ * Edge style, shared by all edges in the same state.
+ */
+struct EdgeStyle {
+    Font font;
+    Color cstroke;
+    Color cstrokea;
+    Color cstrokes;
+    Color ctxt;
+    Color ctxta;
+    Color ctxts;
+    Vec2d loff;
+};
+
+
+/**
+ * Graph Style.
+ * Side tables for the styling of nodes and edges, so the elements only
+ * keep a reference to their style and skin. Textures and fonts are cached
+ * by resource name.
+ */
+class Style {
+    
+    // public
+    public:
+    
+    // Cinder
+    static void config(const Configuration &c);
+    
+    // Business
+    static const NodeStyle& node(int s);
+    static const EdgeStyle& edge(int s);
+    static const NodeSkin* skin(const string &type, const string &category);
+    static gl::Texture texture(const string &resource);
+    static Font font(const string &name, float size);
+    
+    
+    // private
+    private:
+    
+    // config
+    static bool redux;
+    static float dpr;
+    
+    // tables
+    static vector<NodeStyle> nstyles;
+    static vector<EdgeStyle> estyles;
+    static map<string,NodeSkin> skins;
+    
+    // cache
+    static map<string,gl::Texture> textures;
+    static map<string,Font> fonts;
+    
+    // Helpers
+    static void prepare();
+    
+};
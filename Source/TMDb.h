@@ -64,6 +64,7 @@
 - (void)loadedNowPlaying:(NowPlaying*)nowplaying more:(BOOL)more;
 - (void)loadedHistory:(NSArray*)history type:(NSString*)type;
 - (void)loadedMovie:(Movie*)movie;
+- (void)loadedMovieInfo:(Movie*)movie;
 - (void)loadedPerson:(Person*)person;
 - (void)loadedMovieData:(Movie*)movie;
 - (void)loadedMovieRelated:(Movie*)movie more:(BOOL)more;
@@ -106,6 +107,7 @@
 - (void)historyMovie;
 - (void)historyPerson;
 - (void)movie:(NSNumber*)mid;
+- (void)movieInfo:(NSNumber*)mid;
 - (void)movieData:(NSNumber*)mid;
 - (void)movieRelated:(NSNumber*)mid more:(BOOL)more;
 - (void)person:(NSNumber*)pid;
@@ -95,6 +95,7 @@
 - (Popular*)queryPopularMovies:(NSString*)ident retry:(BOOL)retry;
 - (NowPlaying*)queryNowPlaying:(NSString*)ident retry:(BOOL)retry;
 - (Movie*)queryMovie:(NSNumber*)mid retry:(BOOL)retry;
+- (Movie*)queryMovie:(NSNumber*)mid retry:(BOOL)retry casts:(BOOL)casts;
 - (Movie*)queryMovieDetails:(Movie*)movie retry:(BOOL)retry;
 - (Movie*)queryMovieRelated:(Movie*)movie retry:(BOOL)retry;
 - (Movie*)queryMovieCasts:(Movie*)movie retry:(BOOL)retry;
@@ -420,6 +421,36 @@
     
 }
 
+/**
+ * Movie info, without the casts.
+ */
+- (void)movieInfo:(NSNumber *)mid {
+    DLog();
+    
+    // queue
+    [queue addOperationWithBlock:^{
+        
+        // cache
+        [managedObjectContext lock];
+        Movie *movie = [self cachedMovie:mid];
+        if (movie == NULL || movie.category == NULL) {
+            movie = [self queryMovie:mid retry:YES casts:NO];
+        }
+        [managedObjectContext unlock];
+        
+        // delegate
+        [[NSOperationQueue mainQueue] addOperationWithBlock:^{
+            
+            // loaded
+            if (delegate != nil && [delegate respondsToSelector:@selector(loadedMovieInfo:)]) {
+                [delegate loadedMovieInfo:movie];
+            }
+            
+        }];
+    }];
+    
+}
+
 /**
  * Movie data.
  */
@@ -1691,6 +1722,13 @@
  * Query movie.
  */
 - (Movie*)queryMovie:(NSNumber*)mid retry:(BOOL)retry {
+    return [self queryMovie:mid retry:retry casts:YES];
+}
+
+/*
+ * Query movie, without the casts it is not loaded.
+ */
+- (Movie*)queryMovie:(NSNumber*)mid retry:(BOOL)retry casts:(BOOL)casts {
     FLog();
     
     // track
@@ -1749,7 +1787,7 @@
             FLog("Wait...");
             [NSThread sleepForTimeInterval:kTMDbTimeRetryBase+((rand() / RAND_MAX) * kTMDbTimeRetryRandom)];
             FLog("... and try again.");
-            return [self queryMovie:mid retry:NO];
+            return [self queryMovie:mid retry:NO casts:casts];
         }
         
         // note
@@ -1878,7 +1916,9 @@
         
         
         // casts
-        movie = [self queryMovieCasts:movie retry:YES];
+        if (casts) {
+            movie = [self queryMovieCasts:movie retry:YES];
+        }
     }
     
     // not good
@@ -1892,9 +1932,11 @@
     }
     
     // loaded
-    movie.loaded = [NSNumber numberWithBool:YES];
-    movie.details = [NSNumber numberWithBool:NO];
-    movie.related = [NSNumber numberWithBool:NO];
+    if (casts) {
+        movie.loaded = [NSNumber numberWithBool:YES];
+        movie.details = [NSNumber numberWithBool:NO];
+        movie.related = [NSNumber numberWithBool:NO];
+    }
     movie.timestamp = [NSDate date];
     
     // save
@@ -0,0 +1,183 @@
+//
+//  Timeline.cpp
+//  Solyaris
+//
+//  Created by CNPP on 19.10.2026.
+//  Copyright 2026 Beat Raess. All rights reserved.
+//
+//  This file is part of Solyaris.
+//
+//  Solyaris is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  Solyaris is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with Solyaris.  If not, see www.gnu.org/licenses/.
+
+
+#include "Timeline.h"
+
+
+// tweens
+vector<Tween> Timeline::tweens;
+boost::unordered_map<int,int> Timeline::positions;
+vector< pair<int,TimelineCallback> > Timeline::finished;
+boost::unordered_set<int> Timeline::due;
+double Timeline::now = 0;
+int Timeline::tids = 0;
+
+
+#pragma mark -
+#pragma mark Business
+
+/**
+ * Tweens the target to a value over duration seconds.
+ */
+int Timeline::tween(float *target, float to, double duration, int ease, const TimelineCallback &done) {
+    Tween t;
+    t.owned = false;
+    t.target = target;
+    t.from = target ? *target : 0;
+    t.to = to;
+    t.duration = duration;
+    t.ease = ease;
+    t.done = done;
+    return add(t);
+}
+int Timeline::tween(const boost::shared_ptr<void> &owner, float *target, float to, double duration, int ease, const TimelineCallback &done) {
+    Tween t;
+    t.owned = true;
+    t.owner = owner;
+    t.target = target;
+    t.from = target ? *target : 0;
+    t.to = to;
+    t.duration = duration;
+    t.ease = ease;
+    t.done = done;
+    return add(t);
+}
+
+/**
+ * Calls back after duration seconds.
+ */
+int Timeline::delay(double duration, const TimelineCallback &done) {
+    return tween(NULL, 0, duration, easeLinear, done);
+}
+
+/**
+ * Cancels a tween, its callback is not called, not even when the tween
+ * finished in the frame that is calling back.
+ */
+void Timeline::cancel(int tid) {
+    if (tid <= 0) {
+        return;
+    }
+    boost::unordered_map<int,int>::iterator p = positions.find(tid);
+    if (p != positions.end()) {
+        remove(p->second);
+        return;
+    }
+    due.erase(tid);
+}
+
+/**
+ * Evaluates the tweens.
+ */
+void Timeline::update(double dt) {
+    
+    // time
+    now += dt;
+    
+    // evaluate
+    finished.clear();
+    int t = 0;
+    while (t < (int)tweens.size()) {
+        Tween &tw = tweens[t];
+        
+        // expired owner
+        if (tw.owned && tw.owner.expired()) {
+            remove(t);
+            continue;
+        }
+        
+        // progress
+        double p = (tw.duration > 0) ? min(1.0, (now - tw.start) / tw.duration) : 1.0;
+        if (tw.target) {
+            *tw.target = tw.from + (tw.to - tw.from) * ease(tw.ease, p);
+        }
+        
+        // done
+        if (p >= 1.0) {
+            if (tw.done) {
+                finished.push_back(make_pair(tw.tid, tw.done));
+                due.insert(tw.tid);
+            }
+            remove(t);
+            continue;
+        }
+        t++;
+    }
+    
+    // callbacks (may schedule new tweens or cancel the due ones)
+    for (int f = 0; f < (int)finished.size(); f++) {
+        if (due.erase(finished[f].first)) {
+            finished[f].second();
+        }
+    }
+}
+
+/**
+ * Number of live tweens.
+ */
+int Timeline::size() {
+    return tweens.size();
+}
+
+
+#pragma mark -
+#pragma mark Helpers
+
+/**
+ * Adds a tween.
+ */
+int Timeline::add(Tween &t) {
+    t.tid = ++tids;
+    t.start = now;
+    positions[t.tid] = tweens.size();
+    tweens.push_back(t);
+    return t.tid;
+}
+
+/**
+ * Removes the tween at t, the last one takes its place.
+ */
+void Timeline::remove(int t) {
+    positions.erase(tweens[t].tid);
+    if (t != (int)tweens.size() - 1) {
+        tweens[t] = tweens.back();
+        positions[tweens[t].tid] = t;
+    }
+    tweens.pop_back();
+}
+
+/**
+ * Easing of the progress p.
+ */
+float Timeline::ease(int e, float p) {
+    switch (e) {
+        case easeIn:
+            return p * p;
+        case easeOut:
+            return p * (2 - p);
+        case easeInOut:
+            return p < 0.5 ? 2 * p * p : -1 + (4 - 2 * p) * p;
+        default:
+            return p;
+    }
+}
@@ -0,0 +1,144 @@
+//
+//  Timeline.h
+//  Solyaris
+//
+//  Created by CNPP on 19.10.2026.
+//  Copyright 2026 Beat Raess. All rights reserved.
+//
+//  This file is part of Solyaris.
+//
+//  Solyaris is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  Solyaris is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with Solyaris.  If not, see www.gnu.org/licenses/.
+
+
+#pragma once
+#include <boost/shared_ptr.hpp>
+#include <boost/weak_ptr.hpp>
+#include <boost/function.hpp>
+#include <boost/bind.hpp>
+#include <boost/unordered_map.hpp>
+#include <boost/unordered_set.hpp>
+#include <vector>
+
+
+// namespace
+using namespace std;
+
+// typedef
+typedef boost::function<void()> TimelineCallback;
+
+// easing
+const int easeLinear = 0;
+const int easeIn = 1;
+const int easeOut = 2;
+const int easeInOut = 3;
+
+
+/**
+ * Tween.
+ */
+struct Tween {
+    int tid;
+    bool owned;
+    boost::weak_ptr<void> owner;
+    float *target;
+    float from;
+    float to;
+    double start;
+    double duration;
+    int ease;
+    TimelineCallback done;
+};
+
+
+/**
+ * Animation Timeline.
+ * Keeps the running tweens and timers in a compact array that is evaluated
+ * once per frame, so the cost follows the number of live animations. Owned
+ * tweens are dropped with their owner; callbacks run after the evaluation,
+ * unless an earlier callback of the same frame cancelled their tween.
+ */
+class Timeline {
+    
+    // public
+    public:
+    
+    // Business
+    static int tween(float *target, float to, double duration, int ease, const TimelineCallback &done);
+    static int tween(const boost::shared_ptr<void> &owner, float *target, float to, double duration, int ease, const TimelineCallback &done);
+    static int delay(double duration, const TimelineCallback &done);
+    static void cancel(int tid);
+    static void update(double dt);
+    static int size();
+    
+    
+    // private
+    private:
+    
+    // Tweens
+    static vector<Tween> tweens;
+    static boost::unordered_map<int,int> positions;
+    static vector< pair<int,TimelineCallback> > finished;
+    static boost::unordered_set<int> due;
+    static double now;
+    static int tids;
+    
+    // Helpers
+    static int add(Tween &t);
+    static void remove(int t);
+    static float ease(int e, float p);
+    
+};
+
+
+/**
+ * Timeline Handle.
+ * Tween of an object, cancelled with the object. A copy starts without a
+ * tween, so callbacks bound to an object never reach a copy of it or the
+ * object once it is gone.
+ */
+class TimelineHandle {
+    
+    // public
+    public:
+    
+    // TimelineHandle
+    TimelineHandle() : tid(0) {}
+    TimelineHandle(const TimelineHandle &) : tid(0) {}
+    ~TimelineHandle() {
+        Timeline::cancel(tid);
+    }
+    
+    // Business
+    TimelineHandle& operator=(const TimelineHandle &) {
+        this->cancel();
+        return *this;
+    }
+    TimelineHandle& operator=(int t) {
+        Timeline::cancel(tid);
+        tid = t;
+        return *this;
+    }
+    void cancel() {
+        Timeline::cancel(tid);
+        tid = 0;
+    }
+    
+    
+    // private
+    private:
+    
+    // Tween
+    int tid;
+    
+};
@@ -69,7 +69,7 @@ Tooltip::Tooltip(Vec2d b) {
 /*
  * Configuration.
  */
-void Tooltip::config(Configuration c) {
+void Tooltip::config(const Configuration &c) {
     
     // device redux
     redux = false;
@@ -114,14 +114,6 @@ void Tooltip::resize(int w, int h) {
  */
 void Tooltip::update() {
    
-    // timeout (avoids flickering)
-    if (timeout > 0) {
-        timeout--;
-    }
-    else if (timeout == 0) {
-        this->activate();
-    }
-    
     // position
     if (active) {
         
@@ -172,10 +164,21 @@ void Tooltip::draw() {
 /**
  * Renders the text.
  */
-void Tooltip::renderText(vector<string> txts) {
+void Tooltip::renderText(const ArenaStrings &txts) {
     GLog();
     
     
+    // unchanged (touching the same element again keeps its texture)
+    ArenaString ntext;
+    for (ArenaStrings::const_iterator txt = txts.begin(); txt != txts.end(); ++txt) {
+        ntext.append((*txt).data(), (*txt).size());
+        ntext.push_back('\n');
+    }
+    if (! rtext.empty() && rtext.compare(0, string::npos, ntext.data(), ntext.size()) == 0) {
+        return;
+    }
+    rtext.assign(ntext.data(), ntext.size());
+    
     // text
     TextLayout tlText;
 	tlText.clear(ColorA(0, 0, 0, 0));
@@ -183,13 +186,14 @@ void Tooltip::renderText(vector<string> txts) {
 	tlText.setColor(ctxt);
     
     // lines
-    for (vector<string>::iterator txt = txts.begin(); txt != txts.end(); ++txt) {
+    for (ArenaStrings::const_iterator txt = txts.begin(); txt != txts.end(); ++txt) {
         
         // line
         tlText.setFont(sfont);
         tlText.addLine(" ");
         tlText.setFont(font);
-        tlText.addLine((*txt));
+        line.assign((*txt).data(), (*txt).size());
+        tlText.addLine(line);
     }
     
     // render
@@ -221,8 +225,8 @@ void Tooltip::renderText(vector<string> txts) {
  */
 void Tooltip::show() {
     
-    // props
-    timeout = tooltipTimeout;
+    // timeout (avoids flickering)
+    timer = Timeline::delay(tooltipTimeout, boost::bind(&Tooltip::activate, this));
     
 }
 void Tooltip::hide() {
@@ -231,7 +235,7 @@ void Tooltip::hide() {
     active = false;
     
     // nirvana it is
-    timeout = -1;
+    timer.cancel();
     dpos.set(-100000,-100000);
 
 }
@@ -246,7 +250,7 @@ void Tooltip::activate() {
     active = true;
     
     // reset timeout
-    timeout = -1;
+    timer.cancel();
 }
 
 /**
@@ -28,6 +28,8 @@
 #include "cinder/Text.h"
 #include "cinder/CinderMath.h"
 #include "Configuration.h"
+#include "Arena.h"
+#include "Timeline.h"
 
 
 // namespace
@@ -36,7 +38,7 @@ using namespace ci;
 
 
 // constants
-const int tooltipTimeout = 12;
+const double tooltipTimeout = 0.2; // s
 
 /**
  * Graph Tooltip.
@@ -52,7 +54,7 @@ class Tooltip {
     Tooltip(Vec2d b);
     
     // Cinder
-    void config(Configuration c);
+    void config(const Configuration &c);
     void resize(int w, int h);
     
     // Sketch
@@ -65,7 +67,7 @@ class Tooltip {
     void activate();
     void position(Vec2d p);
     void offset(double o);
-    void renderText(vector<string> txts);
+    void renderText(const ArenaStrings &txts);
     
     // Public Fields
     string text;
@@ -79,7 +81,7 @@ class Tooltip {
     
     // States
     bool active;
-    int timeout;
+    TimelineHandle timer;
 
     
     // position
@@ -102,4 +104,8 @@ class Tooltip {
     Vec2i maxed;
     gl::Texture	textureText;
     
+    // rendered text, line scratch (keeps its capacity)
+    string rtext;
+    string line;
+    
 };
\ No newline at end of file
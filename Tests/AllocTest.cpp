@@ -0,0 +1,134 @@
+//
+//  AllocTest.cpp
+//  Solyaris
+//
+//  Created by CNPP on 19.10.2026.
+//  Copyright 2026 Beat Raess. All rights reserved.
+//
+//  This file is part of Solyaris.
+//
+//  Solyaris is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  Solyaris is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with Solyaris.  If not, see www.gnu.org/licenses/.
+
+#include "Test.h"
+#include "Alloc.h"
+#include "Field.h"
+#include <vector>
+#include <new>
+
+
+// parameters of Params::build, dpr 1
+const double allocPerimeter = 432;
+const double allocRamp = 1.2;
+const double allocStrength = -3600;
+const double allocDamping = 41.59;
+const double allocVelocity = 900;
+const double allocThreshold = 6;
+const double allocEasing = 2.034;
+const double allocLength = 480;
+const double allocStiffness = 2160;
+const double allocEdgeDamping = 0.9;
+const double allocRadius = 60;
+const double allocTick = 1.0 / 60.0;
+
+// frames
+const int allocWarmup = 60;
+const int allocFrames = 600;
+
+
+/**
+ * Layout frame of a graph: field attraction, edge tension and integration,
+ * the steps of Graph::step that run every frame.
+ */
+struct Frame {
+    Field field;
+    vector<Vec2s> pos;
+    vector<Vec2s> mpos;
+    vector<Vec2s> velocity;
+    vector<Vec2s> force;
+    vector< pair<int,int> > links;
+
+    void step() {
+        
+        // attract
+        field.clear();
+        for (size_t v = 0; v < pos.size(); v++) {
+            field.add(pos[v], Kernel::mass(allocRadius), true, v);
+        }
+        field.attract(allocPerimeter, allocRamp, allocStrength);
+        for (int b = 0; b < field.size(); b++) {
+            force[field.body(b).node] += field.body(b).force;
+        }
+        
+        // repulse
+        for (size_t e = 0; e < links.size(); e++) {
+            Vec2s f = Kernel::tension(pos[links[e].first], pos[links[e].second], allocLength, allocStiffness, allocEdgeDamping);
+            force[links[e].first] -= f;
+            force[links[e].second] += f;
+        }
+        
+        // update
+        for (size_t v = 0; v < pos.size(); v++) {
+            Kernel::integrate(pos[v], mpos[v], velocity[v], force[v], allocTick, allocDamping, allocEasing, allocVelocity, allocThreshold);
+            force[v].set(0, 0);
+        }
+    }
+};
+
+
+/**
+ * The counter sees every form of new, a settled frame allocates nothing.
+ */
+int main() {
+    srand(11);
+    
+    // counter
+    long c = Alloc::count();
+    vector<int> *v = new vector<int>(8);
+    char *nt = new (std::nothrow) char[16];
+    CHECK(Alloc::count() - c == 3);
+    delete[] nt;
+    delete v;
+    
+    // graph, a node with 20 children of 5
+    Frame frame;
+    frame.pos.push_back(Vec2s(512, 512));
+    for (int c = 0; c < 20; c++) {
+        int child = frame.pos.size();
+        frame.pos.push_back(Vec2s(rand() % 1024, rand() % 1024));
+        frame.links.push_back(make_pair(0, child));
+        for (int g = 0; g < 5; g++) {
+            frame.links.push_back(make_pair(child, (int)frame.pos.size()));
+            frame.pos.push_back(Vec2s(rand() % 1024, rand() % 1024));
+        }
+    }
+    frame.mpos = frame.pos;
+    frame.velocity.assign(frame.pos.size(), Vec2s(0, 0));
+    frame.force.assign(frame.pos.size(), Vec2s(0, 0));
+    
+    // warm up, the buffers of the field grow to the graph
+    for (int f = 0; f < allocWarmup; f++) {
+        frame.step();
+    }
+    
+    // settled
+    c = Alloc::count();
+    for (int f = 0; f < allocFrames; f++) {
+        frame.step();
+    }
+    long allocations = Alloc::count() - c;
+    CHECK(allocations == 0);
+    printf("%d nodes, %d frames: %ld allocations\n", (int)frame.pos.size(), allocFrames, allocations);
+    
+    return testResult();
+}
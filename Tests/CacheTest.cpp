@@ -0,0 +1,159 @@
+//
+//  CacheTest.cpp
+//  Solyaris
+//
+//  Created by CNPP on 19.10.2026.
+//  Copyright 2026 Beat Raess. All rights reserved.
+//
+//  This file is part of Solyaris.
+//
+//  Solyaris is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  Solyaris is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with Solyaris.  If not, see www.gnu.org/licenses/.
+
+#include "Test.h"
+#include "Cache.h"
+#include "Fetch.h"
+#include "Server.h"
+#include <boost/bind.hpp>
+#include <unistd.h>
+
+
+// origin
+static int calls = 0;
+static bool origin(const string &request, string &body) {
+    char n[32];
+    snprintf(n, sizeof(n), "%d", ++calls);
+    body = "{\"request\":\"" + request + "\",\"n\":" + n + ",\"pad\":\"" + string(5000, 'x') + "\"}";
+    return true;
+}
+static bool remote(FetchHTTP *http, Server *server, const string &request, string &body) {
+    FetchResponse response;
+    if (! http->send(server->url(request), 5, response) || response.status != 200) {
+        return false;
+    }
+    body = response.body;
+    return true;
+}
+static string request(const char *path, int i) {
+    char r[64];
+    snprintf(r, sizeof(r), "%s/%d", path, i);
+    return r;
+}
+
+
+/**
+ * Response cache: hits, staleness against the stand-in server, compaction,
+ * restarts and a lost index.
+ */
+int main() {
+    Server server(0.05);
+    CHECK(server.start());
+    FetchHTTP http;
+    CacheFetch api = boost::bind(remote, &http, &server, _1, _2);
+    string dir = testScratch("cache");
+    string body;
+    const int n = 3000;
+
+    // fill
+    {
+        Cache c(dir);
+        CHECK(c.open());
+        CHECK(c.fetch("/movie/550", "movie", origin, body) == cacheFresh && calls == 1);
+        CHECK(c.fetch("/movie/550", "movie", origin, body) == cacheFresh && calls == 1);
+        for (int i = 0; i < n; i++) {
+            c.fetch(request("/person", i), "person", origin, body);
+        }
+        CHECK(c.size() == n + 1);
+
+        // stale is served and refreshed once in the background
+        c.ttl("search", -1);
+        CHECK(c.fetch("/search?q=a", "search", api, body) == cacheFresh);
+        CHECK(c.fetch("/search?q=a", "search", api, body) == cacheStale);
+        CHECK(c.fetch("/search?q=a", "search", api, body) == cacheStale);
+        c.drain();
+        CHECK(server.hits("/search?q=a") == 2);
+
+        // the same through the scheduler, which refreshes on its own workers
+        {
+            Fetch f(&http);
+            f.cache(&c);
+            f.start(2);
+            FetchRequest r;
+            r.url = server.url("/search?q=b");
+            r.endpoint = "search";
+            r.timeout = 5;
+            FetchResponse seed;
+            CHECK(http.send(r.url, 5, seed) && seed.status == 200);
+            CHECK(c.put(r.url, "search", seed.body));
+            string first = seed.body;
+            f.request(r, FetchCallback());
+            double deadline = testNow() + 5;
+            while ((c.get(r.url, body) == cacheMiss || body == first) && testNow() < deadline) {
+                usleep(1000);
+            }
+            CHECK(body != first && server.hits("/search?q=b") == 2);
+        }
+
+        // rewrites leave dead bytes, the worker compacts them
+        for (int r = 0; r < 3; r++) {
+            for (int i = 0; i < n; i++) {
+                origin(request("/person", i), body);
+                c.put(request("/person", i), "person", body);
+            }
+        }
+        c.drain();
+        CHECK(c.size() == n + 3);
+        c.invalidate("/movie/550");
+        c.compact();
+        CHECK(c.dead() == 0);
+        CHECK(c.get("/movie/550", body) == cacheMiss);
+
+        // bench
+        double t = testNow();
+        int hits = 0;
+        for (int i = 0; i < 20000; i++) {
+            hits += c.get(request("/person", i % n), body) == cacheFresh;
+        }
+        double dt = testNow() - t;
+        CHECK(hits == 20000);
+        printf("get: %.2f us per hit (%d entries, %d byte bodies)\n", dt / hits * 1e6, c.size(), (int)body.size());
+        t = testNow();
+        for (int i = 0; i < 5000; i++) {
+            c.put(request("/bench", i), "movie", body);
+        }
+        printf("put: %.2f us per entry\n", (testNow() - t) / 5000 * 1e6);
+    }
+
+    // restart
+    {
+        Cache c(dir);
+        CHECK(c.open());
+        CHECK(c.size() == n + 5002);
+        CHECK(c.get(request("/person", 42), body) == cacheFresh);
+        CHECK(body.find("/person/42") != string::npos);
+    }
+
+    // lost index, rebuilt from the pack
+    CHECK(unlink((dir + "/responses.idx").c_str()) == 0);
+    {
+        Cache c(dir);
+        CHECK(c.open());
+        CHECK(c.size() == n + 5002);
+        CHECK(c.get(request("/person", 7), body) == cacheFresh);
+        c.clear();
+        CHECK(c.size() == 0);
+    }
+
+    // done
+    return testResult();
+}
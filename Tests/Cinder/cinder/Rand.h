@@ -0,0 +1,72 @@
+//
+//  Rand.h
+//  Solyaris
+//
+//  Created by CNPP on 19.10.2026.
+//  Copyright 2026 Beat Raess. All rights reserved.
+//
+//  This file is part of Solyaris.
+//
+//  Solyaris is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  Solyaris is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with Solyaris.  If not, see www.gnu.org/licenses/.
+
+#pragma once
+#include <stdint.h>
+
+
+/**
+ * Random stand-in.
+ * Seeded xorshift in place of cinder's Rand, float and double runs of the
+ * layout draw the same sequence.
+ */
+namespace cinder {
+
+class Rand {
+
+    // public
+    public:
+
+    // Business
+    static void randSeed(uint32_t seed) {
+        Rand::state() = seed ? seed : 1;
+    }
+    static float randFloat() {
+        return (Rand::next() >> 8) * (1.0f / 16777216.0f);
+    }
+    static float randFloat(float a, float b) {
+        return a + (b - a) * Rand::randFloat();
+    }
+    static int randInt(int n) {
+        return (int)(Rand::next() % (uint32_t)n);
+    }
+
+
+    // private
+    private:
+
+    // State
+    static uint32_t& state() {
+        static uint32_t s = 1;
+        return s;
+    }
+    static uint32_t next() {
+        uint32_t &x = Rand::state();
+        x ^= x << 13;
+        x ^= x >> 17;
+        x ^= x << 5;
+        return x;
+    }
+
+};
+
+}
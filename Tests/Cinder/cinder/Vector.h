@@ -0,0 +1,87 @@
+//
+//  Vector.h
+//  Solyaris
+//
+//  Created by CNPP on 19.10.2026.
+//  Copyright 2026 Beat Raess. All rights reserved.
+//
+//  This file is part of Solyaris.
+//
+//  Solyaris is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  Solyaris is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with Solyaris.  If not, see www.gnu.org/licenses/.
+
+#pragma once
+#include <cmath>
+
+
+/**
+ * Vector stand-in.
+ * The part of cinder's Vec2 the layout core uses, so it builds on the
+ * desktop without cinder.
+ */
+namespace cinder {
+
+template <typename T>
+class Vec2 {
+
+    // public
+    public:
+
+    // Vec2
+    Vec2() : x(0), y(0) {}
+    Vec2(T nx, T ny) : x(nx), y(ny) {}
+    template <typename F>
+    Vec2(const Vec2<F> &v) : x((T)v.x), y((T)v.y) {}
+
+    // Operators
+    Vec2 operator+(const Vec2 &v) const { return Vec2(x + v.x, y + v.y); }
+    Vec2 operator-(const Vec2 &v) const { return Vec2(x - v.x, y - v.y); }
+    Vec2 operator*(T s) const { return Vec2(x * s, y * s); }
+    Vec2 operator/(T s) const { return Vec2(x / s, y / s); }
+    Vec2& operator+=(const Vec2 &v) { x += v.x; y += v.y; return *this; }
+    Vec2& operator-=(const Vec2 &v) { x -= v.x; y -= v.y; return *this; }
+    Vec2& operator*=(T s) { x *= s; y *= s; return *this; }
+    Vec2& operator/=(T s) { x /= s; y /= s; return *this; }
+
+    // Business
+    void set(T nx, T ny) { x = nx; y = ny; }
+    T length() const { return std::sqrt(x * x + y * y); }
+    T lengthSquared() const { return x * x + y * y; }
+    T distance(const Vec2 &v) const { return (*this - v).length(); }
+    void safeNormalize() {
+        T l = this->lengthSquared();
+        if (l > 0) {
+            l = std::sqrt(l);
+            x /= l;
+            y /= l;
+        }
+    }
+    void limit(T m) {
+        T l = this->lengthSquared();
+        if (l > m * m) {
+            T r = m / std::sqrt(l);
+            x *= r;
+            y *= r;
+        }
+    }
+
+    // Fields
+    T x;
+    T y;
+
+};
+typedef Vec2<float> Vec2f;
+typedef Vec2<double> Vec2d;
+
+}
+namespace ci = cinder;
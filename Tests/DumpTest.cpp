@@ -0,0 +1,178 @@
+//
+//  DumpTest.cpp
+//  Solyaris
+//
+//  Created by CNPP on 19.10.2026.
+//  Copyright 2026 Beat Raess. All rights reserved.
+//
+//  This file is part of Solyaris.
+//
+//  Solyaris is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  Solyaris is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with Solyaris.  If not, see www.gnu.org/licenses/.
+
+#include "Test.h"
+#include "Dump.h"
+#include <boost/thread.hpp>
+
+
+/**
+ * Imports the dumps with the given threads.
+ */
+static bool import(const string &dir, const string &out, int threads, DumpStats &stats) {
+    DumpImport im(threads);
+    bool ok = im.run(dir + "/movies.jsonl", dir + "/people.jsonl", dir + "/credits.jsonl", out);
+    if (! ok) {
+        fprintf(stderr, "import failed: %s\n", im.error().c_str());
+    }
+    stats = im.stats();
+    return ok;
+}
+
+/**
+ * Everything a dump answers, for comparing imports.
+ */
+static string contents(const Dump &d, int movies, int persons) {
+    string s;
+    vector<Credit> cs;
+    char b[64];
+    for (int id = 0; id < movies; id++) {
+        d.credits(creditMovie, id, cs);
+        for (size_t i = 0; i < cs.size(); i++) {
+            snprintf(b, sizeof(b), "|m%d:%d:%d:", id, cs[i].id, cs[i].order);
+            s += b + cs[i].name + cs[i].type + cs[i].character + cs[i].job;
+        }
+    }
+    for (int id = 0; id < persons; id++) {
+        d.credits(creditPerson, id, cs);
+        for (size_t i = 0; i < cs.size(); i++) {
+            snprintf(b, sizeof(b), "|p%d:%d:", id, cs[i].id);
+            s += b + cs[i].name + cs[i].year + cs[i].type;
+        }
+    }
+    vector<DumpResult> rs;
+    const char *prefixes[] = {"m", "movie 1", "p", "person 2", "person n\xc3\xa4m\xc3\xa9 3"};
+    for (size_t p = 0; p < sizeof(prefixes) / sizeof(prefixes[0]); p++) {
+        d.search(prefixes[p], 20, rs);
+        for (size_t i = 0; i < rs.size(); i++) {
+            s += "|s" + rs[i].type + rs[i].name + rs[i].meta;
+        }
+    }
+    return s;
+}
+
+/**
+ * Writes a synthetic dump, persons are shared across movies.
+ */
+static void synthesize(const string &dir, int movies, int persons, int credits) {
+    FILE *fm = fopen((dir + "/movies.jsonl").c_str(), "w");
+    FILE *fp = fopen((dir + "/people.jsonl").c_str(), "w");
+    FILE *fc = fopen((dir + "/credits.jsonl").c_str(), "w");
+    for (int m = 1; m <= movies; m++) {
+        fprintf(fm, "{\"id\":%d,\"title\":\"Movie %d\",\"release_date\":\"%d-01-01\",\"adult\":false}\n", m, m, 1950 + m % 70);
+    }
+    for (int p = 1; p <= persons; p++) {
+        fprintf(fp, "{\"id\":%d,\"name\":\"Person N\\u00e4m\\u00e9 %d\"}\n", p, p);
+    }
+    unsigned int seed = 7;
+    for (int m = 1; m <= movies; m++) {
+        fprintf(fc, "{\"id\":%d,\"cast\":[", m);
+        for (int k = 1; k < credits; k++) {
+            seed = seed * 1103515245 + 12345;
+            int p = 1 + (seed >> 8) % persons;
+            fprintf(fc, "%s{\"id\":%d,\"name\":\"Person N\\u00e4m\\u00e9 %d\",\"character\":\"Role %d\",\"order\":%d}", (k > 1) ? "," : "", p, p, k % 40, k);
+        }
+        seed = seed * 1103515245 + 12345;
+        int d = 1 + (seed >> 8) % persons;
+        fprintf(fc, "],\"crew\":[{\"id\":%d,\"name\":\"Person N\\u00e4m\\u00e9 %d\",\"department\":\"Directing\",\"job\":\"Director\"}]}\n", d, d);
+    }
+    fclose(fm);
+    fclose(fp);
+    fclose(fc);
+}
+
+
+/**
+ * Dump import and lookups: the recorded fixture dump, identical results
+ * for any number of threads and the import rate of a synthetic dump.
+ */
+int main() {
+    string scratch = testScratch("dump");
+    string fixtures = string(TEST_FIXTURES) + "/dump";
+    DumpStats stats;
+    vector<Credit> cs;
+    vector<DumpResult> rs;
+
+    // fixture
+    CHECK(import(fixtures, scratch + "/fixture.dump", 1, stats));
+    CHECK(stats.lines == 21 && stats.errors == 2);
+    Dump d;
+    CHECK(d.open(scratch + "/fixture.dump"));
+    CHECK(d.contains(creditMovie, 550) && ! d.contains(creditMovie, 99999901));
+    CHECK(d.contains(creditMovie, 2649) && d.name(creditMovie, 2649).empty());
+    CHECK(d.name(creditMovie, 1422) == "The Departed");
+    CHECK(d.meta(creditMovie, 550) == "1999" && d.meta(creditPerson, 7467) == creditDirector);
+    CHECK(! d.contains(creditPerson, 99999902));
+
+    // movie row in billing order, director first
+    CHECK(d.credits(creditMovie, 550, cs) == 4);
+    CHECK(cs[0].id == 7467 && cs[0].type == creditDirector && cs[0].job == "Director");
+    CHECK(cs[1].id == 819 && cs[1].character == "The Narrator");
+
+    // person row latest first, undated last
+    CHECK(d.credits(creditPerson, 287, cs) == 5);
+    CHECK(cs[0].id == 16869 && cs[0].year == "2009");
+    CHECK(cs[1].id == 1422 && cs[2].id == 550 && cs[3].id == 807 && cs[4].id == 76203);
+
+    // search ignores case, persons are typed by their highest credit
+    CHECK(d.search("FIGHT", 5, rs) == 1 && rs[0].id == 550 && rs[0].meta == "1999");
+    CHECK(d.search("david", 5, rs) == 1 && rs[0].type == creditPerson && rs[0].meta == creditDirector);
+    CHECK(d.search("brad", 5, rs) == 1 && rs[0].meta == creditActor);
+    CHECK(d.search("crew", 5, rs) == 1 && rs[0].meta == creditCrew);
+    CHECK(d.search("am\xc3\xa9", 5, rs) == 1 && rs[0].id == 603);
+    d.close();
+
+    // threads, the same file contents for any split
+    CHECK(import(fixtures, scratch + "/fixture3.dump", 3, stats));
+    Dump d3;
+    CHECK(d.open(scratch + "/fixture.dump") && d3.open(scratch + "/fixture3.dump"));
+    CHECK(contents(d, 100000, 10000) == contents(d3, 100000, 10000));
+    d.close();
+    d3.close();
+
+    // synthetic
+    synthesize(scratch, 10000, 30000, 50);
+    CHECK(import(scratch, scratch + "/one.dump", 1, stats));
+    printf("import, 1 thread: %d credits in %.2fs (parse %.2fs, merge %.2fs) %.2fM credits/s\n", (int)stats.credits, stats.seconds, stats.parsing, stats.merging, stats.credits / stats.seconds / 1e6);
+    int cores = max(2, (int)boost::thread::hardware_concurrency());
+    CHECK(import(scratch, scratch + "/all.dump", cores, stats));
+    printf("import, %d threads on %d cores: %d credits in %.2fs (parse %.2fs, merge %.2fs) %.2fM credits/s\n", cores, (int)boost::thread::hardware_concurrency(), (int)stats.credits, stats.seconds, stats.parsing, stats.merging, stats.credits / stats.seconds / 1e6);
+    CHECK(stats.credits > 490000);
+    CHECK(d.open(scratch + "/one.dump") && d3.open(scratch + "/all.dump"));
+    CHECK(contents(d, 10001, 30001) == contents(d3, 10001, 30001));
+
+    // lookups
+    double t = testNow();
+    int n = 0;
+    for (int i = 0; i < 10000; i++) {
+        n += d.credits(creditMovie, 1 + i, cs);
+    }
+    printf("movie row: %.2f us (%d credits)\n", (testNow() - t) / 10000 * 1e6, n / 10000);
+    t = testNow();
+    for (int i = 0; i < 10000; i++) {
+        d.search("person n\xc3\xa4m\xc3\xa9 12", 10, rs);
+    }
+    printf("search: %.2f us\n", (testNow() - t) / 10000 * 1e6);
+
+    // done
+    return testResult();
+}
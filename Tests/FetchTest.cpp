@@ -0,0 +1,158 @@
+//
+//  FetchTest.cpp
+//  Solyaris
+//
+//  Created by CNPP on 19.10.2026.
+//  Copyright 2026 Beat Raess. All rights reserved.
+//
+//  This file is part of Solyaris.
+//
+//  Solyaris is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  Solyaris is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with Solyaris.  If not, see www.gnu.org/licenses/.
+
+#include "Test.h"
+#include "Server.h"
+#include "Fetch.h"
+
+
+// results
+static boost::mutex rmutex;
+static boost::condition_variable rsignal;
+static vector<FetchResult> results;
+static vector< vector<FetchResult> > groups;
+static void collect(const FetchResult &r) {
+    boost::mutex::scoped_lock lock(rmutex);
+    results.push_back(r);
+    rsignal.notify_all();
+}
+static void gather(const vector<FetchResult> &rs) {
+    boost::mutex::scoped_lock lock(rmutex);
+    groups.push_back(rs);
+    rsignal.notify_all();
+}
+static void await(size_t n, size_t g = 0) {
+    boost::mutex::scoped_lock lock(rmutex);
+    while (results.size() < n || groups.size() < g) {
+        rsignal.wait(lock);
+    }
+}
+static FetchRequest request(Server &s, const string &path) {
+    FetchRequest r;
+    r.url = s.url(path);
+    r.endpoint = "movie";
+    r.timeout = 5;
+    return r;
+}
+
+
+/**
+ * Fetch scheduler against the stand-in server with 200ms latency:
+ * coalescing, groups, retries, not found, the cache and the rate limit.
+ */
+int main() {
+    Server server(0.2);
+    CHECK(server.start());
+    Cache cache(testScratch("fetch"));
+    CHECK(cache.open());
+    FetchHTTP http;
+    Fetch f(&http);
+    f.rate(20, 4);
+    f.cache(&cache);
+    f.start(4);
+
+    // ten requests for one url make one call
+    double t = testNow();
+    for (int i = 0; i < 10; i++) {
+        f.request(request(server, "/movie/550"), collect);
+    }
+    await(10);
+    double coalesced = testNow() - t;
+    CHECK(server.hits("/movie/550") == 1);
+    for (size_t i = 0; i < results.size(); i++) {
+        CHECK(results[i].status == fetchOk && results[i].body == results[0].body);
+    }
+    CHECK(results[0].body.find("Fight Club") != string::npos);
+    printf("coalesced: 10 requests, 1 call, %.2fs\n", coalesced);
+
+    // group in one round trip, results in order
+    vector<FetchRequest> g;
+    g.push_back(request(server, "/movie/1"));
+    g.push_back(request(server, "/movie/1/casts"));
+    g.push_back(request(server, "/movie/1/images"));
+    g.push_back(request(server, "/movie/1/trailers"));
+    t = testNow();
+    f.group(g, gather);
+    await(10, 1);
+    double grouped = testNow() - t;
+    CHECK(groups[0].size() == 4 && groups[0][1].url == g[1].url);
+    CHECK(grouped < 0.4);
+    printf("group: 4 requests in %.2fs\n", grouped);
+
+    // 429 twice, then retried to success
+    t = testNow();
+    f.request(request(server, "/flaky"), collect);
+    await(11);
+    CHECK(results[10].status == fetchOk && results[10].attempts == 3);
+    CHECK(server.hits("/flaky") == 3);
+    printf("flaky: %d attempts in %.2fs\n", results[10].attempts, testNow() - t);
+
+    // not found is not retried
+    f.request(request(server, "/missing"), collect);
+    await(12);
+    CHECK(results[11].status == fetchNotFound && results[11].code == 404);
+    CHECK(server.hits("/missing") == 1);
+
+    // cached, answered without a call
+    f.request(request(server, "/movie/550"), collect);
+    await(13);
+    CHECK(results[12].cached && server.hits("/movie/550") == 1);
+
+    // rate limit, 12 distinct urls at 20/s with a burst of 4
+    int before = server.requests();
+    t = testNow();
+    for (int i = 0; i < 12; i++) {
+        char path[32];
+        snprintf(path, sizeof(path), "/r/%d", i);
+        f.request(request(server, path), collect);
+    }
+    await(25);
+    double paced = testNow() - t;
+    CHECK(server.requests() - before == 12);
+    CHECK(paced >= (12 - 4) / 20.0);
+    printf("paced: 12 requests at 20/s burst 4 in %.2fs\n", paced);
+
+    // cancelled requests report back
+    for (int i = 0; i < 6; i++) {
+        char path[32];
+        snprintf(path, sizeof(path), "/c/%d", i);
+        f.request(request(server, path), collect);
+    }
+    f.cancel();
+    await(31);
+    int cancelled = 0;
+    for (size_t i = 25; i < results.size(); i++) {
+        cancelled += results[i].status == fetchCancelled;
+    }
+    CHECK(cancelled > 0);
+
+    // stats
+    FetchStats s = f.stats();
+    printf("stats: requests %d coalesced %d cached %d sent %d retries %d throttled %d failed %d\n", (int)s.requests, (int)s.coalesced, (int)s.cached, (int)s.sent, (int)s.retries, (int)s.throttled, (int)s.failed);
+    CHECK(s.coalesced == 9 && s.retries == 2);
+
+    // done
+    f.stop();
+    cache.close();
+    server.stop();
+    return testResult();
+}
@@ -0,0 +1,306 @@
+//
+//  FieldTest.cpp
+//  Solyaris
+//
+//  Created by CNPP on 19.10.2026.
+//  Copyright 2026 Beat Raess. All rights reserved.
+//
+//  This file is part of Solyaris.
+//
+//  Solyaris is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  Solyaris is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with Solyaris.  If not, see www.gnu.org/licenses/.
+
+#include "Test.h"
+#include "Field.h"
+#include <vector>
+#include <algorithm>
+
+
+// parameters of Params::build, dpr 1
+const double fieldPerimeter = 432;
+const double fieldRamp = 1.2;
+const double fieldStrength = -3600;
+const double fieldMass = 60 * 60 * 0.0001 + 0.01;
+
+// heap footprint of a node and the cache lines attract reads of it
+const int fieldNodeStride = 768;
+const int fieldNodeLines = 2;
+
+
+/**
+ * Cache model.
+ * Set associative with LRU replacement, counts the misses of an address
+ * trace. There are no hardware counters here, so the access patterns of
+ * the layouts are replayed through it instead.
+ */
+class Cache {
+
+    // public
+    public:
+
+    // Cache
+    Cache(int size, int ways, int line) : ways(ways), line(line), sets(size / (ways * line)), tags(sets * ways, -1), misses(0), accesses(0) {
+    }
+
+    // Business
+    void touch(long address) {
+        long tag = address / line;
+        long *set = &tags[(tag % sets) * ways];
+        accesses++;
+        int w = 0;
+        while (w < ways && set[w] != tag) {
+            w++;
+        }
+        if (w == ways) {
+            misses++;
+            w = ways - 1;
+        }
+        for (; w > 0; w--) {
+            set[w] = set[w-1];
+        }
+        set[0] = tag;
+    }
+
+    // Fields
+    int ways;
+    int line;
+    int sets;
+    vector<long> tags;
+    long misses;
+    long accesses;
+
+};
+
+// node object of the pointer layout
+static void node(Cache &cache, const vector<long> &heap, int n) {
+    for (int l = 0; l < fieldNodeLines; l++) {
+        cache.touch(heap[n] + l * 64);
+    }
+}
+
+/**
+ * Graph::attract before the field: every ordered pair of a vector of node
+ * pointers, the nodes stay where the heap put them.
+ */
+static void pointers(Cache &cache, const vector<long> &heap, const vector<int> &order) {
+    int n = order.size();
+    for (int a = 0; a < n; a++) {
+        for (int b = 0; b < n; b++) {
+            cache.touch(a * 16);
+            node(cache, heap, order[a]);
+            cache.touch(b * 16);
+            node(cache, heap, order[b]);
+        }
+    }
+}
+
+/**
+ * Graph::attract on the field: gather, pairs of neighbouring cells over
+ * the contiguous pool, forces back.
+ */
+static void pooled(Cache &cache, const vector<long> &heap, Field &field) {
+    long pool = 1L << 32;
+    long body = sizeof(Field::Body);
+    int n = field.size();
+
+    // gather
+    for (int b = 0; b < n; b++) {
+        cache.touch(b * 16);
+        node(cache, heap, b);
+        cache.touch(pool + b * body);
+    }
+
+    // pairs
+    static const int ahead[5][2] = { {0,0}, {1,0}, {-1,1}, {0,1}, {1,1} };
+    for (int cy = 0; cy < field.rows(); cy++) {
+        for (int cx = 0; cx < field.columns(); cx++) {
+            int begin, end;
+            field.run(cx, cy, begin, end);
+            for (int a = 0; a < 5; a++) {
+                int nx = cx + ahead[a][0];
+                int ny = cy + ahead[a][1];
+                if (nx < 0 || nx >= field.columns() || ny >= field.rows()) {
+                    continue;
+                }
+                int obegin, oend;
+                field.run(nx, ny, obegin, oend);
+                for (int i = begin; i < end; i++) {
+                    for (int j = (a == 0) ? i+1 : obegin; j < oend; j++) {
+                        cache.touch(pool + i * body);
+                        cache.touch(pool + j * body);
+                    }
+                }
+            }
+        }
+    }
+
+    // forces
+    for (int b = 0; b < n; b++) {
+        cache.touch(pool + b * body);
+        node(cache, heap, field.body(b).node);
+    }
+}
+
+// graph of n nodes spread like an expanded layout, a few within range
+static void graph(int n, vector<Vec2f> &pos) {
+    float side = sqrt((float)n) * 360;
+    pos.clear();
+    for (int v = 0; v < n; v++) {
+        pos.push_back(Vec2f(rand() % (int)side, rand() % (int)side));
+    }
+}
+
+
+/**
+ * Field attraction against the all pairs loop: same forces, fewer pairs and
+ * far fewer cache misses on the contiguous pool.
+ */
+int main() {
+    srand(11);
+
+    // forces
+    vector<Vec2f> pos;
+    graph(400, pos);
+    Field field;
+    for (int v = 0; v < (int)pos.size(); v++) {
+        field.add(pos[v], fieldMass * (v % 7 == 0 ? 2 : 1), v % 5 != 0, v);
+    }
+    field.attract(fieldPerimeter, fieldRamp, fieldStrength);
+    CHECK(field.size() == (int)pos.size());
+    vector<Vec2d> reference(pos.size(), Vec2d(0, 0));
+    for (int a = 0; a < (int)pos.size(); a++) {
+        for (int b = 0; b < (int)pos.size(); b++) {
+            double d = Vec2d(pos[a]).distance(Vec2d(pos[b]));
+            if (a != b && b % 5 != 0 && d > 0 && d < fieldPerimeter) {
+                double f = Layout<double>::attraction(d, fieldPerimeter, fieldRamp, fieldStrength);
+                reference[b] += (Vec2d(pos[a]) - Vec2d(pos[b])) * (f / (fieldMass * (a % 7 == 0 ? 2 : 1)));
+            }
+        }
+    }
+    double deviation = 0;
+    double magnitude = 0;
+    for (int b = 0; b < field.size(); b++) {
+        const Field::Body &body = field.body(b);
+        CHECK(body.receives == (body.node % 5 != 0));
+        deviation = max(deviation, Vec2d(body.force).distance(reference[body.node]));
+        magnitude = max(magnitude, reference[body.node].length());
+    }
+    CHECK(deviation < magnitude * 0.001);
+    printf("forces: %d bodies, max deviation %.4f of %.1f\n", field.size(), deviation, magnitude);
+
+    // radius hits from the grid, the same nodes as a scan
+    vector<int> hits;
+    for (int v = 0; v < (int)pos.size(); v += 37) {
+        hits.clear();
+        field.within(pos[v], 600, hits);
+        sort(hits.begin(), hits.end());
+        vector<int> scan;
+        for (int w = 0; w < (int)pos.size(); w++) {
+            if ((pos[w] - pos[v]).lengthSquared() < 600 * 600) {
+                scan.push_back(w);
+            }
+        }
+        CHECK(hits == scan);
+    }
+
+    // weight, a cluster of three pushes like its members
+    Field single;
+    single.add(Vec2f(0, 0), fieldMass, false, 0, 3);
+    single.add(Vec2f(200, 0), fieldMass, true, 1);
+    single.attract(fieldPerimeter, fieldRamp, fieldStrength);
+    Field triple;
+    for (int m = 0; m < 3; m++) {
+        triple.add(Vec2f(0, 0), fieldMass, false, m);
+    }
+    triple.add(Vec2f(200, 0), fieldMass, true, 3);
+    triple.attract(fieldPerimeter, fieldRamp, fieldStrength);
+    Vec2f fs, ft;
+    for (int b = 0; b < single.size(); b++) {
+        if (single.body(b).receives) {
+            fs = single.body(b).force;
+        }
+    }
+    for (int b = 0; b < triple.size(); b++) {
+        if (triple.body(b).receives) {
+            ft = triple.body(b).force;
+        }
+    }
+    CHECK(fs.length() > 0 && fs.distance(ft) < fs.length() * 0.0001);
+
+    // cache behaviour and time
+    int sizes[] = { 250, 1000, 2000 };
+    for (int s = 0; s < 3; s++) {
+        int n = sizes[s];
+        graph(n, pos);
+
+        // heap, allocated in no particular order
+        vector<int> slots(n);
+        for (int v = 0; v < n; v++) {
+            slots[v] = v;
+        }
+        random_shuffle(slots.begin(), slots.end());
+        vector<long> heap(n);
+        for (int v = 0; v < n; v++) {
+            heap[v] = (1L << 28) + slots[v] * (long)fieldNodeStride;
+        }
+
+        // pointers, in insertion order and sorted like the nodes on the heap
+        vector<int> inserted(n);
+        for (int v = 0; v < n; v++) {
+            inserted[v] = v;
+        }
+        vector< pair<int,int> > sorted;
+        for (int v = 0; v < n; v++) {
+            sorted.push_back(make_pair((int)(pos[v].y / fieldPerimeter) * 4096 + (int)(pos[v].x / fieldPerimeter), v));
+        }
+        sort(sorted.begin(), sorted.end());
+        vector<int> reordered(n);
+        for (int v = 0; v < n; v++) {
+            reordered[v] = sorted[v].second;
+        }
+        Cache plain(32 * 1024, 4, 64);
+        pointers(plain, heap, inserted);
+        Cache zorder(32 * 1024, 4, 64);
+        pointers(zorder, heap, reordered);
+
+        // pool
+        field.clear();
+        for (int v = 0; v < n; v++) {
+            field.add(pos[v], fieldMass, true, v);
+        }
+        double t = testNow();
+        field.attract(fieldPerimeter, fieldRamp, fieldStrength);
+        double tp = testNow() - t;
+        Cache pool(32 * 1024, 4, 64);
+        pooled(pool, heap, field);
+
+        // all pairs
+        vector<Vec2f> force(n, Vec2f(0, 0));
+        t = testNow();
+        for (int a = 0; a < n; a++) {
+            for (int b = 0; b < n; b++) {
+                float d = pos[a].distance(pos[b]);
+                if (a != b && d > 0 && d < fieldPerimeter) {
+                    float f = Layout<float>::attraction(d, fieldPerimeter, fieldRamp, fieldStrength);
+                    force[b] += (pos[a] - pos[b]) * (f / (float)fieldMass);
+                }
+            }
+        }
+        double ta = testNow() - t;
+
+        CHECK(pool.misses * 10 < plain.misses);
+        printf("%d nodes: L1 misses all pairs %ld, sorted pointers %ld, pool %ld (%ld accesses); all pairs %.2fms, pool %.2fms\n", n, plain.misses, zorder.misses, pool.misses, pool.accesses, ta * 1000, tp * 1000);
+    }
+
+    return testResult();
+}
@@ -0,0 +1,122 @@
+//
+//  IndexTest.cpp
+//  Solyaris
+//
+//  Created by CNPP on 19.10.2026.
+//  Copyright 2026 Beat Raess. All rights reserved.
+//
+//  This file is part of Solyaris.
+//
+//  Solyaris is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  Solyaris is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with Solyaris.  If not, see www.gnu.org/licenses/.
+
+#include "Test.h"
+#include "Index.h"
+
+
+/**
+ * Ingests a recorded response.
+ */
+static vector<Credit> credits(const string &type, const string &fixture) {
+    string d = testFixture(fixture);
+    CreditsIngest in(type);
+    CHECK(in.feed(d.data(), d.size()) && in.finish());
+    return in.credits();
+}
+
+
+/**
+ * Credits index: rows of the recorded responses, deltas merged with the
+ * sparse rows, in place updates and expansion time at 180k credits.
+ */
+int main() {
+    Index ix;
+    vector<Credit> out;
+
+    // recorded
+    vector<Credit> movie = credits(creditMovie, "movie_550.json");
+    vector<Credit> person = credits(creditPerson, "person_287.json");
+    ix.append(creditMovie, 550, movie);
+    ix.append(creditPerson, 287, person);
+    CHECK(ix.contains(creditMovie, 550) && ix.contains(creditPerson, 287));
+    CHECK(ix.contains(creditPerson, 819) && ix.contains(creditMovie, 807));
+    CHECK(ix.name(creditPerson, 819) == "Edward Norton");
+
+    // movie row in billing order, director first
+    CHECK(ix.credits(creditMovie, 550, out) == (int)movie.size());
+    CHECK(out[0].id == 7467 && out[0].type == creditDirector);
+    for (size_t i = 1; i < out.size(); i++) {
+        CHECK(out[i - 1].order <= out[i].order);
+    }
+
+    // person row latest first, fight club seen from both sides once
+    CHECK(ix.credits(creditPerson, 287, out) == (int)person.size());
+    for (size_t i = 1; i < out.size(); i++) {
+        CHECK(out[i - 1].year >= out[i].year);
+    }
+    int fightclub = 0;
+    for (size_t i = 0; i < out.size(); i++) {
+        fightclub += out[i].id == 550;
+    }
+    CHECK(fightclub == 1);
+
+    // reloading updates in place
+    size_t records = ix.size();
+    ix.append(creditMovie, 550, movie);
+    CHECK(ix.size() == records);
+
+    // synthetic, 3000 movies of 60 credits over 20000 persons
+    unsigned int seed = 1;
+    for (int m = 1; m <= 3000; m++) {
+        vector<Credit> cs;
+        for (int k = 0; k < 60; k++) {
+            seed = seed * 1103515245 + 12345;
+            Credit c = Credit();
+            c.id = 100000 + (seed >> 8) % 20000;
+            c.name = "Person";
+            c.type = k ? creditActor : creditDirector;
+            c.character = "Role";
+            c.order = k;
+            cs.push_back(c);
+        }
+        ix.append(creditMovie, 1000000 + m, cs);
+    }
+    printf("index: %d records, %d bytes\n", (int)ix.size(), (int)ix.bytes());
+    CHECK(ix.size() >= 170000);
+
+    // recorded rows survive the compactions
+    CHECK(ix.credits(creditMovie, 550, out) == (int)movie.size());
+
+    // bench, one expansion is a row read with names resolved
+    double t = testNow();
+    int n = 0;
+    for (int i = 0; i < 3000; i++) {
+        n += ix.credits(creditMovie, 1000001 + i, out);
+    }
+    printf("movie expand: %.2f us (%d credits)\n", (testNow() - t) / 3000 * 1e6, n / 3000);
+    t = testNow();
+    n = 0;
+    for (int i = 0; i < 3000; i++) {
+        n += ix.credits(creditPerson, 100000 + i, out);
+    }
+    printf("person expand: %.2f us (%d credits)\n", (testNow() - t) / 3000 * 1e6, n / 3000);
+
+    // batch straight from the index
+    MutationBatch b;
+    ix.credits(creditMovie, 550, out);
+    CreditsIngest::batch(creditMovie, 550, out, true, b);
+    CHECK(b.nid == "movie_550" && b.mutations.size() == out.size());
+
+    // done
+    return testResult();
+}
@@ -0,0 +1,155 @@
+//
+//  JsonTest.cpp
+//  Solyaris
+//
+//  Created by CNPP on 19.10.2026.
+//  Copyright 2026 Beat Raess. All rights reserved.
+//
+//  This file is part of Solyaris.
+//
+//  Solyaris is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  Solyaris is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with Solyaris.  If not, see www.gnu.org/licenses/.
+
+#include "Test.h"
+#include "Json.h"
+#include "Credits.h"
+#include <cstring>
+
+
+/**
+ * Counts the events of a document.
+ */
+class Counter : public JsonHandler {
+public:
+    Counter() : objects(0), arrays(0), keys(0), texts(0), numbers(0), literals(0) {}
+    void objectStart() { objects++; }
+    void arrayStart() { arrays++; }
+    void key(const string &) { keys++; }
+    void text(const string &s) { last = s; texts++; }
+    void number(double) { numbers++; }
+    void boolean(bool) { literals++; }
+    void null() { literals++; }
+    int objects, arrays, keys, texts, numbers, literals;
+    string last;
+};
+
+/**
+ * Feeds a document in chunks of the given size.
+ */
+static bool ingest(CreditsIngest &in, const string &d, size_t chunk) {
+    for (size_t i = 0; i < d.size(); i += chunk) {
+        if (! in.feed(d.data() + i, min(chunk, d.size() - i))) {
+            return false;
+        }
+    }
+    return in.finish();
+}
+
+
+/**
+ * Parser and credits ingest against recorded TMDb responses.
+ */
+int main() {
+
+    // events
+    {
+        const char *d = "{\"a\":[1,-2.5e1,true,false,null,\"x\\u00e9\\ud83d\\ude00\\n\"],\"b\":{}}";
+        Counter c;
+        Json j(&c);
+        CHECK(j.feed(d, strlen(d)) && j.finish());
+        CHECK(c.objects == 2 && c.arrays == 1 && c.keys == 2);
+        CHECK(c.numbers == 2 && c.literals == 3 && c.texts == 1);
+        CHECK(c.last == "x\xc3\xa9\xf0\x9f\x98\x80\n");
+    }
+
+    // malformed
+    const char *bad[] = {"{\"a\":}", "[1,]", "{\"a\" 1}", "[tru]", "\"abc", "[1] x", "-", "{\"cast\":[{\"id\":1,"};
+    for (size_t i = 0; i < sizeof(bad) / sizeof(bad[0]); i++) {
+        JsonHandler h;
+        Json j(&h);
+        bool ok = j.feed(bad[i], strlen(bad[i])) && j.finish();
+        CHECK(! ok && j.failed() && ! j.error().empty());
+    }
+
+    // movie, any chunking yields the same credits
+    string movie = testFixture("movie_550.json");
+    CHECK(! movie.empty());
+    size_t chunks[] = {1, 7, 64, 4096, movie.size()};
+    MutationBatch reference;
+    for (size_t i = 0; i < sizeof(chunks) / sizeof(chunks[0]); i++) {
+        CreditsIngest in(creditMovie);
+        CHECK(ingest(in, movie, chunks[i]));
+        MutationBatch b;
+        in.batch(b, true);
+        if (i == 0) {
+            reference = b;
+        }
+        CHECK(b.mutations.size() == reference.mutations.size());
+        for (size_t m = 0; m < b.mutations.size() && m < reference.mutations.size(); m++) {
+            CHECK(b.mutations[m].cid == reference.mutations[m].cid);
+            CHECK(b.mutations[m].elabel == reference.mutations[m].elabel);
+        }
+    }
+    {
+        CreditsIngest in(creditMovie);
+        CHECK(ingest(in, movie, 13));
+        CHECK(in.source() == 550);
+        const vector<Credit> &cs = in.credits();
+
+        // director first then actors by order, shore merges two jobs
+        int actors = 0, directors = 0, shore = 0;
+        for (size_t i = 0; i < cs.size(); i++) {
+            actors += cs[i].type == creditActor;
+            directors += cs[i].type == creditDirector;
+            shore += cs[i].id == 1076;
+        }
+        CHECK(cs.size() > 1 && cs[0].id == 7467 && cs[0].type == creditDirector);
+        CHECK(cs.size() > 1 && cs[1].id == 819 && cs[1].character == "The Narrator");
+        CHECK(actors >= 8);
+        CHECK(directors == 1);
+        CHECK(shore == 1);
+        for (size_t i = 1; i < cs.size(); i++) {
+            CHECK(cs[i - 1].order <= cs[i].order);
+        }
+
+        MutationBatch b;
+        in.batch(b, false);
+        CHECK(b.nid == "movie_550");
+        CHECK(! b.mutations.empty() && b.mutations[0].cid == "person_7467");
+        printf("movie 550: %d credits, %d mutations\n", (int)cs.size(), (int)b.mutations.size());
+    }
+
+    // person, nested in movie_credits
+    {
+        string person = testFixture("person_287.json");
+        CreditsIngest in(creditPerson);
+        CHECK(ingest(in, person, 5));
+        CHECK(in.source() == 287);
+        const vector<Credit> &cs = in.credits();
+        bool departed = false, adult = false;
+        for (size_t i = 0; i < cs.size(); i++) {
+            departed = departed || (cs[i].id == 1422 && cs[i].year == "2006");
+            adult = adult || cs[i].id == 99999901;
+        }
+        CHECK(departed);
+        CHECK(! adult);
+        MutationBatch b;
+        in.batch(b, true);
+        CHECK(b.nid == "person_287");
+        CHECK(! b.mutations.empty() && b.mutations[0].cid.compare(0, 6, "movie_") == 0);
+        printf("person 287: %d credits, %d mutations\n", (int)cs.size(), (int)b.mutations.size());
+    }
+
+    // done
+    return testResult();
+}
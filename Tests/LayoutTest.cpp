@@ -0,0 +1,217 @@
+//
+//  LayoutTest.cpp
+//  Solyaris
+//
+//  Created by CNPP on 19.10.2026.
+//  Copyright 2026 Beat Raess. All rights reserved.
+//
+//  This file is part of Solyaris.
+//
+//  Solyaris is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  Solyaris is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with Solyaris.  If not, see www.gnu.org/licenses/.
+
+#include "Test.h"
+#include "Multilevel.h"
+#include "Field.h"
+#include <vector>
+
+
+// parameters of Params::build, dpr 1
+const double layoutPerimeter = 432;
+const double layoutRamp = 1.2;
+const double layoutStrength = -3600;
+const double layoutDamping = 41.59;
+const double layoutVelocity = 900;
+const double layoutThreshold = 6;
+const double layoutEasing = 2.034;
+const double layoutLength = 480;
+const double layoutStiffness = 2160;
+const double layoutEdgeDamping = 0.9;
+const double layoutRadius = 60;
+const double layoutTick = 1.0 / 60.0;
+
+
+/**
+ * A graph in scalar type T, stepped the way Graph::step does it: the field
+ * attraction with its range cutoff and cluster weights, the edge tension
+ * of Edge::repulse, the temperature and the integration of Node::update.
+ */
+template <typename T>
+struct Physics {
+    FieldT<T> field;
+    vector< Vec2<T> > pos;
+    vector< Vec2<T> > mpos;
+    vector< Vec2<T> > velocity;
+    vector< Vec2<T> > force;
+    vector<T> mass;
+
+    void run(const vector<Vec2d> &start, const vector<double> &masses, const vector< pair<int,int> > &links, int ticks) {
+        int n = start.size();
+        pos.assign(start.begin(), start.end());
+        mpos = pos;
+        velocity.assign(n, Vec2<T>(0, 0));
+        force.assign(n, Vec2<T>(0, 0));
+        mass.assign(masses.begin(), masses.end());
+        T dt = layoutTick;
+        T temperature = 1;
+        for (int t = 0; t < ticks; t++) {
+
+            // attract
+            field.clear();
+            for (int v = 0; v < n; v++) {
+                T w = Layout<T>::weight(mass[v], layoutRadius);
+                field.add(pos[v], mass[v] / w, true, v, w);
+            }
+            field.attract(layoutPerimeter, layoutRamp, layoutStrength);
+            for (int b = 0; b < field.size(); b++) {
+                const typename FieldT<T>::Body &body = field.body(b);
+                force[body.node] += body.force / body.weight;
+            }
+
+            // repulse
+            for (size_t e = 0; e < links.size(); e++) {
+                Vec2<T> f = Layout<T>::tension(pos[links[e].first], pos[links[e].second], layoutLength, layoutStiffness, layoutEdgeDamping);
+                force[links[e].first] -= f;
+                force[links[e].second] += f;
+            }
+
+            // update
+            for (int v = 0; v < n; v++) {
+                force[v] *= temperature;
+                Layout<T>::integrate(pos[v], mpos[v], velocity[v], force[v], dt, layoutDamping, layoutEasing, layoutVelocity, layoutThreshold);
+                force[v].set(0, 0);
+            }
+            temperature = max((T)0.1, temperature * (T)0.995);
+        }
+    }
+};
+
+// graphs
+static void tree(int children, int grandchildren, vector<Vec2d> &nodes, vector< pair<int,int> > &links) {
+    nodes.push_back(Vec2d(512, 512));
+    for (int c = 0; c < children; c++) {
+        int child = nodes.size();
+        nodes.push_back(Vec2d(rand() % 1024, rand() % 1024));
+        links.push_back(make_pair(0, child));
+        for (int g = 0; g < grandchildren; g++) {
+            links.push_back(make_pair(child, (int)nodes.size()));
+            nodes.push_back(Vec2d(rand() % 1024, rand() % 1024));
+        }
+    }
+}
+static void random(int n, vector<Vec2d> &nodes, vector< pair<int,int> > &links) {
+    for (int v = 0; v < n; v++) {
+        nodes.push_back(Vec2d(rand() % 2048, rand() % 2048));
+        if (v > 0) {
+            links.push_back(make_pair(rand() % v, v));
+        }
+    }
+    for (int e = 0; e < n / 4; e++) {
+        int a = rand() % n;
+        int b = rand() % n;
+        if (a != b) {
+            links.push_back(make_pair(a, b));
+        }
+    }
+}
+
+// measures
+template <typename A, typename B>
+static double deviation(const vector< Vec2<A> > &a, const vector< Vec2<B> > &b) {
+    double d = 0;
+    for (size_t v = 0; v < a.size(); v++) {
+        d = max(d, Vec2d(a[v]).distance(Vec2d(b[v])));
+    }
+    return d;
+}
+template <typename T>
+static double spread(const vector< Vec2<T> > &p, const vector< pair<int,int> > &links, double &sd) {
+    double s = 0;
+    double s2 = 0;
+    for (size_t e = 0; e < links.size(); e++) {
+        double l = Vec2d(p[links[e].first]).distance(Vec2d(p[links[e].second]));
+        s += l;
+        s2 += l * l;
+    }
+    double mean = s / links.size();
+    sd = sqrt(s2 / links.size() - mean * mean);
+    return mean;
+}
+
+
+/**
+ * Float layout against the double reference: the physics stays within a
+ * pixel of it, the multilevel layout is chaotic so its shape is compared.
+ */
+int main() {
+    srand(7);
+
+    // kernels
+    double kernel = 0;
+    for (int i = 0; i < 10000; i++) {
+        Vec2d a(rand() % 2048, rand() % 2048);
+        Vec2d b(rand() % 2048, rand() % 2048);
+        kernel = max(kernel, Vec2d(Layout<float>::spring(Vec2f(a), Vec2f(b), layoutLength)).distance(Layout<double>::spring(a, b, layoutLength)));
+        kernel = max(kernel, Vec2d(Layout<float>::repulsion(Vec2f(a - b), 480 * 480, 1)).distance(Layout<double>::repulsion(a - b, 480 * 480, 1)));
+    }
+    CHECK(kernel < 0.01);
+    printf("kernels: max deviation %.5f px\n", kernel);
+
+    // physics, 16 seconds of a loaded node with 20 children of 5, one of
+    // them a cluster of 6
+    vector<Vec2d> nodes;
+    vector< pair<int,int> > links;
+    tree(20, 5, nodes, links);
+    vector<double> masses(nodes.size(), Layout<double>::mass(layoutRadius));
+    masses[1] *= 6;
+    Physics<float> pf;
+    Physics<double> pd;
+    double t = testNow();
+    pf.run(nodes, masses, links, 960);
+    double tf = testNow() - t;
+    t = testNow();
+    pd.run(nodes, masses, links, 960);
+    double td = testNow() - t;
+    double physics = deviation(pf.pos, pd.pos);
+    double moved = deviation(pd.pos, nodes);
+    CHECK(physics < 0.5);
+    CHECK(moved > 100);
+    printf("physics: %d nodes 960 ticks, max deviation %.4f px of %.0f px moved; float %.2fms double %.2fms per tick\n", (int)nodes.size(), physics, moved, tf * 1000 / 960, td * 1000 / 960);
+
+    // multilevel, 600 nodes
+    nodes.clear();
+    links.clear();
+    random(600, nodes, links);
+    vector<Vec2f> mf(nodes.begin(), nodes.end());
+    vector<Vec2d> md = nodes;
+    vector<Vec2d> mp = nodes;
+    mp[0].x += 0.000001;
+    Rand::randSeed(42);
+    t = testNow();
+    MultilevelT<float>().layout(mf, links, layoutLength);
+    tf = testNow() - t;
+    Rand::randSeed(42);
+    t = testNow();
+    MultilevelT<double>().layout(md, links, layoutLength);
+    td = testNow() - t;
+    Rand::randSeed(42);
+    MultilevelT<double>().layout(mp, links, layoutLength);
+    double sdf, sdd;
+    double lf = spread(mf, links, sdf);
+    double ld = spread(md, links, sdd);
+    CHECK(fabs(lf - ld) < ld * 0.01);
+    CHECK(fabs(sdf - sdd) < sdd * 0.05);
+    printf("multilevel: edge length float %.1f ± %.1f, double %.1f ± %.1f px; a 1e-6 px nudge moves the double layout %.0f px; float %.1fms double %.1fms\n", lf, sdf, ld, sdd, deviation(md, mp), tf * 1000, td * 1000);
+
+    return testResult();
+}
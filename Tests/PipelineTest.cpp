@@ -0,0 +1,148 @@
+//
+//  PipelineTest.cpp
+//  Solyaris
+//
+//  Created by CNPP on 19.10.2026.
+//  Copyright 2026 Beat Raess. All rights reserved.
+//
+//  This file is part of Solyaris.
+//
+//  Solyaris is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  Solyaris is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with Solyaris.  If not, see www.gnu.org/licenses/.
+
+#include "Test.h"
+#include "Server.h"
+#include "Pipeline.h"
+
+
+// server
+static Server *server;
+static FetchRequest request(const string &type, int id) {
+    FetchRequest r;
+    char path[64];
+    if (id >= 900) {
+        snprintf(path, sizeof(path), "/bad/%d", id);
+    }
+    else {
+        snprintf(path, sizeof(path), "/credits/%s_%d", type.c_str(), id);
+    }
+    r.url = server->url(path);
+    r.endpoint = "credits";
+    r.timeout = 5;
+    return r;
+}
+
+// outcomes
+static boost::mutex omutex;
+static boost::condition_variable osignal;
+static vector<string> mutated;
+static map<string,PipelineStatus> outcomes;
+static void mutate(MutationBatch &b) {
+    boost::mutex::scoped_lock lock(omutex);
+    mutated.push_back(b.nid);
+}
+static void done(const string &nid, PipelineStatus status) {
+    boost::mutex::scoped_lock lock(omutex);
+    outcomes[nid] = status;
+    osignal.notify_all();
+}
+static void await(size_t n) {
+    boost::mutex::scoped_lock lock(omutex);
+    while (outcomes.size() < n) {
+        osignal.wait(lock);
+    }
+}
+static bool outcome(const string &nid, PipelineStatus status) {
+    boost::mutex::scoped_lock lock(omutex);
+    return outcomes.count(nid) && outcomes[nid] == status;
+}
+
+
+/**
+ * Load pipeline against the stand-in server with 100ms latency: taps
+ * first, promotion, failures, cancel with its fetch, backpressure over
+ * fetching loads and a pipeline gone before its fetches.
+ */
+int main() {
+    Server s(0.1);
+    server = &s;
+    CHECK(s.start());
+    FetchHTTP http;
+    Fetch f(&http);
+    f.rate(20, 6);
+    f.start(1);
+
+    // history, a tap, a promoted one, a bad one and a cancelled one
+    {
+        Pipeline p(&f, request, mutate);
+        p.done(done);
+        p.start(2);
+        for (int i = 1; i <= 5; i++) {
+            p.load("movie", i, pipelineHistory);
+        }
+        p.load("movie", 100, pipelineTap);
+        p.load("movie", 3, pipelineTap);
+        p.load("movie", 901, pipelineTap);
+        p.cancel("movie_5");
+        await(7);
+        CHECK(outcome("movie_1", pipelineDone) && outcome("movie_100", pipelineDone));
+        CHECK(outcome("movie_901", pipelineFailed));
+        CHECK(outcome("movie_5", pipelineCancelled));
+        CHECK(mutated.size() == 5);
+        CHECK(mutated[0] == "movie_100" || mutated[0] == "movie_3");
+        CHECK(s.hits("/credits/movie_5") == 0);
+        PipelineStats st = p.stats();
+        CHECK(st.promoted == 1 && st.done == 5 && st.failed == 1 && st.cancelled == 1);
+    }
+
+    // history parked behind the fetch reserve makes room for a tap
+    {
+        Pipeline p(&f, request, mutate);
+        p.done(done);
+        p.start(2);
+        for (int i = 200; i < 200 + (int)pipelineCapacity; i++) {
+            p.load("movie", i, pipelineHistory);
+        }
+        boost::this_thread::sleep(boost::posix_time::milliseconds(100));
+        p.load("movie", 500, pipelineHistory);
+        p.load("movie", 501, pipelineTap);
+        CHECK(outcome("movie_500", pipelineRejected));
+        CHECK(! outcome("movie_501", pipelineRejected));
+        PipelineStats st = p.stats();
+        CHECK(st.rejected == 2);
+        CHECK(p.pending() == pipelineCapacity);
+        double t = testNow();
+        while (! outcome("movie_501", pipelineDone) && testNow() - t < 5) {
+            boost::this_thread::sleep(boost::posix_time::milliseconds(10));
+        }
+        CHECK(outcome("movie_501", pipelineDone));
+        CHECK(outcome("movie_231", pipelineRejected) && s.hits("/credits/movie_231") == 0);
+        printf("backpressure: rejected %d, tap done in %.2fs\n", (int)p.stats().rejected, testNow() - t);
+    }
+
+    // gone before its fetch came back
+    {
+        Pipeline *p = new Pipeline(&f, request, mutate);
+        p->start(1);
+        p->load("movie", 700, pipelineTap);
+        boost::this_thread::sleep(boost::posix_time::milliseconds(20));
+        delete p;
+        boost::this_thread::sleep(boost::posix_time::milliseconds(300));
+        CHECK(find(mutated.begin(), mutated.end(), "movie_700") == mutated.end());
+    }
+
+    // done
+    f.stop();
+    s.stop();
+    return testResult();
+}
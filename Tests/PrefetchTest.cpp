@@ -0,0 +1,128 @@
+//
+//  PrefetchTest.cpp
+//  Solyaris
+//
+//  Created by CNPP on 19.10.2026.
+//  Copyright 2026 Beat Raess. All rights reserved.
+//
+//  This file is part of Solyaris.
+//
+//  Solyaris is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  Solyaris is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with Solyaris.  If not, see www.gnu.org/licenses/.
+
+#include "Test.h"
+#include "Server.h"
+#include "Prefetch.h"
+
+
+// server
+static Server *server;
+static FetchRequest request(const string &nid) {
+    FetchRequest r;
+    r.url = server->url("/credits/" + nid);
+    r.endpoint = "credits";
+    r.timeout = 5;
+    return r;
+}
+
+// candidates
+static vector<PrefetchCandidate> candidates(int from, int n) {
+    vector<PrefetchCandidate> cs;
+    for (int i = from; i < from + n; i++) {
+        PrefetchCandidate c;
+        char nid[32];
+        snprintf(nid, sizeof(nid), "person_%d", i);
+        c.nid = nid;
+        c.type = (i == from + 2) ? creditDirector : creditActor;
+        c.order = i - from;
+        c.distance = (i == from + 6) ? 10 : 500;
+        c.score = 0;
+        cs.push_back(c);
+    }
+    return cs;
+}
+
+// wait
+static void settle(Prefetch &p, size_t completed) {
+    double t = testNow();
+    while (p.stats().completed < completed && testNow() - t < 5) {
+        boost::this_thread::sleep(boost::posix_time::milliseconds(10));
+    }
+}
+
+
+/**
+ * Prefetcher against the stand-in server with 100ms latency: ranking, the
+ * limit, hits and misses, eviction and cancel.
+ */
+int main() {
+    Server s(0.1);
+    server = &s;
+    CHECK(s.start());
+    Cache cache(testScratch("prefetch"));
+    CHECK(cache.open());
+    FetchHTTP http;
+    Fetch f(&http);
+    f.rate(50, 8);
+    f.cache(&cache);
+    f.start(4);
+    Prefetch p(&f, request);
+
+    // director, then the top billed and the one next to the touch
+    vector<PrefetchCandidate> ranked = candidates(0, 8);
+    Prefetch::rank(ranked);
+    CHECK(ranked[0].nid == "person_2");
+    CHECK(ranked[1].nid == "person_6");
+    CHECK(ranked[2].nid == "person_0");
+
+    // limited, fetched into the cache
+    p.prefetch(candidates(0, 8), 4);
+    settle(p, 4);
+    PrefetchStats st = p.stats();
+    CHECK(st.issued == 4 && st.completed == 4);
+    CHECK(s.hits("/credits/person_2") == 1 && s.hits("/credits/person_7") == 0);
+    string body;
+    CHECK(cache.get(request("person_2").url, body) == cacheFresh);
+
+    // the next ones, each prefetched once
+    p.prefetch(candidates(0, 8), 4);
+    settle(p, 8);
+    CHECK(p.stats().issued == 8);
+    CHECK(s.hits("/credits/person_2") == 1 && s.hits("/credits/person_7") == 1);
+
+    // hit and miss
+    p.expanded("person_2");
+    p.expanded("person_9");
+    st = p.stats();
+    CHECK(st.hits == 1 && st.misses == 1);
+    CHECK(p.size() == 7);
+
+    // fetched entries leave with the candidates
+    p.prefetch(candidates(100, 4), 2);
+    CHECK(p.size() == 2);
+    settle(p, 10);
+
+    // cancel drops what is in flight
+    p.prefetch(candidates(200, 8), 6);
+    p.cancel();
+    st = p.stats();
+    CHECK(st.cancelled > 0);
+    CHECK(p.size() == 0);
+    printf("prefetch: issued %d completed %d cancelled %d hits %d misses %d hitrate %.2f\n", (int)st.issued, (int)st.completed, (int)st.cancelled, (int)st.hits, (int)st.misses, st.hitrate);
+
+    // done
+    f.stop();
+    cache.close();
+    s.stop();
+    return testResult();
+}
@@ -0,0 +1,235 @@
+//
+//  Server.cpp
+//  Solyaris
+//
+//  Created by CNPP on 19.10.2026.
+//  Copyright 2026 Beat Raess. All rights reserved.
+//
+//  This file is part of Solyaris.
+//
+//  Solyaris is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  Solyaris is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with Solyaris.  If not, see www.gnu.org/licenses/.
+
+#include "Server.h"
+#include "Test.h"
+#include <boost/bind.hpp>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+#include <cstring>
+#include <cstdio>
+
+
+#pragma mark -
+#pragma mark Object
+
+/**
+ * Creates a server, not yet listening.
+ */
+Server::Server(double l) : sfd(-1), port(0), latency(l), total(0), active(0) {
+}
+
+/**
+ * Stops the server.
+ */
+Server::~Server() {
+    this->stop();
+}
+
+
+#pragma mark -
+#pragma mark Business
+
+/**
+ * Listens on an ephemeral port of the loopback interface.
+ */
+bool Server::start() {
+    sfd = socket(AF_INET, SOCK_STREAM, 0);
+    if (sfd < 0) {
+        return false;
+    }
+    int on = 1;
+    setsockopt(sfd, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+    struct sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = 0;
+    socklen_t length = sizeof(addr);
+    if (bind(sfd, (struct sockaddr*)&addr, sizeof(addr)) != 0 || listen(sfd, 128) != 0 || getsockname(sfd, (struct sockaddr*)&addr, &length) != 0) {
+        ::close(sfd);
+        sfd = -1;
+        return false;
+    }
+    port = ntohs(addr.sin_port);
+    thread = boost::thread(boost::bind(&Server::accept, this));
+    return true;
+}
+
+/**
+ * Stops accepting and waits for the open connections.
+ */
+void Server::stop() {
+    if (sfd < 0) {
+        return;
+    }
+    shutdown(sfd, SHUT_RDWR);
+    ::close(sfd);
+    sfd = -1;
+    thread.join();
+    boost::mutex::scoped_lock lock(mutex);
+    while (active > 0) {
+        idle.wait(lock);
+    }
+}
+
+
+#pragma mark -
+#pragma mark Accessors
+
+/**
+ * Url of a path on the server.
+ */
+string Server::url(const string &path) const {
+    char base[64];
+    snprintf(base, sizeof(base), "http://127.0.0.1:%d", port);
+    return base + path;
+}
+
+/**
+ * Requests seen for a path.
+ */
+int Server::hits(const string &path) {
+    boost::mutex::scoped_lock lock(mutex);
+    map<string,int>::const_iterator c = counts.find(path);
+    return (c != counts.end()) ? c->second : 0;
+}
+
+/**
+ * Requests seen in total.
+ */
+int Server::requests() {
+    boost::mutex::scoped_lock lock(mutex);
+    return total;
+}
+
+
+#pragma mark -
+#pragma mark Helpers
+
+/**
+ * Accepts connections, each is served on its own thread.
+ */
+void Server::accept() {
+    while (true) {
+        int fd = ::accept(sfd, NULL, NULL);
+        if (fd < 0) {
+            return;
+        }
+        boost::mutex::scoped_lock lock(mutex);
+        active++;
+        boost::thread(boost::bind(&Server::serve, this, fd)).detach();
+    }
+}
+
+/**
+ * Reads a request and answers it after the latency.
+ */
+void Server::serve(int fd) {
+
+    // request
+    string raw;
+    char buffer[4096];
+    ssize_t n;
+    while (raw.find("\r\n\r\n") == string::npos && (n = recv(fd, buffer, sizeof(buffer), 0)) > 0) {
+        raw.append(buffer, n);
+    }
+    char target[1024] = "";
+    sscanf(raw.c_str(), "GET %1023s", target);
+    string path = target;
+
+    // count
+    int count;
+    {
+        boost::mutex::scoped_lock lock(mutex);
+        count = ++counts[path];
+        total++;
+    }
+
+    // respond
+    boost::this_thread::sleep(boost::posix_time::microseconds((long)(latency * 1000000)));
+    string response = this->respond(path, count);
+    size_t sent = 0;
+    while (sent < response.size() && (n = send(fd, response.data() + sent, response.size() - sent, MSG_NOSIGNAL)) > 0) {
+        sent += n;
+    }
+    ::close(fd);
+
+    // done
+    boost::mutex::scoped_lock lock(mutex);
+    active--;
+    idle.notify_all();
+}
+
+/**
+ * Response of a route.
+ */
+string Server::respond(const string &target, int n) {
+    string path = target.substr(0, target.find('?'));
+    string status = "200 OK";
+    string headers;
+    string body;
+
+    // errors
+    if (path.compare(0, 6, "/flaky") == 0 && n < 3) {
+        status = "429 Too Many Requests";
+        headers = "Retry-After: 0.3\r\n";
+    }
+    else if (path.compare(0, 8, "/missing") == 0) {
+        status = "404 Not Found";
+    }
+    else if (path.compare(0, 4, "/bad") == 0) {
+        body = "{\"cast\":[{\"id\":1,";
+    }
+    else {
+
+        // credits
+        char type[16] = "";
+        char b[512];
+        int id = 0;
+        if (sscanf(path.c_str(), "/credits/%15[a-z]_%d", type, &id) == 2 || sscanf(path.c_str(), "/%15[a-z]/%d", type, &id) == 2) {
+            snprintf(b, sizeof(b), "%s_%d.json", type, id);
+            body = testFixture(b);
+            if (body.empty() && strcmp(type, "person") == 0) {
+                snprintf(b, sizeof(b), "{\"id\":%d,\"cast\":[{\"id\":%d,\"title\":\"M%d\",\"release_date\":\"2001-01-01\",\"character\":\"X\"},{\"id\":%d,\"title\":\"M%d\",\"release_date\":\"1999-01-01\",\"character\":\"Y\"}],\"crew\":[]}", id, id + 1, id + 1, id + 2, id + 2);
+                body = b;
+            }
+            else if (body.empty()) {
+                snprintf(b, sizeof(b), "{\"id\":%d,\"cast\":[{\"id\":%d,\"name\":\"P%d\",\"character\":\"X\",\"order\":0},{\"id\":%d,\"name\":\"P%d\",\"character\":\"Y\",\"order\":1}],\"crew\":[{\"id\":%d,\"name\":\"D%d\",\"department\":\"Directing\",\"job\":\"Director\"}]}", id, id + 1, id + 1, id + 2, id + 2, id + 3, id + 3);
+                body = b;
+            }
+        }
+
+        // echo
+        else {
+            snprintf(b, sizeof(b), "{\"path\":\"%.480s\",\"n\":%d}", path.c_str(), n);
+            body = b;
+        }
+    }
+
+    // response
+    char length[64];
+    snprintf(length, sizeof(length), "Content-Length: %d\r\n", (int)body.size());
+    return "HTTP/1.0 " + status + "\r\n" + headers + length + "Connection: close\r\n\r\n" + body;
+}
@@ -0,0 +1,84 @@
+//
+//  Server.h
+//  Solyaris
+//
+//  Created by CNPP on 19.10.2026.
+//  Copyright 2026 Beat Raess. All rights reserved.
+//
+//  This file is part of Solyaris.
+//
+//  Solyaris is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  Solyaris is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with Solyaris.  If not, see www.gnu.org/licenses/.
+
+#pragma once
+#include <boost/thread.hpp>
+#include <string>
+#include <map>
+
+
+// namespace
+using namespace std;
+
+
+/**
+ * Stand-in Server.
+ * Local HTTP/1.0 server in place of the API, every response is delayed by
+ * the latency. Routes:
+ * /movie/<id>, /person/<id>, /credits/<type>_<id>: the recorded response
+ * in the fixtures if there is one, generated credits otherwise;
+ * /flaky...: 429 with Retry-After twice, then 200;
+ * /missing...: 404;
+ * /bad...: a truncated document;
+ * anything else: the path and how often it was requested.
+ */
+class Server {
+
+    // public
+    public:
+
+    // Server
+    Server(double latency = 0.2);
+    ~Server();
+
+    // Business
+    bool start();
+    void stop();
+
+    // Accessors
+    string url(const string &path) const;
+    int hits(const string &path);
+    int requests();
+
+
+    // private
+    private:
+
+    // Helpers
+    void accept();
+    void serve(int fd);
+    string respond(const string &path, int n);
+
+    // Socket
+    int sfd;
+    int port;
+    double latency;
+
+    // State
+    boost::mutex mutex;
+    boost::thread thread;
+    map<string,int> counts;
+    int total;
+    int active;
+    boost::condition_variable idle;
+
+};
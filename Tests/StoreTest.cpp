@@ -0,0 +1,138 @@
+//
+//  StoreTest.cpp
+//  Solyaris
+//
+//  Created by CNPP on 19.10.2026.
+//  Copyright 2026 Beat Raess. All rights reserved.
+//
+//  This file is part of Solyaris.
+//
+//  Solyaris is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  Solyaris is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with Solyaris.  If not, see www.gnu.org/licenses/.
+
+#include "Test.h"
+#include "Store.h"
+
+
+/**
+ * Person record.
+ */
+static PersonRecord person(int pid) {
+    PersonRecord p = PersonRecord();
+    p.pid = pid;
+    p.name = "Person";
+    p.type = creditActor;
+    p.loaded = true;
+    return p;
+}
+
+
+/**
+ * SQLite store: records, credits from a recorded response, nested
+ * transactions and favorites, with write and lookup timings.
+ */
+int main() {
+    string dir = testScratch("store");
+    Store s;
+    CHECK(s.open(dir + "/solyaris.db"));
+
+    // movie
+    MovieRecord m = MovieRecord();
+    m.mid = 550;
+    m.title = "Fight Club";
+    m.released = "1999-10-15";
+    m.runtime = 139;
+    m.loaded = true;
+    CHECK(s.putMovie(m));
+    MovieRecord r;
+    CHECK(s.movie(550, r) && r.title == "Fight Club" && r.runtime == 139 && r.loaded);
+    CHECK(! s.movie(551, r));
+
+    // credits of the recorded movie, persons are stubbed
+    string movie = testFixture("movie_550.json");
+    CreditsIngest in(creditMovie);
+    CHECK(in.feed(movie.data(), movie.size()) && in.finish());
+    CHECK(s.putCredits(550, creditMovie, in.credits()));
+    vector<CreditRecord> cs;
+    CHECK(s.creditsByMovie(550, cs) == (int)in.credits().size());
+    CHECK(s.creditsByPerson(287, cs) == 1 && cs[0].mid == 550 && cs[0].character == "Tyler Durden");
+    PersonRecord p;
+    CHECK(s.person(287, p) && p.name == "Brad Pitt" && ! p.loaded);
+
+    // nested, a failed inner level rolls the batch back
+    CHECK(s.begin());
+    CHECK(s.putPerson(person(1)));
+    CHECK(s.begin());
+    CHECK(s.putPerson(person(2)));
+    s.rollback();
+    CHECK(! s.commit());
+    CHECK(! s.person(1, p) && ! s.person(2, p));
+    CHECK(s.begin() && s.putPerson(person(3)) && s.commit());
+    CHECK(s.person(3, p));
+
+    // favorites
+    FavoriteRecord f = FavoriteRecord();
+    f.dbid = 550;
+    f.type = creditMovie;
+    f.title = "Fight Club";
+    CHECK(s.putFavorite(f));
+    vector<FavoriteRecord> fs;
+    CHECK(s.favorites(creditMovie, fs) == 1 && fs[0].title == "Fight Club");
+    CHECK(s.removeFavorite(creditMovie, 550) && s.favorites(creditMovie, fs) == 0);
+
+    // bench, one commit per row against one batch
+    double t = testNow();
+    for (int i = 0; i < 500; i++) {
+        s.putPerson(person(10000 + i));
+    }
+    double single = (testNow() - t) / 500;
+    t = testNow();
+    CHECK(s.begin());
+    for (int i = 0; i < 500; i++) {
+        s.putPerson(person(20000 + i));
+    }
+    CHECK(s.commit());
+    double batched = (testNow() - t) / 500;
+    printf("put person: %.1f us autocommit, %.1f us batched\n", single * 1e6, batched * 1e6);
+
+    // bench, a 2000 credit list in one transaction
+    vector<Credit> credits;
+    for (int i = 0; i < 2000; i++) {
+        Credit c = Credit();
+        c.id = 100000 + i;
+        c.name = "Credit";
+        c.type = creditActor;
+        c.character = "Role";
+        c.order = i;
+        credits.push_back(c);
+    }
+    t = testNow();
+    CHECK(s.putCredits(551, creditMovie, credits));
+    printf("put credits: 2000 in %.1f ms\n", (testNow() - t) * 1e3);
+    t = testNow();
+    int n = 0;
+    for (int i = 0; i < 200; i++) {
+        n += s.creditsByMovie(551, cs);
+    }
+    CHECK(n == 200 * 2000);
+    printf("credits by movie: %.2f ms for 2000 rows\n", (testNow() - t) / 200 * 1e3);
+    t = testNow();
+    for (int i = 0; i < 10000; i++) {
+        s.person(20000 + i % 500, p);
+    }
+    printf("person by id: %.2f us\n", (testNow() - t) / 10000 * 1e6);
+
+    // done
+    s.close();
+    return testResult();
+}
@@ -0,0 +1,87 @@
+//
+//  Test.h
+//  Solyaris
+//
+//  Created by CNPP on 19.10.2026.
+//  Copyright 2026 Beat Raess. All rights reserved.
+//
+//  This file is part of Solyaris.
+//
+//  Solyaris is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  Solyaris is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with Solyaris.  If not, see www.gnu.org/licenses/.
+
+#pragma once
+#include <sys/time.h>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <fstream>
+#include <sstream>
+
+
+// namespace
+using namespace std;
+
+
+/**
+ * Checks.
+ * A failed check reports its location and fails the test at exit, the
+ * test carries on so one run shows every failure.
+ */
+static int testFailures = 0;
+#define CHECK(c) \
+    do { \
+        if (! (c)) { \
+            fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #c); \
+            testFailures++; \
+        } \
+    } while (0)
+
+/**
+ * Test result, the exit code of main.
+ */
+inline int testResult() {
+    printf("%s\n", testFailures ? "FAILED" : "OK");
+    return testFailures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+/**
+ * Wall clock in seconds.
+ */
+inline double testNow() {
+    struct timeval t;
+    gettimeofday(&t, NULL);
+    return t.tv_sec + t.tv_usec / 1000000.0;
+}
+
+/**
+ * Reads a recorded response from the fixtures.
+ */
+inline string testFixture(const string &name) {
+    ifstream in((string(TEST_FIXTURES) + "/" + name).c_str(), ios::in | ios::binary);
+    stringstream s;
+    s << in.rdbuf();
+    return s.str();
+}
+
+/**
+ * Scratch directory for a test, emptied.
+ */
+inline string testScratch(const string &name) {
+    string dir = string(TEST_SCRATCH) + "/" + name;
+    string cmd = "rm -rf '" + dir + "' && mkdir -p '" + dir + "'";
+    if (system(cmd.c_str()) != 0) {
+        fprintf(stderr, "scratch %s failed\n", dir.c_str());
+    }
+    return dir;
+}
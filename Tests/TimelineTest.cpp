@@ -0,0 +1,79 @@
+//
+//  TimelineTest.cpp
+//  Solyaris
+//
+//  Created by CNPP on 19.10.2026.
+//  Copyright 2026 Beat Raess. All rights reserved.
+//
+//  This file is part of Solyaris.
+//
+//  Solyaris is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  Solyaris is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with Solyaris.  If not, see www.gnu.org/licenses/.
+
+#include "Test.h"
+#include "Timeline.h"
+#include <vector>
+
+
+// callbacks
+static int calls = 0;
+static TimelineHandle *victim = NULL;
+static void called() {
+    calls++;
+}
+static void cancel() {
+    calls++;
+    victim->cancel();
+}
+
+
+/**
+ * Timeline: callbacks cancelled within their frame, handles dropped in bulk.
+ */
+int main() {
+    
+    // a callback cancels a tween that finished in the same frame
+    TimelineHandle first;
+    TimelineHandle second;
+    victim = &second;
+    first = Timeline::delay(0.5, cancel);
+    second = Timeline::delay(0.5, called);
+    Timeline::update(1);
+    CHECK(calls == 1);
+    
+    // the other way round
+    calls = 0;
+    victim = &first;
+    second = Timeline::delay(0.5, cancel);
+    first = Timeline::delay(0.5, called);
+    Timeline::update(1);
+    CHECK(calls == 1 && Timeline::size() == 0);
+    
+    // handles of a large graph go in linear time
+    const int n = 100000;
+    float values[8] = {0};
+    double t = testNow();
+    {
+        vector<TimelineHandle> handles(n);
+        for (int i = 0; i < n; i++) {
+            handles[i] = Timeline::tween(&values[i % 8], 1, 10, easeLinear, TimelineCallback());
+        }
+        CHECK(Timeline::size() == n);
+    }
+    double dt = testNow() - t;
+    CHECK(Timeline::size() == 0);
+    CHECK(dt < 1);
+    printf("%d tweens tweened and cancelled in %.1fms\n", n, dt * 1000);
+    
+    return testResult();
+}